@@ -23,13 +23,18 @@
 
 
 /// STL
-#include <cstdlib>   // basicMove()
-#include <vector>    // generatePossibleMoves()
+#include <array>     // generateSafeMoves()
+#include <vector>    // generatePossibleMoves() and m_moves
 
 
 /// Personal
 #include <controllers/controller.hpp>     // Parent
+#include <food/distancefield.hpp>         // m_pFoodField and m_pFatFoodField
+#include <misc/occupancygrid.hpp>         // m_pGrid
+#include <misc/random.hpp>                // m_pRandom
+#include <misc/searchbuffers.hpp>         // m_pSearch
 #include <misc/snakeutilities.hpp>        // moveForward()
+#include <snakes/dangermap.hpp>           // m_pDangerMap
 
 
 /// Forward declarations
@@ -58,6 +63,18 @@ class AIController : public Controller
       void setSnakeManager (const std::shared_ptr<SnakeManager>& snakeManager);
       void setFoodManager (const std::shared_ptr<FoodManager>& FoodManager);
       void setObstacleManager (const std::shared_ptr<ObstacleManager>& obstacleManager);
+      void setRandom (const std::shared_ptr<Random>& random);
+
+      /// Without both generateSafeMoves() can't tell whether a move leads into a dead end
+      void setGrid (const std::shared_ptr<const OccupancyGrid>& grid);
+      void setSearchBuffers (const std::shared_ptr<SearchBuffers>& search);
+
+      /// The fields shared by every AIController of the World, one leads to any food and the other only to FatFood
+      void setDistanceFields (const std::shared_ptr<DistanceField>& foodField,
+                              const std::shared_ptr<DistanceField>& fatFoodField);
+
+      /// Shared by every AIController of the World, lets a search cross Snakes which will have moved out of the way
+      void setDangerMap (const std::shared_ptr<DangerMap>& dangerMap);
 
 
       /// Getters
@@ -65,22 +82,41 @@ class AIController : public Controller
       virtual Movement getMove() override;
 
    protected:
+      /// Regions larger than this are treated as open, a Snake frees a cell at its tail for every cell it fills
+      static const unsigned int kRoomyRegion = 256;
+
+
       /// Testing functions
       bool exists (const Movement test, const std::vector<Movement>& moves) const;
 
+      /// Whether every move leads into the same region, which it does if the cells they lead to are linked by free
+      /// cells around the head
+      bool isOneRegion (const Cell& head, const std::vector<Movement>& moves) const;
+
 
       /// Functionality
       /// Randomly generates a movement
       Movement basicMove() const;
       Movement safeMove();
 
-      /// Moves a Rectangle one cell forward, taking into account the ability to spawn at the other side
-      void moveForward (Rectangle& modify, const Movement move);
+      /// Moves a Cell one cell forward, taking into account the ability to spawn at the other side
+      void moveForward (Cell& modify, const Movement move);
 
-      /// Fills modify with possible moves based on m_lastMove
+      /// Fills modify with possible moves based on m_lastMove, anything already in modify is replaced
       void generatePossibleMoves (std::vector<Movement>& modify);
+
+      /// As above but without moves into collidable objects or into regions too small for the Snake to survive in
       void generateSafeMoves (std::vector<Movement>& modify);
 
+      /// Counts the free cells reachable from start, stopping once more than limit have been found. Returns limit + 1
+      /// if the region joins one already filled by another move this search, or limit if a Snake part bordering it will
+      /// have moved away before the region could be filled
+      unsigned int fillRegion (const Cell& start, const Movement move, const unsigned int limit);
+
+      /// Picks the safe move which the field says is closest to food, Movement::Null if the field knows none of them.
+      /// Ties go to the first move unless randomTies, then one is picked at random
+      Movement descendField (DistanceField& field, const bool randomTies);
+
 
       /// Members
       const InGameSetup m_kSetup;                        /// Used to test whether adjacent cells are available
@@ -88,6 +124,13 @@ class AIController : public Controller
       std::weak_ptr<const SnakeManager> m_pkSnakeManager;       /// Allows the ability to avoid Snake objects
       std::weak_ptr<const FoodManager> m_pkFoodManager;         /// Allows the ability to find the closest food
       std::weak_ptr<const ObstacleManager> m_pkObstacleManager; /// Allows the ability to avoid Obstacle objects
+      std::shared_ptr<Random> m_pRandom;                        /// The random engine of the game
+      std::vector<Movement> m_moves;                            /// Reused by every decision so none allocate
+      std::shared_ptr<const OccupancyGrid> m_pGrid;             /// Says what is in every cell
+      std::shared_ptr<SearchBuffers> m_pSearch;                 /// The memory every search runs in
+      std::shared_ptr<DistanceField> m_pFoodField;              /// Leads to the nearest food
+      std::shared_ptr<DistanceField> m_pFatFoodField;           /// Leads to the nearest FatFood
+      std::shared_ptr<DangerMap> m_pDangerMap;                  /// Says when Snake parts will have moved away
 
    private:
 };
@@ -50,7 +50,7 @@ class DumbAIController final : public AIController
 
    private:
       /// Functionality
-      Movement chaseFood (const Rectangle& head, const Rectangle& food);
+      Movement chaseFood (const Cell& head, const Cell& food);
 };
 
 #endif // DUMBAICONTROLLER_H
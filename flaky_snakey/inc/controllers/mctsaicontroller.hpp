@@ -0,0 +1,129 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MCTSAICONTROLLER_H
+#define MCTSAICONTROLLER_H
+
+
+/// STL
+#include <memory>    // m_pRollouts
+#include <mutex>     // m_mutex
+#include <vector>    // m_nodes and m_workers
+
+
+/// Personal
+#include <controllers/aicontroller.hpp>   // Parent
+#include <misc/random.hpp>                // Worker
+#include <snakes/snake.hpp>               // getMove()
+
+
+/// Forward declarations
+class RolloutPool;
+class World;
+
+
+/// MCTSAIController is a derivative of AIController which decides by playing the game ahead. Every thread of the
+/// RolloutPool repeatedly restores the game as the tick began and plays it out for a while: the Snake follows a path of
+/// moves picked from a search tree by UCT, the other Snakes and the rest of the path follow a cheap version of the
+/// heuristics of DumbAIController. How long the Snake survived and how much it grew are added to every move of the path
+/// and the move tried most often is made. Threads share the tree under a lock, a path counts as a loss until its
+/// result is in so other threads spread out. Only the Snake's own moves are in the tree, whatever the others did is
+/// averaged over, so the subtree of the move made is still valid next tick and is kept. The more threads the more the
+/// game is played ahead, so the AI gets stronger with every core.
+/// MCTSAIController is a leaf class.
+class MCTSAIController final : public AIController
+{
+   public:
+      /// Constructors and destructor
+      /// Throws if there is no RolloutPool to play ahead with
+      MCTSAIController (const InGameSetup& setup, const std::shared_ptr<RolloutPool>& rollouts);
+
+      ~MCTSAIController() override = default;
+
+      /// Explicitly disallow (Effective C++: Item 6)
+      MCTSAIController (const MCTSAIController& copy) = delete;
+      MCTSAIController& operator= (const MCTSAIController& copy) = delete;
+
+
+      /// Getters
+      Movement getMove() override;
+
+   protected:
+
+   private:
+      /// How many ticks each rollout plays ahead
+      static const unsigned int kHorizon = 40;
+
+      /// The tree stops growing at this many nodes, selection then only follows the nodes it has
+      static const unsigned int kMaxNodes = 1 << 15;
+
+      /// How many cells of growth earn the whole growth part of the result
+      static const unsigned int kFullGrowth = 8;
+
+
+      /// A sequence of the Snake's own moves, children are indexed by Movement - 1 and 0 means there is none
+      struct Node final
+      {
+         unsigned int children[4];  /// The node of each move which follows this one
+         Movement move;             /// The move which leads to this node
+         unsigned int visits;       /// How many rollouts have passed through, including those still running
+         float reward;              /// The total result of the finished rollouts
+      };
+
+      /// Everything a thread of the RolloutPool needs for its rollouts, reused so a rollout never allocates
+      struct Worker final
+      {
+         Random random;                  /// Decides for the other Snakes and the rest of the path
+         std::vector<unsigned int> path; /// The nodes selected from the root
+         std::vector<Movement> plan;     /// The Snake's move at each node of the path
+         std::vector<Movement> moves;    /// The move of every Snake on the current tick
+      };
+
+
+      /// Functionality
+      /// Keeps the subtree of the last move made if the game continued from it, otherwise starts a new tree
+      void prepareTree (const Snake& snake);
+
+      /// Selects a path from the root and counts it as a loss until backPropagate() is given its result
+      void select (Worker& worker);
+      void backPropagate (const Worker& worker, const float reward);
+
+      /// Plays one rollout from the root in the World of the worker
+      void rollout (World& world, const unsigned int worker);
+
+      /// The cheap heuristics of DumbAIController: head for the nearest food if a move towards it is safe, otherwise
+      /// any safe move, never reversing. Thread-safe as only the World and the Random are changed
+      Movement rolloutMove (World& world, const unsigned int index, Random& random);
+
+
+      /// Members
+      std::shared_ptr<RolloutPool> m_pRollouts;    /// Plays the game ahead
+      std::vector<Worker> m_workers;               /// One for every thread of m_pRollouts
+      std::vector<Movement> m_firstMoves;          /// The moves already made this tick, Movement::Null for the rest
+
+      std::mutex m_mutex;                          /// Guards the tree while the threads play
+      std::vector<Node> m_nodes;                   /// The tree, the root is always the first node
+      std::vector<Node> m_spare;                   /// The subtree is copied here to keep it, then swapped in
+
+      unsigned int m_index;                        /// The index of the Snake, set before every decision
+      unsigned int m_decisionTick;                 /// The tick the last move was made on
+      unsigned int m_avoidSize;                    /// Snakes smaller than this only chase FatFood
+};
+
+#endif // MCTSAICONTROLLER_H
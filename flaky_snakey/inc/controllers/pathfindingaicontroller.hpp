@@ -0,0 +1,82 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef PATHFINDINGAICONTROLLER_H
+#define PATHFINDINGAICONTROLLER_H
+
+
+/// Personal
+#include <controllers/aicontroller.hpp>   // Parent
+#include <snakes/snake.hpp>               // getMove()
+
+
+/// PathfindingAIController is a derivative of AIController which plans an actual path to food instead of heading
+/// straight for it. It follows the shared distance fields of the World when they're worth searching, otherwise each
+/// decision is an A* search around the wrapping level, guided towards the nearest food, which stops at the first food
+/// the Snake can safely eat. The search crosses any Snake part which will have moved away by the time the path reaches it, so a
+/// crowded level doesn't wall food off for good. Food it can't reach is never chased into a dead end and if no food
+/// can be reached it falls back to any safe move. Only moves generateSafeMoves() considers roomy enough start a path.
+/// PathfindingAIController is a leaf class.
+class PathfindingAIController final : public AIController
+{
+   public:
+      /// Constructors and destructor
+      PathfindingAIController (const InGameSetup& setup);
+
+      PathfindingAIController (PathfindingAIController&& move) = default;
+      PathfindingAIController (const PathfindingAIController& copy) = default;
+      PathfindingAIController& operator= (const PathfindingAIController& copy) = default;
+      ~PathfindingAIController() override = default;
+
+
+      /// Getters
+      Movement getMove() override;
+
+   protected:
+
+   private:
+      /// How many cells a search may expand, per step between the Snake and the food plus a minimum
+      static const unsigned int kBudgetPerStep = 16;
+      static const unsigned int kBudgetBase = 256;
+
+      /// How many moves after the DangerMap says a Snake part has gone that a path may cross its cell
+      static const unsigned int kClearanceSlack = 2;
+
+
+      /// Testing functions
+      /// ThinFood flakes the Snake and kills it if the Snake is no bigger than its effect
+      bool isEdible (const Cell& cell, const Snake& snake, const FoodManager& foodManager) const;
+
+
+      /// Functionality
+      /// Fills modify with the food findPath() heads for, false if there is no food
+      bool findGoal (const Snake& snake, const FoodManager& foodManager, Cell& modify) const;
+
+      /// The first move of the shortest path to edible food, towards goal if the budget runs out first.
+      /// Movement::Null if no food can be reached
+      Movement findPath (const Snake& snake, const FoodManager& foodManager, const Cell& goal);
+
+
+      /// Getters
+      /// How many cells findPath() may expand between head and goal
+      unsigned int getBudget (const Cell& head, const Cell& goal) const;
+};
+
+#endif // PATHFINDINGAICONTROLLER_H
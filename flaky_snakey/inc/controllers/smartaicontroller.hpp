@@ -50,7 +50,7 @@ class SmartAIController final : public AIController
 
    private:
       /// Functionality
-      Movement chaseFood (const Rectangle& head, const Rectangle& food);
+      Movement chaseFood (const Cell& head, const Cell& food);
 
 };
 
@@ -31,10 +31,12 @@
 
 
 /// Personal
+#include <misc/profiler.hpp>              // close()
 #include <states/mainmenustate.hpp>       // initialise()
 #include <states/configurationstate.hpp>  // initialise()
 #include <states/mainsnakestate.hpp>      // initialise()
 #include <states/demosnakestate.hpp>      // initialise()
+#include <states/replaystate.hpp>         // initialise()
 
 
 /// FlakySnakey is a simple encapsulation of the entire game initialisation, running and shutdown. It provides an easy
@@ -75,6 +77,7 @@ class FlakySnakey final
       std::unique_ptr<ConfigurationState> m_pConfig;  /// The configurations menu
       std::unique_ptr<MainSnakeState> m_pMainGame;    /// The main game state
       std::unique_ptr<DemoSnakeState> m_pPauseDemo;   /// The pause game state
+      std::unique_ptr<ReplayState> m_pReplay;         /// Plays back the last game
 };
 
 #endif // FLAKYSNAKEY_H
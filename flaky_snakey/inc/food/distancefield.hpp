@@ -0,0 +1,107 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef DISTANCEFIELD_H
+#define DISTANCEFIELD_H
+
+
+/// STL
+#include <cstdint>   // isWorthSearching()
+#include <limits>    // kUnknown
+#include <memory>    // m_pGrid and m_pFoodManager
+#include <vector>    // m_sources
+
+
+/// Personal
+#include <food/foodmanager.hpp>     // m_pFoodManager
+#include <misc/occupancygrid.hpp>   // m_pGrid
+#include <misc/searchbuffers.hpp>   // m_search
+
+
+/// DistanceField knows how many moves every cell is from the nearest food, or the nearest FatFood, around the wrapping
+/// level. It's a breadth first search outwards from all of the food at once so one search serves every AI Snake, each
+/// of which just moves to whichever neighbouring cell is closest. The World invalidates the field every tick and the
+/// first AI to need it refreshes it, so a tick in which nobody asks costs nothing. Paths only cross free cells, other
+/// food is avoided as a Snake hunting FatFood must not eat ThinFood on the way. A search fills every free cell of the
+/// level so it's only worth making when it's shared between enough AI Snakes, or when one of them would search about
+/// as far on its own; otherwise each AI finds its own way for less.
+/// DistanceField is a leaf class.
+class DistanceField final
+{
+   public:
+      /// The distance of a cell which the field couldn't reach
+      static const unsigned int kUnknown = std::numeric_limits<unsigned int>::max();
+
+      /// How many cells of a search each AI Snake is worth, about what a single decision costs it without the field
+      static const unsigned int kCellsPerAI = 32;
+
+
+      /// Constructors and destructor
+      DistanceField (const InGameSetup& setup, const std::shared_ptr<const OccupancyGrid>& grid,
+                     const std::shared_ptr<const FoodManager>& foodManager, const bool fatFoodOnly);
+
+      DistanceField (DistanceField&& move) = default;
+      ~DistanceField() = default;
+
+      /// Explicitly disallow (Effective C++: Item 6)
+      DistanceField (const DistanceField& copy) = delete;
+      DistanceField& operator= (const DistanceField& copy) = delete;
+
+
+      /// Testing functions
+      /// Whether following the field costs no more than finding food alone. It does if it has already been searched,
+      /// if the search shared between the AI Snakes expected to ask is within their worth, or if the asker would
+      /// otherwise search cost cells itself
+      bool isWorthSearching (const unsigned int cost = 0) const
+      {
+         return m_valid || (std::uint64_t) m_askers * kCellsPerAI + cost >= m_pGrid->getFreeCells();
+      }
+
+
+      /// Functionality
+      /// Searches the level again if the field has been invalidated since the last search
+      void refresh();
+
+
+      /// Assignment functions
+      /// Askers is how many AI Snakes may want the field before it's next invalidated
+      void invalidate (const unsigned int askers) { m_valid = false; m_askers = askers; }
+
+
+      /// Getters
+      /// Only meaningful after refresh(), kUnknown if the cell is occupied or no food can be reached from it
+      unsigned int getDistance (const Cell& cell) const;
+
+   protected:
+
+   private:
+      /// Members
+      const InGameSetup m_kSetup;                           /// Provides the dimensions of the level
+      std::shared_ptr<const OccupancyGrid> m_pGrid;         /// Says which cells can be crossed
+      std::shared_ptr<const FoodManager> m_pFoodManager;    /// Provides the food the field leads to
+      const bool m_kFatFoodOnly;                            /// Whether ThinFood is avoided rather than led to
+
+      SearchBuffers m_search;                               /// Holds the distance of every cell that was reached
+      std::vector<Cell> m_sources;                          /// The cell of every food the field leads to
+      unsigned int m_askers;                                /// How many AI Snakes may ask for the field
+      bool m_valid;                                         /// Whether the field is up to date
+};
+
+#endif // DISTANCEFIELD_H
@@ -23,7 +23,7 @@
 
 
 /// STL
-#include <cstdlib> // rand()
+#include <limits>  // setFoodEffect()
 
 
 /// Personal
@@ -37,10 +37,7 @@ class FatFood final : public Food
    public:
       /// Constructors and destructor
       // FatFood are orange
-      FatFood (const Rectangle& rectangle = {10, 10, 0, 0}, const prg::Colour& colour = {255, 165, 0});
-
-      FatFood (const unsigned short timerID, const unsigned int milliseconds,
-               const Rectangle& rectangle = {10, 10, 0, 0}, const prg::Colour& colour = {255, 165, 0});
+      FatFood (const Cell& cell = {}, const prg::Colour& colour = {255, 165, 0});
 
       FatFood (FatFood&& move) = default;
       FatFood (const FatFood& copy) = default;
@@ -49,7 +46,7 @@ class FatFood final : public Food
 
 
       /// Assignment functions
-      void setFoodEffect (unsigned int effectMin, unsigned int effectMax) override;
+      void setFoodEffect (unsigned int effectMin, unsigned int effectMax, Random& random) override;
 
    protected:
 
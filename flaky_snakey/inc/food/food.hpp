@@ -22,56 +22,39 @@
 #define FOOD_H
 
 
-/// Third party
-#include <prg/interactive/app_state.hpp>  // Parent
-#include <prg/interactive/timer.hpp>      // m_timer
-
-
 /// Personal
+#include <misc/random.hpp>        // setFoodEffect()
 #include <obstacles/obstacle.hpp> // Parent
 
 
-/// Gets eaten by snakes and depending on the derived type, makes them grow or flake.
+/// Gets eaten by snakes and depending on the derived type, makes them grow or flake. Rotting is kept track of by
+/// FoodManager, Food itself has no idea of time.
 /// Food is abstract but should not be used as an interface.
-class Food : public Obstacle, public prg::ITimerEvent
+class Food : public Obstacle
 {
    public:
       /// Constructors and destructor
       // Food are red
-      Food (const Rectangle& rectangle = {10, 10, 0, 0},
-            const prg::Colour& colour = {255, 0, 0});
-
-      Food (const unsigned short timerID, const unsigned int milliseconds,
-            const Rectangle& rectangle = {10, 10, 0, 0},
+      Food (const Cell& cell = {},
             const prg::Colour& colour = {255, 0, 0});
 
       virtual ~Food() = default;
 
 
-      /// Testing functions
-      bool isRotten() const { return m_rotten; }
-
-
       /// Functionality
-      void pause();
-      void resume();
-      void draw (prg::Canvas& canvas) override;
-      void onTimer (prg::Timer& timer) override;
+      void draw (prg::Canvas& canvas, const InGameSetup& projection) const override;
 
 
       /// Assignment functions
-      void setDeterioration (const unsigned short timer_id, const unsigned int milliseconds);
-      virtual void setFoodEffect (unsigned int effectMin, unsigned int effectMax) = 0;
+      /// The effect is picked by random from the range
+      virtual void setFoodEffect (unsigned int effectMin, unsigned int effectMax, Random& random) = 0;
 
 
       /// Getters
-      int getFoodEffect() const           { return m_foodEffect; }
-      unsigned short getTimerID() const   { return m_timer.getID(); }
+      int getFoodEffect() const { return m_foodEffect; }
 
    protected:
-      prg::Timer m_timer;  /// Controls when the food becomes rotten
-      bool m_rotten;       /// Used to determine if food is rotten
-      int m_foodEffect;    /// Stores the amount a snake should grow or flake
+      int m_foodEffect;          /// Stores the amount a snake should grow or flake
 
    private:
 };
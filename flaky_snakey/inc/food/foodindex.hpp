@@ -0,0 +1,100 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef FOODINDEX_H
+#define FOODINDEX_H
+
+
+/// STL
+#include <limits> // kNoFood
+#include <vector> // m_buckets
+
+
+/// Personal
+#include <misc/cell.hpp>         // Entry
+#include <setup/ingamesetup.hpp> // m_kSetup
+
+
+/// FoodIndex buckets food by position so the nearest food can be found by searching outwards from a cell rather than
+/// checking every item. Distances wrap around the level the same way Snake movement does. Each item is identified by a
+/// handle chosen by the owner, FoodIndex never interprets it.
+/// FoodIndex is a leaf class.
+class FoodIndex final
+{
+   public:
+      /// Returned by findNearest() when the index is empty
+      static const unsigned int kNoFood = std::numeric_limits<unsigned int>::max();
+
+
+      /// Constructors and destructor
+      /// expected is roughly how many items will be stored, the buckets are sized to hold about one each
+      FoodIndex (const InGameSetup& setup, const unsigned int expected);
+
+      FoodIndex (const FoodIndex& copy) = default;
+      FoodIndex (FoodIndex&& move) = default;
+      FoodIndex& operator= (const FoodIndex& copy) = default;
+      ~FoodIndex() = default;
+
+
+      /// Testing functions
+      bool isEmpty() const { return m_size == 0; }
+
+
+      /// Functionality
+      /// Returns the handle of the nearest item, ties are broken by the lowest handle. kNoFood if empty
+      unsigned int findNearest (const Cell& cell) const;
+
+
+      /// Assignment functions
+      void insert (const Cell& cell, const unsigned int handle);
+      void remove (const Cell& cell, const unsigned int handle);
+      void clear();
+
+
+      /// Getters
+      /// Returns kNoFood if nothing is stored in the cell
+      unsigned int getHandle (const Cell& cell) const;
+      unsigned int getSize() const { return m_size; }
+
+   protected:
+
+   private:
+      /// What is stored in each bucket
+      struct Entry final
+      {
+         Cell cell {};              /// Where the item is
+         unsigned int handle {0};   /// How the owner identifies the item
+      };
+
+
+      /// Getters
+      unsigned int getBucketIndex (const Cell& cell) const;
+
+
+      /// Members
+      const InGameSetup m_kSetup;                  /// Provides the dimensions of the grid
+      unsigned int m_bucketShift;                  /// Each bucket covers (1 << m_bucketShift) cells on each axis
+      unsigned int m_bucketsX;                     /// How many buckets span the width of the grid
+      unsigned int m_bucketsY;                     /// How many buckets span the height of the grid
+      std::vector<std::vector<Entry>> m_buckets;   /// Every stored item, row by row
+      unsigned int m_size;                         /// How many items are stored
+};
+
+#endif // FOODINDEX_H
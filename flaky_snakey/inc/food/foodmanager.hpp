@@ -23,28 +23,55 @@
 
 
 /// STL
-#include <memory>    // std::unique_ptr
+#include <memory>    // std::shared_ptr
+#include <stdexcept> // std::runtime_error
+#include <string>    // getFoodIndex()
 #include <vector>    // std::vector
 
 
 /// Personal
+#include <misc/occupancygrid.hpp> // m_pGrid
+#include <misc/poolallocator.hpp> // m_foodAllocator
+#include <misc/random.hpp>        // m_pRandom
+#include <misc/timingwheel.hpp>   // m_rotWheel
 #include <setup/ingamesetup.hpp> // InGameSetup
 #include <food/fatfood.hpp>      // FatFood
+#include <food/foodindex.hpp>    // m_allFood and m_fatFood
 #include <food/thinfood.hpp>     // ThinFood
 
 
 /// FoodManager is a designated management class, it deals with all interactions between other classes and the available
-/// food in the game, it manages FatFood and ThinFood objects.
+/// food in the game, it manages FatFood and ThinFood objects. Other classes refer to food by handle, a handle stays
+/// valid for as long as its food exists, FoodIndex::kNoFood never refers to food. ThinFood rots when its deadline in
+/// m_rotWheel comes round, food which can't rot costs nothing per tick. Food never changes once it has spawned so it
+/// is shared with every Snapshot rather than copied. Once warmed up, spawning and removing food never touches the heap.
 /// FoodManager is a leaf class.
 class FoodManager final
 {
    public:
+      /// Every Food and handle at the time of save(), the cells themselves are recorded by the OccupancyGrid's Snapshot
+      class Snapshot final
+      {
+         friend class FoodManager;
+         friend class SaveGame;
+
+         std::vector<std::shared_ptr<const Food>> m_foodP {};   /// Shares every Food object
+         std::vector<unsigned int> m_handles {};                /// A copy of m_handles
+         std::vector<unsigned int> m_slots {};                  /// A copy of m_slots
+         std::vector<unsigned int> m_freeHandles {};            /// A copy of m_freeHandles
+         TimingWheel m_rotWheel {};                             /// A copy of m_rotWheel
+         bool m_spawnRequired {false};                          /// A copy of m_spawnRequired
+      };
+
+
       /// Constructors and destructor
-      FoodManager (const InGameSetup& setup, const unsigned int rotInterval,
-                   const unsigned int foodMin, const unsigned int foodMax, const bool demoMode = false);
-      ~FoodManager();
+      /// ThinFood rots after rotTicks calls to update(), 0 means it never rots
+      FoodManager (const InGameSetup& setup, const std::shared_ptr<OccupancyGrid>& grid,
+                   const std::shared_ptr<Random>& random, const unsigned int rotTicks, const unsigned int foodMin,
+                   const unsigned int foodMax);
 
       FoodManager (FoodManager&& move) = default;
+      ~FoodManager() = default;
 
       /// Explicitly disallow (Effective C++: Item 6)
       FoodManager (const FoodManager& copy) = delete;
@@ -52,60 +79,84 @@ class FoodManager final
 
 
       /// Testing functions
-      bool isFoodHere (const Rectangle& rect) const;
+      bool isFoodHere (const Cell& cell) const;
 
       bool isSpawnRequired() const { return m_spawnRequired; }
 
 
       /// Functionality
       // Basic game facilities
-      void pause();
-      void resume();
-      void update();
+      void update(); /// Called once per tick
       void drawFood (prg::Canvas& canvas);
 
       // AI facilities
-      const Rectangle findNearestFood (const Rectangle& rect, const bool fatFoodOnly) const;
-      const Rectangle findNearestFatFood (const Rectangle& rect) const;
+      /// Returns the handle of the nearest food around the wrapping level, FoodIndex::kNoFood if none is suitable
+      unsigned int findNearestFood (const Cell& cell, const bool fatFoodOnly) const;
 
 
       /// Assignment functions
-      /// Relies on being passed a rectangle containing a valid spawn location
-      void addFood (const Rectangle& rect);
-      void removeFood (const unsigned int index);
+      /// Relies on being passed a cell containing a valid spawn location
+      void addFood (const Cell& cell);
+      void removeFood (const unsigned int handle);
+
+      /// Neither touches the grid, it must be restored alongside the FoodManager. Handles are restored too
+      void save (Snapshot& modify) const;
+      void restore (const Snapshot& snapshot);
 
 
       /// Getters
-      /// Returns maximum unsigned int if invalid
-      unsigned int getFoodIndex (const Rectangle& position) const;
-      int getFoodEffect (const unsigned int index) const;
-      const Rectangle& getFoodPosition (const unsigned int index) const;
+      /// Returns FoodIndex::kNoFood if there's no food in the cell
+      unsigned int getFoodHandle (const Cell& position) const;
+      int getFoodEffect (const unsigned int handle) const;
+      const Cell& getFoodPosition (const unsigned int handle) const;
 
       unsigned int getFoodAmount() const { return m_foodP.size(); }
+      unsigned int getFoodEffectMax() const { return m_foodEffectMax; }
+
+      /// Fills modify with the cell of every food, or only FatFood, anything already in modify is replaced
+      void getFoodCells (std::vector<Cell>& modify, const bool fatFoodOnly) const;
 
    protected:
 
    private:
+      /// Assignment functions
+      /// Removes the food stored at index of m_foodP, the last food takes its place
+      void eraseFood (const unsigned int index);
+
+
+      /// Getters
+      /// Converts a handle into an index of m_foodP, throws if the handle doesn't refer to food
+      unsigned int getFoodIndex (const unsigned int handle, const char* caller) const;
+
+
+      /// Members
       const InGameSetup m_kSetup;         /// Contains all game settings necessary for FoodManager
       const unsigned int m_kFoodMin;      /// The minimum amount of food that can exist at any point
       const unsigned int m_kFoodMax;      /// The maximum amount of food that can exist at any point
-      const unsigned int m_kRotInterval;  /// How quickly ThinFood rots
+      const unsigned int m_kRotTicks;     /// How many ticks ThinFood lasts before rotting
+
+      std::shared_ptr<OccupancyGrid> m_pGrid;   /// Every Food object is recorded in the grid for quick lookups
+      std::shared_ptr<Random> m_pRandom;        /// The random engine of the game, decides what and when to spawn
 
       /// Contains all FatFood and ThinFood objects that exist in the game
-      std::vector<std::unique_ptr<Food>> m_foodP;
+      std::vector<std::shared_ptr<const Food>> m_foodP;
+      std::vector<unsigned int> m_handles;      /// The handle of each Food in m_foodP
+      std::vector<unsigned int> m_slots;        /// Where each handle is in m_foodP, FoodIndex::kNoFood if unused
+      std::vector<unsigned int> m_freeHandles;  /// Handles which can be reused
 
-      /// Incremented each time a Timer is created to guarantee that a timer can be created, 0 and 1 are reserved for the
-      /// SnakeManager timer(s).
-      unsigned short m_timerID;
-      unsigned int m_timerCount;    /// Used to check that the 6 timer limit hasn't been exceeded
-      unsigned int m_foodEffectMax; /// The largest impact food can have on a Snake
+      FoodIndex m_allFood; /// Locates every Food for the AI
+      FoodIndex m_fatFood; /// Locates only food that makes a Snake grow
 
-      /// Indicates that the SnakeState needs to provide a spawn point so food can spawn
-      bool m_spawnRequired;
+      TimingWheel m_rotWheel;             /// Holds the rot deadline of each ThinFood by handle
+      std::vector<unsigned int> m_rotten; /// The handles which rot during the current update
+
+      /// Food is made in memory that is reused once the food and every Snapshot holding it are gone
+      PoolAllocator<Food> m_foodAllocator;
 
-      /// Avoid a bug with faulty timers due to conflicts with the demo mode by not allowing ThinFood to rot
-      bool m_demoMode;
+      unsigned int m_foodEffectMax; /// The largest impact food can have on a Snake
 
+      /// Indicates that the World needs to provide a spawn point so food can spawn
+      bool m_spawnRequired;
 };
 
 #endif // FOODMANAGER_H
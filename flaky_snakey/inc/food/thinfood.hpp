@@ -23,7 +23,7 @@
 
 
 /// STL
-#include <cstdlib> // rand()
+#include <limits>  // setFoodEffect()
 
 
 /// Personal
@@ -37,10 +37,7 @@ class ThinFood final : public Food
    public:
       /// Constructors and destructor
       // ThinFood teal
-      ThinFood (const Rectangle& rectangle = { 10, 10, 0, 0 }, const prg::Colour& colour = {64, 224, 208});
-
-      ThinFood (const unsigned short timerID, const unsigned int milliseconds,
-                const Rectangle& rectangle = {10, 10, 0, 0}, const prg::Colour& colour = {64, 224, 208});
+      ThinFood (const Cell& cell = {}, const prg::Colour& colour = {64, 224, 208});
 
       ThinFood (ThinFood&& move) = default;
       ThinFood (const ThinFood& copy) = default;
@@ -49,7 +46,7 @@ class ThinFood final : public Food
 
 
       /// Assignment functions
-      void setFoodEffect (unsigned int effectMin, unsigned int effectMax) override;
+      void setFoodEffect (unsigned int effectMin, unsigned int effectMax, Random& random) override;
 
    protected:
 
@@ -0,0 +1,49 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+
+/// STL
+#include <cstdint>   // std::uint64_t
+
+
+/// AllocationCounter counts the heap allocations made by each thread so code which is meant to leave the heap alone
+/// can prove it does. Counting replaces the global operator new so it's only compiled in when FLAKY_COUNT_ALLOCATIONS
+/// is defined, as it is in the debug and simulation builds; otherwise isAvailable() is false and the count stays 0.
+/// AllocationCounter is a leaf class which is never instantiated.
+class AllocationCounter final
+{
+   public:
+      /// Constructors and destructor
+      AllocationCounter() = delete;
+
+
+      /// Testing functions
+      static bool isAvailable();
+
+
+      /// Getters
+      /// How many allocations the calling thread has made, compare two counts to find how many a piece of code made
+      static std::uint64_t getCount();
+};
+
+#endif // ALLOCATIONCOUNTER_H
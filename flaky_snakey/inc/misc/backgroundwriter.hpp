@@ -0,0 +1,88 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef BACKGROUNDWRITER_H
+#define BACKGROUNDWRITER_H
+
+
+/// STL
+#include <condition_variable> // m_ready and m_done
+#include <cstddef>            // std::size_t
+#include <fstream>            // m_file
+#include <mutex>              // m_mutex
+#include <stdexcept>          // Constructor and close()
+#include <string>             // Constructor
+#include <thread>             // m_thread
+#include <vector>             // The buffers
+
+
+/// BackgroundWriter appends to a file from a thread of its own so whoever writes never waits on the disk. Writes are
+/// copied into a buffer, once it's full it is handed to the thread and a second buffer is filled in the meantime;
+/// a writer only ever waits if it fills a whole buffer before the disk has taken the last one. Any number of threads
+/// can write at once, each write is stored whole and in the order the writes were made.
+/// BackgroundWriter is a leaf class.
+class BackgroundWriter final
+{
+   public:
+      /// Constructors and destructor
+      /// Throws if the file can't be opened, append keeps whatever the file already contains
+      BackgroundWriter (const std::string& path, const bool append = false,
+                        const std::size_t bufferSize = 1 << 20);
+
+      /// Writes anything left, errors are only reported by close()
+      ~BackgroundWriter();
+
+      /// Explicitly disallow (Effective C++: Item 6)
+      BackgroundWriter (const BackgroundWriter& copy) = delete;
+      BackgroundWriter& operator= (const BackgroundWriter& copy) = delete;
+
+
+      /// Functionality
+      void write (const void* data, const std::size_t size);
+
+      /// Writes anything left and stops the thread, throws if anything failed to be written. Writing afterwards throws
+      void close();
+
+   protected:
+
+   private:
+      /// Functionality
+      void run(); /// The body of m_thread
+      void stop(); /// Hands over the last buffer and waits for m_thread to finish
+
+
+      /// Members
+      const std::size_t m_kBufferSize;    /// How full m_buffer gets before it is handed to m_thread
+
+      std::ofstream m_file;               /// Only ever used by m_thread once it has started
+      std::vector<char> m_buffer;         /// The buffer being written to
+      std::vector<char> m_pending;        /// The buffer waiting for m_thread, empty when there is none
+      std::vector<char> m_writing;        /// The buffer m_thread is writing to the file
+
+      std::mutex m_mutex;                 /// Guards everything but m_file and m_writing
+      std::condition_variable m_ready;    /// Wakes m_thread when m_pending is filled or the file is closing
+      std::condition_variable m_done;     /// Wakes writers when m_pending has been taken
+      bool m_closing;                     /// Whether close() has been called
+      bool m_failed;                      /// Whether the file has refused a write
+
+      std::thread m_thread;               /// Started last so every other member is ready
+};
+
+#endif // BACKGROUNDWRITER_H
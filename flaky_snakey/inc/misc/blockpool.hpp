@@ -0,0 +1,74 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef BLOCKPOOL_H
+#define BLOCKPOOL_H
+
+
+/// STL
+#include <cstddef>   // std::size_t
+#include <vector>    // m_free
+
+
+/// BlockPool keeps every block of memory given back to it and hands it out again the next time a block of the same
+/// size is wanted, so anything which is repeatedly created and destroyed only touches the heap until the pool has
+/// enough blocks for the busiest moment. Blocks are only freed when the pool is destroyed. A pool belongs to one
+/// thread, use PoolAllocator to have standard library containers and std::allocate_shared use one.
+/// BlockPool is a leaf class.
+class BlockPool final
+{
+   public:
+      /// Constructors and destructor
+      BlockPool();
+      ~BlockPool();
+
+      /// Explicitly disallow (Effective C++: Item 6)
+      BlockPool (const BlockPool& copy) = delete;
+      BlockPool& operator= (const BlockPool& copy) = delete;
+
+
+      /// Functionality
+      /// Throws std::bad_alloc like operator new if the heap is exhausted
+      void* allocate (const std::size_t size);
+
+      /// The block must have come from allocate() with the same size
+      void deallocate (void* block, const std::size_t size);
+
+   protected:
+
+   private:
+      /// Every block given back which has the same size, there's rarely more than a couple of sizes
+      struct FreeList final
+      {
+         std::size_t size;             /// The size of each block
+         std::size_t count;            /// How many blocks of this size have been allocated from the heap
+         std::vector<void*> blocks;    /// The blocks ready to be reused
+      };
+
+
+      /// Getters
+      FreeList& getFreeList (const std::size_t size);
+
+
+      /// Members
+      std::vector<FreeList> m_free;   /// A list for each size which has been allocated
+};
+
+#endif // BLOCKPOOL_H
@@ -0,0 +1,43 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef CELL_H_INCLUDED
+#define CELL_H_INCLUDED
+
+
+/// Cell is a packed grid co-ordinate, it's used wherever game logic needs to know where something is on the level.
+/// Keeping it to two shorts means a whole Snake body can be stored contiguously and copied cheaply.
+struct Cell final
+{
+   unsigned short x {0};
+   unsigned short y {0};
+
+   Cell() = default;
+   Cell (const unsigned short cellX, const unsigned short cellY) : x (cellX), y (cellY) {}
+   Cell (const Cell& copy) = default;
+   Cell (Cell&& move) = default;
+   Cell& operator= (const Cell& copy) = default;
+   ~Cell() = default;
+
+   bool operator== (const Cell& rhs) const { return x == rhs.x && y == rhs.y; }
+   bool operator!= (const Cell& rhs) const { return x != rhs.x || y != rhs.y; }
+};
+
+#endif // CELL_H_INCLUDED
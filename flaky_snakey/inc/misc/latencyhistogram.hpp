@@ -0,0 +1,85 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+
+/// STL
+#include <array>     // m_buckets
+#include <atomic>    // Every count is shared between threads
+#include <cstdint>   // std::uint64_t
+
+
+/// LatencyHistogram counts durations in nanoseconds using the bucketing of an HDR histogram. Durations below 128ns
+/// are counted exactly, beyond that each power of two is split into 64 buckets, so every percentile it reports is
+/// within 1.6% of the real duration from nanoseconds up to roughly 18 minutes. Recording is a handful of relaxed atomic
+/// operations so any number of threads can record into one histogram at once without ever taking a lock.
+/// LatencyHistogram is a leaf class.
+class LatencyHistogram final
+{
+   public:
+      /// Constructors and destructor
+      LatencyHistogram();
+
+      ~LatencyHistogram() = default;
+
+      /// Explicitly disallow (Effective C++: Item 6)
+      LatencyHistogram (const LatencyHistogram& copy) = delete;
+      LatencyHistogram& operator= (const LatencyHistogram& copy) = delete;
+
+
+      /// Functionality
+      /// Durations longer than the histogram can hold are counted in its last bucket
+      void record (const std::uint64_t nanoseconds);
+
+      /// Not atomic as a whole, durations recorded at the same time may or may not survive
+      void clear();
+
+
+      /// Getters
+      std::uint64_t getCount() const   { return m_count.load (std::memory_order_relaxed); }
+      std::uint64_t getMax() const     { return m_max.load (std::memory_order_relaxed); }
+
+      /// The largest duration which percentile% of the recorded durations are no longer than, 0 if nothing is recorded
+      std::uint64_t getPercentile (const double percentile) const;
+
+   protected:
+
+   private:
+      /// Values below 2^kSubBits have a bucket each, every power of two above has 2^(kSubBits - 1) buckets
+      static const unsigned int kSubBits = 7;
+      static const unsigned int kHalfCount = 1 << (kSubBits - 1);
+      static const unsigned int kMaxBits = 40;
+      static const unsigned int kBucketCount = (1 << kSubBits) + (kMaxBits - kSubBits) * kHalfCount;
+
+
+      /// Getters
+      static unsigned int getBucket (std::uint64_t value);
+      static std::uint64_t getBucketValue (const unsigned int bucket); /// The largest value counted by the bucket
+
+
+      /// Members
+      std::array<std::atomic<std::uint64_t>, kBucketCount> m_buckets;   /// How many durations fell in each bucket
+      std::atomic<std::uint64_t> m_count;                                /// The total of every bucket
+      std::atomic<std::uint64_t> m_max;                                  /// The longest duration recorded exactly
+};
+
+#endif // LATENCYHISTOGRAM_H
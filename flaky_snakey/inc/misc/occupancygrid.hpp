@@ -0,0 +1,213 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OCCUPANCYGRID_H
+#define OCCUPANCYGRID_H
+
+
+/// STL
+#include <cstdint>   // getHash() and Chunk::free
+#include <memory>    // m_chunks
+#include <stdexcept> // getFreeCell()
+#include <vector>    // m_chunks
+
+
+/// Personal
+#include <misc/cell.hpp>         // Used to locate cells
+#include <setup/ingamesetup.hpp> // m_kSetup
+
+
+/// OccupancyGrid is the single authoritative record of what occupies each cell of the level. Every manager updates it
+/// incrementally as objects appear, move and disappear, which turns every "is something here" query into a lookup.
+/// The level is split into square chunks which are only allocated once something enters them, so huge levels only
+/// pay for the area that has actually been used. Each chunk marks its free cells with a bit per cell and a Fenwick
+/// tree counts them, so any free cell can be found by its number in level order without searching the level. The
+/// numbering only depends on what is in the level, never on the order it got there, so a grid rebuilt from the
+/// objects in it is the same grid. Chunks are shared with every Snapshot taken of the grid and are only copied when
+/// written to afterwards, so saving costs a pointer per chunk and only the chunks that change are ever copied.
+/// A chunk which nothing else holds any more is kept rather than freed and the next copy is made into it, so a grid
+/// which is repeatedly saved or restored stops allocating once it has enough of them.
+/// OccupancyGrid is a leaf class.
+class OccupancyGrid final
+{
+   private:
+      struct Chunk;
+
+      friend class SaveGame; // Rebuilds the grid of a save
+
+   public:
+      /// The state of the grid at the time of save(), it can only be restored into a grid of the same dimensions
+      class Snapshot final
+      {
+         friend class OccupancyGrid;
+         friend class SaveGame;
+
+         std::vector<std::shared_ptr<const Chunk>> m_chunks;  /// Shares every chunk the grid had
+         std::vector<unsigned int> m_freeTree;                /// A copy of the Fenwick tree
+         unsigned int m_freeCells {0};                        /// How many cells inside the level were free
+         std::uint64_t m_hash {0};                            /// The hash of the contents
+      };
+
+
+      /// Constructors and destructor
+      OccupancyGrid (const InGameSetup& setup);
+
+      OccupancyGrid (OccupancyGrid&& move) = default;
+      ~OccupancyGrid() = default;
+
+      /// Explicitly disallow (Effective C++: Item 6)
+      OccupancyGrid (const OccupancyGrid& copy) = delete;
+      OccupancyGrid& operator= (const OccupancyGrid& copy) = delete;
+
+
+      /// Testing functions
+      bool isSnakeHere (const Cell& cell) const;
+      bool isObstacleHere (const Cell& cell) const;
+      bool isFoodHere (const Cell& cell) const;
+
+      /// Both are asked of every cell an AI searches so they're defined here to be inlined. A cell outside of the level
+      /// is never available so it counts as occupied
+      bool isOccupied (const Cell& cell) const
+      {
+         const auto contents = find (cell);
+         return contents ? contents->isOccupied() : getChunkIndex (cell) == m_chunks.size();
+      }
+
+      /// A Snake dies if it moves into a Snake part or an Obstacle, food can be moved into
+      bool isCollidable (const Cell& cell) const
+      {
+         const auto contents = find (cell);
+         return contents ? contents->snakeParts != 0 || contents->obstacle : getChunkIndex (cell) == m_chunks.size();
+      }
+
+
+      /// Assignment functions
+      /// Snake parts are counted because a head can briefly share a cell with anything before collisions are resolved
+      void addSnakePart (const Cell& cell);
+      void removeSnakePart (const Cell& cell);
+
+      void setObstacle (const Cell& cell, const bool obstacle);
+      void setFood (const Cell& cell, const bool food);
+
+      /// Both reuse the memory of the vectors they fill, neither copies a chunk. A chunk either lets go of is kept if
+      /// it was the last to hold it
+      void save (Snapshot& modify) const;
+      void restore (const Snapshot& snapshot);
+
+
+      /// Getters
+      unsigned int getSnakeParts (const Cell& cell) const;
+      unsigned int getAllocatedChunks() const;
+
+      /// Free cells are numbered 0 to getFreeCells() - 1 by chunk, then by row and column within the chunk
+      unsigned int getFreeCells() const   { return m_freeCells; }
+      Cell getFreeCell (const unsigned int index) const;
+
+      /// A hash of the contents of every cell, kept up to date as cells change so it never has to look at them. Cells
+      /// are hashed on their own and added together, so two grids holding the same things have the same hash
+      std::uint64_t getHash() const       { return m_hash; }
+
+   protected:
+
+   private:
+      /// Everything that can be inside a single cell, packed so a cell costs four bytes
+      struct Contents final
+      {
+         unsigned int snakeParts : 30;    /// How many Snake parts are in the cell, growth stacks parts in one cell
+         unsigned int obstacle : 1;       /// Whether an Obstacle is in the cell
+         unsigned int food : 1;           /// Whether Food is in the cell
+
+         Contents() : snakeParts (0), obstacle (0), food (0) { }
+
+         bool isOccupied() const { return snakeParts != 0 || obstacle || food; }
+
+         /// Every field packed into one number, zero for an empty cell
+         std::uint32_t getCode() const { return ((std::uint32_t) snakeParts << 2) | (obstacle << 1) | food; }
+      };
+
+      /// Each chunk covers kChunkSize * kChunkSize cells
+      static const unsigned int kChunkShift = 6;
+      static const unsigned int kChunkSize = 1 << kChunkShift;
+      static const unsigned int kChunkMask = kChunkSize - 1;
+
+      /// A row of a chunk is kChunkSize cells, the same as the bits in each word of free
+      struct Chunk final
+      {
+         std::vector<Contents> cells;        /// The contents of every cell, row by row
+         std::vector<std::uint64_t> free;    /// A word per row, bit x is set if that cell is free and inside the level
+      };
+
+
+      /// Functionality
+      /// Keeps the free cells and the hash in sync whenever a cell changes, before is what the cell held until now
+      void updateCell (const unsigned int chunkIndex, const unsigned int local, const Contents before);
+
+      /// Adds change to the free cell count of a chunk, the counts are stored as a Fenwick tree
+      void addToFreeTree (const unsigned int chunkIndex, const int change);
+
+
+      /// Getters
+      /// Returns m_chunks.size() if the cell lies outside of the level
+      unsigned int getChunkIndex (const Cell& cell) const
+      {
+         return cell.x < m_kSetup.getGridWidth() && cell.y < m_kSetup.getGridHeight() ?
+                (cell.y >> kChunkShift) * m_chunksX + (cell.x >> kChunkShift) : m_chunks.size();
+      }
+
+      unsigned int getLocalIndex (const Cell& cell) const { return ((cell.y & kChunkMask) << kChunkShift) |
+                                                                   (cell.x & kChunkMask); }
+
+      /// What a cell adds to the hash, an empty cell adds nothing
+      static std::uint64_t getCellHash (const unsigned int chunkIndex, const unsigned int local,
+                                        const Contents contents);
+
+      /// How many bits of the word are set
+      static unsigned int countBits (std::uint64_t bits);
+
+      /// How many cells of a chunk lie inside the level horizontally and vertically
+      unsigned int getChunkWidth (const unsigned int chunkIndex) const;
+      unsigned int getChunkHeight (const unsigned int chunkIndex) const;
+
+      /// Returns nullptr if the cell lies outside of the level or its chunk has never been used
+      const Contents* find (const Cell& cell) const
+      {
+         const unsigned int chunkIndex = getChunkIndex (cell);
+
+         return chunkIndex == m_chunks.size() || !m_chunks[chunkIndex] ? nullptr :
+                &m_chunks[chunkIndex]->cells[getLocalIndex (cell)];
+      }
+
+      /// Allocates the chunk on first use when asked to, a chunk shared with a Snapshot is copied before being returned
+      Chunk* fetch (const unsigned int chunkIndex, const bool allocate);
+
+
+      /// Members
+      const InGameSetup m_kSetup;                     /// Provides the dimensions of the grid
+      unsigned int m_chunksX;                         /// How many chunks span the width of the grid
+      std::vector<std::shared_ptr<Chunk>> m_chunks;   /// Stores the contents of every used chunk, row by row
+      std::vector<unsigned int> m_freeTree;           /// A Fenwick tree of the free cell count of every chunk
+      unsigned int m_freeCells;                       /// How many cells inside the level are free
+      std::uint64_t m_hash;                           /// The sum of getCellHash() for every cell
+
+      /// Chunks nothing else holds, reused by fetch() for its copies. Saving isn't a change to the grid
+      mutable std::vector<std::shared_ptr<Chunk>> m_spareChunks;
+};
+
+#endif // OCCUPANCYGRID_H
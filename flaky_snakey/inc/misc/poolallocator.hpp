@@ -0,0 +1,89 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef POOLALLOCATOR_H
+#define POOLALLOCATOR_H
+
+
+/// STL
+#include <cstddef>   // std::size_t
+#include <memory>    // m_pPool
+
+
+/// Personal
+#include <misc/blockpool.hpp> // m_pPool
+
+
+/// PoolAllocator is a standard allocator which takes its memory from a BlockPool. Every copy shares the pool and keeps
+/// it alive, so objects made with std::allocate_shared can safely outlive whatever created the allocator.
+/// PoolAllocator is a leaf class.
+template <typename T> class PoolAllocator final
+{
+   public:
+      using value_type = T;
+
+
+      /// Constructors and destructor
+      PoolAllocator (const std::shared_ptr<BlockPool>& pool) : m_pPool (pool) { }
+
+      /// Standard containers rebind the allocator to whatever they actually store
+      template <typename U> PoolAllocator (const PoolAllocator<U>& copy) : m_pPool (copy.getPool()) { }
+
+      PoolAllocator (const PoolAllocator& copy) = default;
+      PoolAllocator& operator= (const PoolAllocator& copy) = default;
+      ~PoolAllocator() = default;
+
+
+      /// Functionality
+      T* allocate (const std::size_t count)
+      {
+         return static_cast<T*> (m_pPool->allocate (count * sizeof (T)));
+      }
+
+      void deallocate (T* pointer, const std::size_t count)
+      {
+         m_pPool->deallocate (pointer, count * sizeof (T));
+      }
+
+
+      /// Getters
+      const std::shared_ptr<BlockPool>& getPool() const   { return m_pPool; }
+
+   protected:
+
+   private:
+      /// Members
+      std::shared_ptr<BlockPool> m_pPool; /// Where every allocation comes from
+};
+
+
+/// Allocators are equal when memory from one can be given back to the other
+template <typename T, typename U> bool operator== (const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs)
+{
+   return lhs.getPool() == rhs.getPool();
+}
+
+
+template <typename T, typename U> bool operator!= (const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs)
+{
+   return !(lhs == rhs);
+}
+
+#endif // POOLALLOCATOR_H
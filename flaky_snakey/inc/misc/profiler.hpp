@@ -0,0 +1,122 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+
+/// STL
+#include <atomic>    // m_enabled
+#include <chrono>    // Scope
+#include <cstdint>   // record()
+#include <ostream>   // report()
+
+
+/// Personal
+#include <misc/latencyhistogram.hpp> // Every phase has one
+
+
+/// Profiler times each phase of a tick, the drawing of each part of the level and every controller's decision. Each
+/// phase has a LatencyHistogram of its own so the timings of every thread end up in one place without any locking,
+/// and the report gives the median, 99th percentile and worst duration of each. Timing starts disabled and costs a
+/// single relaxed load per phase until enabled, so the simulation only pays for it when asked to. Builds which count
+/// allocations also have the heap allocations of every tick after warming up recorded and reported alongside.
+/// Profiler is a leaf class which is never instantiated.
+class Profiler final
+{
+   public:
+      /// Every phase which is timed, Count must stay last
+      enum class Phase : unsigned int
+      {
+         FoodUpdate,
+         SpawnSearch,
+         SnakeUpdate,
+         Collisions,
+         Flakes,
+         DrawSnakes,
+         DrawFood,
+         DrawObstacles,
+         DrawInterface,
+         PlayerMove,
+         GenericMove,
+         DumbMove,
+         SmartMove,
+         PathfindingMove,
+         MCTSMove,
+         DistanceField,
+         DangerMap,
+         Count
+      };
+
+      /// Times the phase from construction to destruction
+      class Scope final
+      {
+         public:
+            Scope (const Phase phase);
+            ~Scope();
+
+            Scope (const Scope& copy) = delete;
+            Scope& operator= (const Scope& copy) = delete;
+
+         private:
+            const Phase m_kPhase;                                 /// What is being timed
+            const bool m_kEnabled;                                /// Whether timing was enabled on construction
+            std::chrono::steady_clock::time_point m_start;        /// Only read if m_kEnabled
+      };
+
+
+      /// Constructors and destructor
+      Profiler() = delete;
+
+
+      /// Testing functions
+      static bool isEnabled()                      { return m_enabled.load (std::memory_order_relaxed); }
+
+      /// Containers growing to fit a bigger game allocate now and then, a tick which allocates every time it's run
+      /// shows up as more than one tick in ten allocating
+      static bool isTickAllocating();
+
+
+      /// Functionality
+      static void record (const Phase phase, const std::uint64_t nanoseconds);
+      static void recordAllocations (const std::uint64_t allocations); /// The allocations made by a single tick
+      static void clear();
+
+      /// Writes a line for every phase which has been timed and the allocations per tick, nothing if none were recorded
+      static void report (std::ostream& output);
+
+
+      /// Assignment functions
+      static void setEnabled (const bool enabled)   { m_enabled.store (enabled, std::memory_order_relaxed); }
+
+
+      /// Getters
+      static const LatencyHistogram& getHistogram (const Phase phase);
+      static const LatencyHistogram& getAllocations();
+      static const char* getName (const Phase phase);
+
+   protected:
+
+   private:
+      /// Members
+      static std::atomic<bool> m_enabled;    /// Whether Scope objects record anything
+};
+
+#endif // PROFILER_H
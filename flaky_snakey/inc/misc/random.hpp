@@ -0,0 +1,68 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+
+/// STL
+#include <cstdint>   // m_state
+#include <stdexcept> // next()
+
+
+/// Random is the random number engine of a single game. Each World owns one and hands it to everything that needs
+/// random numbers, so games never share state and a game played from the same seed always plays out the same way.
+/// The generator is xoshiro128**, it is fast, has no lock and only sixteen bytes of state, so copying it is cheap.
+/// Random is a leaf class.
+class Random final
+{
+   public:
+      /// Constructors and destructor
+      /// Each stream of the same seed is a separate sequence, stream 0 is the sequence seed() alone gives
+      Random (const unsigned int seed = 1, const unsigned int stream = 0);
+
+      Random (Random&& move) = default;
+      Random (const Random& copy) = default;
+      Random& operator= (const Random& copy) = default;
+      ~Random() = default;
+
+
+      /// Functionality
+      /// Any seed is valid, the state is expanded from it with SplitMix64 so it can never be all zero
+      void seed (const unsigned int seed, const unsigned int stream = 0);
+
+      /// Returns a uniformly random 32-bit number
+      std::uint32_t next();
+
+      /// Returns a number from 0 to bound - 1 without the bias of %, bound must not be 0
+      unsigned int next (const unsigned int bound);
+
+      friend class SaveGame; // Stores the state in its file
+      friend class World;    // Hashes the state in getStateHash()
+
+   protected:
+
+   private:
+      /// Members
+      std::uint32_t m_state[4]; /// The state of the generator
+};
+
+#endif // RANDOM_H
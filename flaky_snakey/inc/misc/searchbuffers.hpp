@@ -0,0 +1,152 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SEARCHBUFFERS_H
+#define SEARCHBUFFERS_H
+
+
+/// STL
+#include <vector>    // The buffers
+
+
+/// Personal
+#include <misc/cell.hpp>         // getIndex() and getCell()
+#include <misc/movement.hpp>     // Chunk::firstMoves
+#include <setup/ingamesetup.hpp> // Constructor
+
+
+/// SearchBuffers holds the memory searches of the level run in so that a search never allocates once it has warmed up.
+/// A cell counts as visited when its stamp matches the current generation, starting a new search is a single
+/// increment rather than clearing every cell. Like OccupancyGrid the level is split into square chunks which are only
+/// allocated once a search enters them, searches stay close to a Snake so huge levels only pay for what is searched.
+/// Levels small enough to be reserved up front never allocate at all, huge ones allocate whenever a search first
+/// reaches a chunk. The AI of a World decides one Snake at a time so one set of buffers is shared by every controller.
+/// SearchBuffers is a leaf class.
+class SearchBuffers final
+{
+   public:
+      /// Constructors and destructor
+      SearchBuffers (const InGameSetup& setup);
+
+      SearchBuffers (SearchBuffers&& move) = default;
+      ~SearchBuffers() = default;
+
+      /// Explicitly disallow (Effective C++: Item 6)
+      SearchBuffers (const SearchBuffers& copy) = delete;
+      SearchBuffers& operator= (const SearchBuffers& copy) = delete;
+
+
+      /// Testing functions
+      bool isVisited (const unsigned int index) const
+      {
+         const auto& chunk = m_chunks[index >> kChunkBits];
+
+         return !chunk.stamps.empty() && chunk.stamps[index & kLocalMask] == m_generation;
+      }
+
+
+      /// Functionality
+      /// Every cell becomes unvisited and both frontiers are emptied
+      void beginSearch();
+
+      /// Gives every chunk its buffers and makes room for frontier cells in each frontier. Does nothing on a level with
+      /// more than kMaxReservedCells cells, which would cost more memory than its searches ever use
+      void reserve (const unsigned int frontier);
+
+
+      /// Assignment functions
+      /// Marks the cell as visited, firstMove is the move from the start of the search which leads to it and distance
+      /// is how many moves it is from the start
+      void visit (const unsigned int index, const Movement firstMove, const unsigned int distance = 0)
+      {
+         auto& chunk = m_chunks[index >> kChunkBits];
+
+         if (chunk.stamps.empty())
+         {
+            allocate (chunk);
+         }
+
+         chunk.stamps[index & kLocalMask] = m_generation;
+         chunk.firstMoves[index & kLocalMask] = (unsigned char) firstMove;
+         chunk.distances[index & kLocalMask] = distance;
+      }
+
+
+      /// Getters
+      /// Cells are identified by an index which keeps the cells of a chunk together, it isn't y * width + x
+      unsigned int getIndex (const Cell& cell) const
+      {
+         return (((cell.y >> kChunkShift) * m_chunksX + (cell.x >> kChunkShift)) << kChunkBits) |
+                ((cell.y & kChunkMask) << kChunkShift) | (cell.x & kChunkMask);
+      }
+
+      Cell getCell (const unsigned int index) const;
+
+      /// Only meaningful for a visited cell
+      Movement getFirstMove (const unsigned int index) const
+      {
+         return (Movement) m_chunks[index >> kChunkBits].firstMoves[index & kLocalMask];
+      }
+
+      unsigned int getDistance (const unsigned int index) const
+      {
+         return m_chunks[index >> kChunkBits].distances[index & kLocalMask];
+      }
+
+      /// Both keep their memory between searches so they only grow until they fit the largest search
+      std::vector<unsigned int>& getFrontier()                 { return m_frontier; }
+      std::vector<unsigned int>& getNextFrontier()             { return m_nextFrontier; }
+
+   protected:
+
+   private:
+      /// Each chunk covers kChunkSize * kChunkSize cells, the same as the chunks of OccupancyGrid
+      static const unsigned int kChunkShift = 6;
+      static const unsigned int kChunkBits = kChunkShift * 2;
+      static const unsigned int kChunkSize = 1 << kChunkShift;
+      static const unsigned int kChunkMask = kChunkSize - 1;
+      static const unsigned int kLocalMask = (1 << kChunkBits) - 1;
+
+      /// The cells of a 1024x1024 level, about 9 MB of chunks
+      static const unsigned int kMaxReservedCells = 1 << 20;
+
+      /// Every buffer is empty until a search first visits the chunk
+      struct Chunk final
+      {
+         std::vector<unsigned int> stamps;         /// The generation in which each cell was last visited
+         std::vector<unsigned char> firstMoves;    /// The first move of the path to each visited cell
+         std::vector<unsigned int> distances;      /// How far each visited cell is from the start
+      };
+
+
+      /// Assignment functions
+      /// Gives a chunk its buffers the first time a search visits it
+      void allocate (Chunk& chunk);
+
+
+      /// Members
+      unsigned int m_chunksX;                      /// How many chunks span the width of the level
+      std::vector<Chunk> m_chunks;                 /// Every chunk of the level, row by row
+      std::vector<unsigned int> m_frontier;        /// The cells waiting to be expanded
+      std::vector<unsigned int> m_nextFrontier;    /// The cells which are expanded once m_frontier is empty
+      unsigned int m_generation;                   /// Identifies the current search, never 0 so cells start unvisited
+};
+
+#endif // SEARCHBUFFERS_H
@@ -23,7 +23,15 @@
 
 
 /// STL
-#include <string>
+#include <string> // m_name and m_scoreText
+
+
+/// Third party
+#include <prg/core/colour.hpp> // m_colour
+
+
+/// Personal
+#include <misc/snakeutilities.hpp> // setScore()
 
 
 /// SnakeScore is primarily a data class which is used to represent a player in the games score on the user interface.
@@ -49,20 +57,25 @@ class SnakeScore final
       void setPlayerNumber (const unsigned int playerNumber);
 
       void setAlive (const bool alive)          { m_alive = alive; }
-      void setScore (const unsigned int score)  { m_score = score; }
+      void setColour (const prg::Colour& colour){ m_colour = colour; }
+      void setScore (const unsigned int score);
 
 
       /// Getters
       const std::string& getName() const     { return m_name; }
       unsigned int getPlayerNumber() const   { return m_playerNumber; }
       unsigned int getScore() const          { return m_score; }
+      const std::string& getScoreText() const{ return m_scoreText; }
+      const prg::Colour& getColour() const   { return m_colour; }
 
    protected:
    private:
       std::string m_name;           /// The name of the Snake
       unsigned int m_playerNumber;  /// The corresponding player number of the Snake
       unsigned int m_score;         /// The score of the Snake
+      std::string m_scoreText;      /// m_score as text, only rewritten when the score changes
       bool m_alive;                 /// Whether the Snake is alive or not
+      prg::Colour m_colour;         /// The colour the Snake is drawn in
 };
 
 #endif // SNAKESCORE_H
@@ -0,0 +1,48 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SNAKESPAWN_H_INCLUDED
+#define SNAKESPAWN_H_INCLUDED
+
+
+/// Third party
+#include <prg/core/colour.hpp> // colour
+
+
+/// Personal
+#include <misc/cell.hpp>      // cell
+#include <misc/movement.hpp>  // direction
+
+
+/// Snake requires a SnakeSpawn to know where it starts, which way it's facing and what colour it should be drawn.
+struct SnakeSpawn final
+{
+   Cell cell {};
+   Movement direction {Movement::Right};
+   prg::Colour colour {255, 0, 0};
+
+   SnakeSpawn() = default;
+   SnakeSpawn (const SnakeSpawn& copy) = default;
+   SnakeSpawn (SnakeSpawn&& move) = default;
+   SnakeSpawn& operator= (const SnakeSpawn& copy) = default;
+   ~SnakeSpawn() = default;
+};
+
+#endif // SNAKESPAWN_H_INCLUDED
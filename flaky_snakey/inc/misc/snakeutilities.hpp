@@ -23,14 +23,22 @@
 
 
 /// STL
-#include <iostream>  // Used in flushCin()
-#include <limits>    // Used in flushCin()
-#include <sstream>   // Used in intToString()
+#include <iostream>        // Used in flushCin()
+#include <limits>          // Used in flushCin()
+#include <sstream>         // Used in intToString()
+#include <unordered_set>   // Used in generateSpawns()
+#include <vector>          // Used in generateSpawns()
+
+
+/// Third party
+#include <prg/core/colour.hpp> // Used in generateColour()
 
 
 /// Personal
-#include <misc/rectangle.hpp>    // moveCell
-#include <setup/ingamesetup.hpp> // moveCell
+#include <misc/cell.hpp>         // moveCell and toRectangle
+#include <misc/rectangle.hpp>    // toRectangle
+#include <misc/snakespawn.hpp>   // generateSpawns
+#include <setup/ingamesetup.hpp> // moveCell and toRectangle
 
 
 /// Used to contain all convenience/global functionality required by the game
@@ -43,8 +51,29 @@ namespace utility
    std::string intToString (const int value);
    std::string intToString (const unsigned int value);
 
-   /// A boundary aware function to move a Rectangle however many cells is specified
-   Rectangle& moveCell (const InGameSetup& setup, Rectangle& modify, int moveX, int moveY);
+   /// Writes the digits straight into modify, a string which already has room for them is never reallocated
+   void intToString (const unsigned int value, std::string& modify);
+
+   /// A boundary aware function to move a Cell however many cells is specified
+   Cell& moveCell (const InGameSetup& setup, Cell& modify, int moveX, int moveY);
+
+   /// The shortest signed distance along an axis of length size, the level wraps so it's never more than half of size
+   int wrapDifference (const int difference, const int size);
+
+   /// The Manhattan distance between two cells, taking the shortest way around the wrapping level
+   unsigned int getWrappedDistance (const InGameSetup& setup, const Cell& from, const Cell& to);
+
+   /// Projects a cell onto the screen, this should only ever be needed when drawing
+   Rectangle toRectangle (const InGameSetup& setup, const Cell& cell);
+
+   /// Players 1-4 keep their red, green, blue and yellow, everyone after is spread evenly around the colour wheel
+   prg::Colour generateColour (const unsigned int playerNumber);
+
+   /// The maximum number of snakes that can be given their own spawn point
+   unsigned int getSpawnCapacity (const InGameSetup& setup);
+
+   /// Fills modify with amount spawn points, the first four are always the classic corners. Throws if they won't fit
+   void generateSpawns (const InGameSetup& setup, const unsigned int amount, std::vector<SnakeSpawn>& modify);
 }
 
 #endif // SNAKE_UTILITIES_H
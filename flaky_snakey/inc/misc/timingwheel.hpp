@@ -0,0 +1,110 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+
+/// STL
+#include <limits>    // kNone
+#include <stdexcept> // schedule()
+#include <vector>    // m_heads and the links
+
+
+/// TimingWheel keeps track of deadlines measured in ticks. Each id can have one deadline, ids are small numbers which are
+/// reused, such as FoodManager handles. The wheel is hierarchical: level 0 has a slot for each of the next 256 ticks and
+/// each level above covers 256 times as much time. Scheduling and cancelling are O(1) because each slot is a doubly
+/// linked list threaded through arrays indexed by id. Advancing is O(1) amortised, entries in higher levels are moved
+/// down a level at a time as their slot comes round, so each one moves at most three times before it expires.
+/// TimingWheel is a leaf class.
+class TimingWheel final
+{
+   public:
+      /// Constructors and destructor
+      TimingWheel();
+
+      TimingWheel (TimingWheel&& move) = default;
+      TimingWheel (const TimingWheel& copy) = default;
+      TimingWheel& operator= (const TimingWheel& copy) = default;
+      ~TimingWheel() = default;
+
+
+      /// Testing functions
+      bool isScheduled (const unsigned int id) const { return id < m_slots.size() && m_slots[id] != kNone; }
+
+
+      /// Functionality
+      /// Moves time on by one tick, fills modify with every id which expires on the new tick
+      void advance (std::vector<unsigned int>& modify);
+
+      /// Removes every deadline, time carries on from the current tick
+      void clear();
+
+      /// Makes room for the ids below count so scheduling them never allocates
+      void reserve (const unsigned int count);
+
+
+      /// Assignment functions
+      /// The id expires when getTick() reaches deadline, a deadline which has already passed expires on the next tick
+      void schedule (const unsigned int id, const unsigned int deadline);
+
+      /// Does nothing if the id isn't scheduled
+      void cancel (const unsigned int id);
+
+
+      /// Getters
+      /// Throws if the id isn't scheduled
+      unsigned int getDeadline (const unsigned int id) const;
+
+      unsigned int getTick() const { return m_tick; }
+
+   protected:
+
+   private:
+      /// Each level has 2^kLevelBits slots, four levels cover every 32-bit deadline
+      static const unsigned int kLevelBits = 8;
+      static const unsigned int kLevelSlots = 1 << kLevelBits;
+      static const unsigned int kLevelMask = kLevelSlots - 1;
+      static const unsigned int kLevels = 4;
+
+      /// Marks the end of a list and ids which aren't scheduled
+      static const unsigned int kNone = std::numeric_limits<unsigned int>::max();
+
+
+      /// Functionality
+      void link (const unsigned int id);    /// Adds a scheduled id to the slot its deadline belongs in
+      void unlink (const unsigned int id);  /// Removes an id from its slot
+
+      /// Moves every entry of a slot down into the levels below
+      void cascade (const unsigned int level);
+
+
+      /// Members
+      unsigned int m_tick;                   /// The current tick
+      std::vector<unsigned int> m_heads;     /// The first id in each slot, level by level
+
+      std::vector<unsigned int> m_deadlines; /// The deadline of each id
+      std::vector<unsigned int> m_slots;     /// The slot of each id, kNone if it isn't scheduled
+      std::vector<unsigned int> m_next;      /// The next id in the same slot
+      std::vector<unsigned int> m_previous;  /// The previous id in the same slot
+};
+
+#endif // TIMINGWHEEL_H
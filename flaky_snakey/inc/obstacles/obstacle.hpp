@@ -27,17 +27,18 @@
 
 
 /// Personal
-#include <interfaces/idrawable.hpp> // Parent
-#include <misc/rectangle.hpp> // m_kRectangle
+#include <misc/cell.hpp>         // m_kCell
+#include <setup/ingamesetup.hpp> // draw()
 
 
-/// Used to represent obstacles for snakes to collide with such as a wall
-class Obstacle : public IDrawable
+/// Used to represent obstacles for snakes to collide with such as a wall. An Obstacle only knows which cell it is in,
+/// the InGameSetup passed to draw() decides where that cell is on the screen.
+class Obstacle
 {
    public:
       /// Constructors and destructor
       // Optional first is required by ObstacleManager, Obstacle is grey
-      Obstacle (const Rectangle& rectangle = { 10, 10, 0, 0 }, const prg::Colour& colour = { 112, 138, 144 });
+      Obstacle (const Cell& cell = {}, const prg::Colour& colour = { 112, 138, 144 });
 
       Obstacle (const Obstacle& copy) = default;
       Obstacle& operator= (const Obstacle& copy) = default;
@@ -45,15 +46,16 @@ class Obstacle : public IDrawable
 
 
       /// Functionality
-      virtual void draw (prg::Canvas& canvas) override;
+      /// Draw the object onto the screen, projection converts the cell into pixels
+      virtual void draw (prg::Canvas& canvas, const InGameSetup& projection) const;
 
 
       /// Getters
-      const Rectangle& getRectangle() const  { return m_kRectangle; }
+      const Cell& getCell() const            { return m_kCell; }
       const prg::Colour& getColour() const   { return m_kColour; }
 
    protected:
-      const Rectangle m_kRectangle; /// Contains the location and size of Obstacle
+      const Cell m_kCell;           /// Contains the location of Obstacle
       const prg::Colour m_kColour;  /// The colour used when drawing onto the screen
 
    private:
@@ -23,23 +23,39 @@
 
 
 /// STL
+#include <algorithm> // isSpawnSafe() and addObstacles()
+#include <memory>    // m_pGrid
 #include <vector>    // m_levelObstacles
 
 
 /// Personal
+#include <misc/occupancygrid.hpp> // m_pGrid
+#include <misc/snakespawn.hpp>    // Constructor
 #include <setup/ingamesetup.hpp> // m_setup
 #include <obstacles/obstacle.hpp> // m_levelObstacles
 
 
 /// ObstacleManager is responsible for the storage and usage of all objects in the Obstacle base class, it manages
-/// no derivatives such as Food.
+/// no derivatives such as Food. Obstacles are keyed by cell through the OccupancyGrid so adding, de-duplicating and
+/// finding them never searches m_levelObstacles, which is only walked to draw and clear them.
 /// ObstacleManager is a leaf class.
 class ObstacleManager final
 {
    public:
+      /// Every Obstacle at the time of save(), the cells themselves are recorded by the OccupancyGrid's Snapshot
+      class Snapshot final
+      {
+         friend class ObstacleManager;
+         friend class SaveGame;
+
+         std::vector<Obstacle> m_obstacles {}; /// A copy of m_levelObstacles
+      };
+
+
       /// Constructors and destructor
-      // levelObs would allow for level editor functionality
-      ObstacleManager (const InGameSetup& setup, const std::vector<Obstacle>& levelObs = {});
+      // levelObs would allow for level editor functionality, spawns are kept clear by setObstacles()
+      ObstacleManager (const InGameSetup& setup, const std::shared_ptr<OccupancyGrid>& grid,
+                       const std::vector<SnakeSpawn>& spawns, const std::vector<Obstacle>& levelObs = {});
 
       ObstacleManager (ObstacleManager&& move) = default;
       ~ObstacleManager() = default;
@@ -50,7 +66,7 @@ class ObstacleManager final
 
 
       /// Testing functions
-      bool isObstacleHere (const Rectangle& rect) const;
+      bool isObstacleHere (const Cell& cell) const;
 
 
       /// Functionality
@@ -58,10 +74,15 @@ class ObstacleManager final
 
 
       /// Assignment functions
-      void addObstacle (const Rectangle& rect);                   /// Adds an Obstacle to the vector
+      void addObstacle (const Cell& cell);                        /// Adds an Obstacle to the vector
+      void addObstacles (const std::vector<Cell>& cells);         /// Adds an Obstacle for every new cell at once
       void clearObstacles();                                      /// Completely clears the vector
       void setObstacles (const std::vector<Obstacle>& levelObs);  /// Resets obstacles to levelObs
 
+      /// Neither touches the grid, it must be restored alongside the ObstacleManager
+      void save (Snapshot& modify) const;
+      void restore (const Snapshot& snapshot);
+
    protected:
 
    private:
@@ -71,13 +92,19 @@ class ObstacleManager final
 
 
       /// Testing functions
-      /// Ensures that default snake spawn points are clear in the passed vector
-      bool isSpawnSafe (const std::vector<Obstacle>& levelObs);
+      /// Ensures that every snake spawn point is clear in the passed vector
+      bool isSpawnSafe (const std::vector<Obstacle>& levelObs) const;
+
+
+      /// Assignment functions
+      void insertObstacle (const Obstacle& obstacle); /// Stores the Obstacle and records it in the grid
 
 
       /// Members
       const InGameSetup m_kSetup;               /// Contains all information required for rendering
+      std::shared_ptr<OccupancyGrid> m_pGrid;   /// Every Obstacle is recorded in the grid for quick lookups
       std::vector<Obstacle> m_levelObstacles;   /// Stores all default obstacles
+      std::vector<unsigned int> m_spawnKeys;    /// The sorted grid index of every snake spawn point
 };
 
 #endif // OBSTACLEMANAGER_H
@@ -63,6 +63,7 @@ class InGameSetup
 
       unsigned int getGridWidth() const   { return m_gridWidth; }
       unsigned int getGridHeight() const  { return m_gridHeight; }
+      unsigned int getCellsPerRect() const { return m_cellsPerRect; }
       unsigned int getRectWidth() const   { return m_rectWidth; }
       unsigned int getRectHeight() const  { return m_rectHeight; }
 
@@ -90,6 +91,12 @@ class InGameSetup
 
       unsigned int m_gridWidth;  /// The width of the grid used by the level
       unsigned int m_gridHeight; /// The height of the grid used by the level
+      unsigned int m_viewWidth;  /// How many Rectangle objects span the width of the level when drawn
+      unsigned int m_viewHeight; /// How many Rectangle objects span the height of the level when drawn
+
+      /// The width and height in cells of the block each Rectangle covers, only above 1 when the grid has more cells
+      /// than there are pixels available
+      unsigned int m_cellsPerRect;
       unsigned int m_rectWidth;  /// The width of each single cell Rectangle object
       unsigned int m_rectHeight; /// The height of each single cell Rectangle object
 
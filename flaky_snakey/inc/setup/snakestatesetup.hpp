@@ -23,6 +23,7 @@
 
 
 /// STL
+#include <memory> // m_pReplay
 #include <string> // m_namesP
 #include <vector> // m_keymapsP
 
@@ -36,6 +37,10 @@
 #include <misc/keymap.hpp> // Given to PlayerController classes
 
 
+/// Forward declarations
+class Replay;
+
+
 /// This class is used to provide the extra data needed for SnakeState to function correctly and efficiently. Most is
 /// required at creation, the rest is used constantly during runtime.
 /// SnakeStateSetup is a leaf class.
@@ -63,8 +68,31 @@ class SnakeStateSetup final : public InGameSetup
       SnakeStateSetup& setScoring (const unsigned int food);
       SnakeStateSetup& setSnakeInterval (const unsigned int msInterval);
 
+      /// Every game played from the same non-zero seed plays out the same way, 0 gives each game a new seed
+      SnakeStateSetup& setSeed (const unsigned int seed) { m_seed = seed; return *this; }
+
       SnakeStateSetup& setForceReset (const bool reset) { m_forceReset = reset; return *this; }
 
+      /// How many threads MCTS AI plays ahead on, 0 uses every hardware thread
+      SnakeStateSetup& setRolloutThreads (const unsigned int threads) { m_rolloutThreads = threads; return *this; }
+
+      /// The last game played in the main state, ReplayState plays it back
+      SnakeStateSetup& setReplay (const std::shared_ptr<const Replay>& replay) { m_pReplay = replay; return *this; }
+
+      /// Copies every setting which changes how the game plays, the resolution, names, keys and seed are kept
+      SnakeStateSetup& setGame (const SnakeStateSetup& game);
+
+      /// The main game as it was when it was last left, nullptr if it was over. The pause state writes it to disk
+      SnakeStateSetup& setSavedGame (const std::shared_ptr<const std::vector<unsigned char>>& save)
+      {
+         m_pSavedGame = save;
+         return *this;
+      }
+
+      /// Asks the main state to load the save at getSavePath() when it's next entered
+      SnakeStateSetup& setLoadGame (const bool load)         { m_loadGame = load; return *this; }
+      SnakeStateSetup& setSavePath (const std::string& path) { m_savePath = path; return *this; }
+
 
       /// Getters
       bool getForceReset() const                   { return m_forceReset; }
@@ -75,12 +103,19 @@ class SnakeStateSetup final : public InGameSetup
       unsigned int getScoreFood() const            { return m_scoreFood; }
       unsigned int getSnakeUpdateInterval() const  { return m_snakeUpdateInterval; }
       unsigned int getFoodRotInterval() const      { return m_foodRotInterval; }
+      unsigned int getSeed() const                 { return m_seed; }
+      unsigned int getRolloutThreads() const       { return m_rolloutThreads; }
       const std::string& getSnakeAI() const        { return m_snakeAI; }
+      const std::shared_ptr<const Replay>& getReplay() const { return m_pReplay; }
+      const std::shared_ptr<const std::vector<unsigned char>>& getSavedGame() const { return m_pSavedGame; }
+      bool getLoadGame() const                     { return m_loadGame; }
+      const std::string& getSavePath() const       { return m_savePath; }
 
 
       friend class SnakeState;      // Only SnakeState and derivatives can access the vectors
       friend class MainSnakeState;
       friend class DemoSnakeState;
+      friend class World;
 
    protected:
 
@@ -96,7 +131,13 @@ class SnakeStateSetup final : public InGameSetup
       unsigned int m_scoreFood;           /// The score achieved by eating some food
       unsigned int m_snakeUpdateInterval; /// How often (in ms) the snakes are updated
       unsigned int m_foodRotInterval;     /// How quickly the ThinFood rot
+      unsigned int m_seed;                /// Seeds the random engine of each game, 0 for a new seed every game
+      unsigned int m_rolloutThreads;      /// How many threads MCTS AI plays ahead on, 0 for every hardware thread
       std::string m_snakeAI;              /// How smart the AI snakes are
+      std::shared_ptr<const Replay> m_pReplay; /// The last game played, nullptr until one has finished
+      std::shared_ptr<const std::vector<unsigned char>> m_pSavedGame; /// The paused game, ready to be written
+      bool m_loadGame;                    /// Should the main state load the save when it's entered?
+      std::string m_savePath;             /// Where the pause state saves and loads the game
 };
 
 #endif // GAMESTATESETUP_H
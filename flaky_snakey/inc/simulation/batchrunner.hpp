@@ -0,0 +1,104 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+
+/// STL
+#include <atomic>  // work()
+#include <ostream> // report()
+#include <string>  // m_replayPath
+#include <vector>  // m_results
+
+
+/// Personal
+#include <misc/backgroundwriter.hpp> // playMatch()
+#include <setup/snakestatesetup.hpp> // m_setup
+
+
+/// The outcome of a single match played by BatchRunner
+struct MatchResult final
+{
+   unsigned int ticks;        /// How many ticks the match lasted
+   unsigned int winnerIndex;  /// As given by SnakeManager::getWinnerIndex()
+   bool finished;             /// False if the match was stopped at the tick limit
+};
+
+
+/// BatchRunner plays many complete AI matches in headless Worlds, stepping each one as fast as possible. Matches are
+/// shared out between worker threads which claim the next match number as they become free; a World owns all of its
+/// state so the workers share nothing but that counter. Match n is seeded with the seed of the setup plus n so the
+/// results are the same for any number of threads and any single match can be reproduced on its own. Every match can
+/// be recorded into a single replay file, one replay after another in the order the matches finish.
+/// BatchRunner is a leaf class.
+class BatchRunner final
+{
+   public:
+      /// Constructors and destructor
+      /// A maxTicks of 0 lets every match run until it ends, 0 threads uses every hardware thread. MCTS matches
+      /// given 0 rollout threads by the setup share the hardware threads between the matches played at once
+      BatchRunner (const SnakeStateSetup& setup, const unsigned int matches, const unsigned int maxTicks,
+                   const unsigned int threads);
+
+      BatchRunner (BatchRunner&& move) = default;
+      ~BatchRunner() = default;
+
+      /// Explicitly disallow (Effective C++: Item 6)
+      BatchRunner (const BatchRunner& copy) = delete;
+      BatchRunner& operator= (const BatchRunner& copy) = delete;
+
+
+      /// Functionality
+      void run();                               /// Plays every match, replacing any previous results
+      void report (std::ostream& output) const; /// Writes throughput, match lengths and win rates
+
+
+      /// Assignment functions
+      /// run() replaces the file at path with a replay of every match, an empty path records nothing
+      void setReplayPath (const std::string& path) { m_replayPath = path; }
+
+
+      /// Getters
+      const std::vector<MatchResult>& getResults() const { return m_results; }
+
+   protected:
+
+   private:
+      /// Functionality
+      /// The replay is only written if replays isn't nullptr
+      MatchResult playMatch (const unsigned int match, BackgroundWriter* replays) const;
+
+      /// Plays matches until none are left, next is the number of the next unclaimed match
+      void work (std::atomic<unsigned int>& next, BackgroundWriter* replays);
+
+
+      /// Members
+      SnakeStateSetup m_setup;            /// Every match is created from this
+      const unsigned int m_kMatches;      /// How many matches run() plays
+      const unsigned int m_kMaxTicks;     /// The tick limit of each match, 0 means no limit
+      unsigned int m_threads;             /// How many worker threads run() uses
+      std::string m_replayPath;           /// Where run() records the matches, empty for nowhere
+      std::vector<MatchResult> m_results; /// The result of every match in the order they were played
+      double m_seconds;                   /// The wall-clock time taken by the last run()
+};
+
+#endif // BATCHRUNNER_H
@@ -0,0 +1,102 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+
+/// STL
+#include <cstddef>   // std::size_t
+#include <cstdint>   // Keyframe
+#include <memory>    // load()
+#include <stdexcept> // Constructor
+#include <string>    // load()
+#include <vector>    // m_moves
+
+
+/// Personal
+#include <misc/movement.hpp>          // getMoves()
+#include <setup/snakestatesetup.hpp>  // m_setup
+
+
+/// Replay is a match recorded by ReplayRecorder, read back into the setup and seed of its World and the move of every
+/// Snake on every tick. The move stream is decoded once when the Replay is created and kept packed at two bits a move,
+/// any tick can then be read without decoding the ticks before it. The keyframes are kept as the saves they were
+/// recorded as, each is checked when the Replay is created but only restored when a ReplayPlayer seeks to it.
+/// Replay is a leaf class.
+class Replay final
+{
+   public:
+      /// The World as it was on a recorded tick
+      struct Keyframe final
+      {
+         unsigned int tick;                /// The tick the World was on
+         std::uint32_t hash;               /// World::getStateHash() on that tick
+         std::vector<unsigned char> save;  /// The World written by SaveGame, ready to be restored
+      };
+
+
+      /// Constructors and destructor
+      /// Reads the replay at the start of data, throws if it is incomplete, corrupt or from an unknown version
+      Replay (const unsigned char* data, const std::size_t size);
+
+      Replay (const Replay& copy) = default;
+      Replay (Replay&& move) = default;
+      Replay& operator= (const Replay& copy) = default;
+      ~Replay() = default;
+
+
+      /// Functionality
+      /// Appends every replay in the file at path to modify, throws if the file can't be read or isn't all replays
+      static void load (const std::string& path, std::vector<std::shared_ptr<const Replay>>& modify);
+
+
+      /// Getters
+      /// Fills modify with the move of every Snake on tick, tick 0 being the first tick stepped
+      void getMoves (const unsigned int tick, std::vector<Movement>& modify) const;
+
+      /// The seed of the setup is the seed of the recorded World
+      const SnakeStateSetup& getSetup() const { return m_setup; }
+      unsigned int getSeed() const            { return m_seed; }
+      unsigned int getTicks() const           { return m_ticks; }
+      unsigned int getSnakeAmount() const     { return m_snakes; }
+
+      /// The keyframes are in the order of their ticks, the hash is that of the World on the last tick
+      const std::vector<Keyframe>& getKeyframes() const { return m_keyframes; }
+      std::uint32_t getStateHash() const      { return m_hash; }
+
+      /// How many bytes of the data given to the constructor the replay took up
+      std::size_t getByteSize() const         { return m_byteSize; }
+
+   protected:
+
+   private:
+      /// Members
+      SnakeStateSetup m_setup;            /// The setup the match was played with
+      unsigned int m_seed;                /// The seed the match was played with
+      unsigned int m_ticks;               /// How many ticks were recorded
+      unsigned int m_snakes;              /// How many Snakes take part
+      std::vector<unsigned char> m_moves; /// The code of every move, four to a byte, tick by tick
+      std::vector<Keyframe> m_keyframes;  /// The World every so many ticks
+      std::uint32_t m_hash;               /// The state hash of the World on the last tick
+      std::size_t m_byteSize;             /// How long the recording is
+};
+
+#endif // REPLAY_H
@@ -0,0 +1,92 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef REPLAYPLAYER_H
+#define REPLAYPLAYER_H
+
+
+/// STL
+#include <memory>    // m_pReplay and m_keyframes
+#include <stdexcept> // Constructor
+#include <vector>    // m_keyframes
+
+
+/// Personal
+#include <simulation/replay.hpp> // m_pReplay
+#include <simulation/world.hpp>  // m_world
+
+
+/// ReplayPlayer plays a Replay back by stepping a World with the recorded moves. Seeking restores the nearest keyframe
+/// of the Replay at or before the target and steps forward from there, so no seek replays the match from the start.
+/// A keyframe is restored from its save the first time it's needed, a Snapshot of it is kept for every seek after.
+/// Whenever playback reaches a keyframe or the end the state hash of the World is compared with the recorded one, a
+/// mismatch means the rules no longer play the match the way they did when it was recorded.
+/// ReplayPlayer is a leaf class.
+class ReplayPlayer final
+{
+   public:
+      /// Constructors and destructor
+      /// The World must be new and created from the setup and seed of the Replay, it must outlive the player
+      ReplayPlayer (const std::shared_ptr<const Replay>& replay, World& world);
+
+      ReplayPlayer (ReplayPlayer&& move) = default;
+      ~ReplayPlayer() = default;
+
+      /// Explicitly disallow (Effective C++: Item 6)
+      ReplayPlayer (const ReplayPlayer& copy) = delete;
+      ReplayPlayer& operator= (const ReplayPlayer& copy) = delete;
+
+
+      /// Testing functions
+      bool isFinished() const { return m_world.getTick() >= m_pReplay->getTicks() || m_world.isGameOver(); }
+
+      /// Whether playback has ended early or reached a keyframe or end whose state hash doesn't match
+      bool hasDiverged() const { return m_diverged; }
+
+
+      /// Functionality
+      /// Plays the next tick, does nothing once the replay is finished
+      void step();
+
+      /// Moves the World to the given tick, a tick past the end of the replay moves it to the end
+      void seek (const unsigned int tick);
+
+
+      /// Getters
+      unsigned int getTick() const                          { return m_world.getTick(); }
+      const std::shared_ptr<const Replay>& getReplay() const { return m_pReplay; }
+
+   protected:
+
+   private:
+      /// Getters
+      /// How many keyframes of the Replay lie at or before tick, the keyframe to restore for it is one less than that
+      unsigned int countKeyframes (const unsigned int tick) const;
+
+
+      /// Members
+      std::shared_ptr<const Replay> m_pReplay;                    /// The replay being played
+      World& m_world;                                             /// The World being stepped
+      std::vector<std::unique_ptr<World::Snapshot>> m_keyframes;  /// The start then every keyframe, nullptr until used
+      std::vector<Movement> m_moves;                              /// The moves of the tick being played, reused
+      bool m_diverged;                                            /// Whether a state hash hasn't matched
+};
+
+#endif // REPLAYPLAYER_H
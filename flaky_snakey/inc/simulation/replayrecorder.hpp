@@ -0,0 +1,133 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef REPLAYRECORDER_H
+#define REPLAYRECORDER_H
+
+
+/// STL
+#include <cstdint> // The file format
+#include <string>  // m_kAI
+#include <vector>  // m_data and m_previous
+
+
+/// Personal
+#include <misc/backgroundwriter.hpp>  // write()
+#include <setup/snakestatesetup.hpp>  // Constructor
+#include <simulation/world.hpp>       // record(), save() and write()
+
+
+/// ReplayRecorder records a match as the seed and setup of its World plus the move of every Snake on every tick, which
+/// is everything needed to play the match again exactly. A move takes two bits and the moves of every Snake are
+/// recorded every tick, dead or alive, so the stream can be read without simulating it. Each move is stored as the
+/// exclusive or of its code and the previous move of the same Snake, a Snake going straight then costs a zero and with
+/// run-length encoding a byte of zeros, which is four straight moves, collapses into a count. Every so often the World
+/// is stored as a SaveGame so playback can seek to any tick without starting from the first. A save only holds the
+/// Snakes, Food, Obstacles and random engines, so a keyframe grows with them rather than the level, and the next one is
+/// put off a tick for every kKeyframeBytes of the last so very long Snakes can't make keyframes the bulk of recording.
+/// Each keyframe and the end of the replay hold World::getStateHash() so playback can tell when it has diverged.
+///
+/// A replay is laid out as follows, every number is a little-endian 32-bit unsigned integer:
+///   "FSRP", version, flags (bit 0: run-length encoded), seed,
+///   resolution x, resolution y, grid width, grid height, humans, AI, food min, food max, score per food,
+///   snake update interval, food rot interval, ticks, data size, AI name length, keyframes, AI name, data,
+///   every keyframe as tick, state hash, save size, save, then the state hash of the last tick.
+/// The data is the move stream packed four moves per byte starting from the low bits. When run-length encoded a zero
+/// byte is always followed by a count, 0 to 255, of how many more zero bytes it stands for. Each save is a SaveGame
+/// and keeps its own byte order.
+///
+/// Recording is done in memory and costs a few operations per Snake per tick plus a save every keyframe, the file is
+/// only written by write() once the match is over so the disk never holds up a tick.
+/// ReplayRecorder is a leaf class.
+class ReplayRecorder final
+{
+   public:
+      /// The first four bytes of every replay
+      static const char kMagic[4];
+
+      /// Increased whenever the layout changes
+      static const std::uint32_t kVersion = 3;
+
+      /// Set in the flags of the header when the data is run-length encoded
+      static const std::uint32_t kRunLength = 1;
+
+      /// How many ticks apart the keyframes are at least
+      static const unsigned int kKeyframeInterval = 256;
+
+      /// The next keyframe is put off a tick for every this many bytes of the last, once they outweigh the interval
+      static const unsigned int kKeyframeBytes = 256;
+
+
+      /// Constructors and destructor
+      /// The setup and seed must be those given to the World being recorded
+      ReplayRecorder (const SnakeStateSetup& setup, const unsigned int seed, const bool runLength = true);
+
+      ReplayRecorder (const ReplayRecorder& copy) = default;
+      ReplayRecorder (ReplayRecorder&& move) = default;
+      ReplayRecorder& operator= (const ReplayRecorder& copy) = default;
+      ~ReplayRecorder() = default;
+
+
+      /// Functionality
+      /// Records the tick the World has just stepped, call once after every World::step()
+      void record (const World& world);
+
+      /// Fills modify with the complete replay ending at the tick world is on, recording can continue afterwards
+      void save (const World& world, std::vector<unsigned char>& modify) const;
+
+      /// Hands the complete replay to writer in a single write so replays from many threads never interleave
+      void write (const World& world, BackgroundWriter& writer) const;
+
+
+      /// Getters
+      unsigned int getTicks() const { return m_ticks; }
+
+   protected:
+
+   private:
+      /// Functionality
+      void addMove (const unsigned int bits); /// Packs two bits into m_byte, storing it once it's full
+      void addByte (const unsigned char byte); /// Stores a whole byte, holding zeros back when run-length encoding
+
+      /// Appends a run of zero bytes to modify
+      static void addZeros (std::vector<unsigned char>& modify, unsigned int zeros);
+
+      /// Appends a number to modify in the byte order of the file
+      static void addNumber (std::vector<unsigned char>& modify, const std::uint32_t value);
+
+
+      /// Members
+      const SnakeStateSetup m_kSetup;         /// Written to the header
+      const unsigned int m_kSeed;             /// Written to the header
+      const bool m_kRunLength;                /// Whether zero bytes are run-length encoded
+
+      std::vector<unsigned char> m_previous;  /// The code of the previous move of each Snake
+      std::vector<unsigned char> m_data;      /// Every complete byte of the stream
+      std::vector<unsigned char> m_keyframes; /// Every keyframe as it is laid out in the file
+      std::vector<unsigned char> m_save;      /// The save of the latest keyframe, reused every keyframe
+      unsigned int m_keyframeCount;           /// How many keyframes m_keyframes holds
+      unsigned int m_nextKeyframe;            /// The tick the next keyframe is taken on
+      unsigned char m_byte;                   /// The byte being packed
+      unsigned int m_bits;                    /// How many bits of m_byte are used
+      unsigned int m_zeros;                   /// How many zero bytes are being held back
+      unsigned int m_ticks;                   /// How many ticks have been recorded
+};
+
+#endif // REPLAYRECORDER_H
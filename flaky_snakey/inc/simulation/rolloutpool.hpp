@@ -0,0 +1,114 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ROLLOUTPOOL_H
+#define ROLLOUTPOOL_H
+
+
+/// STL
+#include <chrono>             // The deadlines
+#include <condition_variable> // m_start and m_done
+#include <functional>         // run()
+#include <mutex>              // m_mutex
+#include <thread>             // m_threads
+#include <vector>             // m_worlds and m_idle
+
+
+/// Personal
+#include <setup/snakestatesetup.hpp> // Constructor
+#include <simulation/world.hpp>      // m_worlds and m_root
+
+
+/// RolloutPool lets an AI play the game ahead on as many threads as the setup asks for. Each thread owns a World of
+/// its own which is restored from the root, a Snapshot of the game taken as the tick begins, and stepped however the
+/// AI likes; the Worlds never ask their controllers for a move so the AI decides everything itself. Half of the update
+/// interval of the setup is given to the AI each tick, so a shorter interval means a quicker AI, and that has to be
+/// shared between every Snake still to move. The caller waits while the threads play, so the ticks they step are
+/// never mistaken for its own.
+/// RolloutPool is a leaf class.
+class RolloutPool final
+{
+   public:
+      /// Called repeatedly by every thread until the deadline, the World is the one owned by the worker of that index
+      using Rollout = std::function<void (World& world, const unsigned int worker)>;
+
+
+      /// Constructors and destructor
+      /// 0 threads uses every hardware thread
+      RolloutPool (const SnakeStateSetup& setup, const unsigned int threads = 0);
+
+      /// Waits for every thread to finish
+      ~RolloutPool();
+
+      /// Explicitly disallow (Effective C++: Item 6)
+      RolloutPool (const RolloutPool& copy) = delete;
+      RolloutPool& operator= (const RolloutPool& copy) = delete;
+
+
+      /// Functionality
+      /// Has every thread call rollout until the deadline has passed, each at least once, and waits for them
+      void run (const Rollout& rollout, const std::chrono::steady_clock::time_point deadline);
+
+
+      /// Assignment functions
+      /// Saves the World as the root of every rollout and starts the budget of the tick, call before any Snake moves
+      void setRoot (const World& world);
+
+
+      /// Getters
+      unsigned int getWorkers() const                                  { return m_worlds.size(); }
+      unsigned int getRootTick() const                                 { return m_rootTick; }
+      const World::Snapshot& getRoot() const                           { return m_root; }
+      std::chrono::steady_clock::time_point getTickDeadline() const    { return m_tickDeadline; }
+
+   protected:
+
+   private:
+      /// How much of the update interval the AI may spend each tick, the rest is left for the game itself
+      static const unsigned int kBudgetPercent = 50;
+
+
+      /// Functionality
+      void work (const unsigned int worker); /// The body of each thread
+      void play (const unsigned int worker); /// Calls the rollout until the deadline
+
+
+      /// Members
+      const std::chrono::microseconds m_kBudget;             /// How long the AI may think each tick
+
+      std::vector<World> m_worlds;                           /// The World of each thread
+      std::vector<World::Snapshot> m_idle;                   /// Each World as it was created, restored once it's done
+      World::Snapshot m_root;                                /// The game as the current tick began
+      unsigned int m_rootTick;                               /// The tick the root was saved on
+      std::chrono::steady_clock::time_point m_tickDeadline;  /// When the budget of the current tick runs out
+
+      const Rollout* m_pRollout;                             /// What the threads are currently running
+      std::chrono::steady_clock::time_point m_deadline;      /// When the threads should stop running it
+
+      std::mutex m_mutex;                                    /// Guards the members used to start and finish a run
+      std::condition_variable m_start;                       /// Wakes the threads when a run starts or the pool closes
+      std::condition_variable m_done;                        /// Wakes run() when every thread has finished
+      unsigned int m_generation;                             /// Counts the runs so a thread never repeats one
+      unsigned int m_busy;                                   /// How many threads are still running
+      bool m_closing;                                        /// Whether the threads should stop
+
+      std::vector<std::thread> m_threads;                    /// Started last so every other member is ready
+};
+
+#endif // ROLLOUTPOOL_H
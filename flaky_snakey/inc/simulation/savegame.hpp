@@ -0,0 +1,224 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SAVEGAME_H
+#define SAVEGAME_H
+
+
+/// STL
+#include <cstddef>   // std::size_t
+#include <cstdint>   // The file format
+#include <stdexcept> // Constructor
+#include <string>    // Constructor and write()
+#include <vector>    // write() and m_buffer
+
+
+/// Personal
+#include <setup/snakestatesetup.hpp> // getSetup()
+#include <simulation/world.hpp>      // write() and restore()
+
+
+/// SaveGame is the complete state of a game between two ticks stored in a single block of memory with a fixed layout,
+/// so a save can be mapped straight from disk and read where it lies. Every number is a fixed width integer in the
+/// byte order of the machine that saved, so it is never converted, and every record is a fixed size; the header says
+/// where each section of records starts and how many it holds. Opening a save only checks that each section lies inside
+/// the file, nothing is decoded, so a large batch of saves can be opened and inspected for almost nothing. restore()
+/// checks every record against the others and copies the state into a World, after which the game plays out exactly
+/// as it would have if it had never been saved.
+///
+/// The layout is:
+///   Header
+///   SnakeRecord    per Snake, by index
+///   CellRecord     per Snake its head, any part kJump leads to and then any flakes it hasn't dropped yet
+///   std::uint8_t   per body part after each head, the Movement from the part before it, Null if they share a cell
+///   std::uint32_t  the index of every living Snake, then the sorted cell key and index of every dead head
+///   FoodRecord     per Food, in the order FoodManager keeps them
+///   std::uint32_t  where each food handle is in the food records, then every free handle
+///   ObstacleRecord per Obstacle
+/// The level itself isn't stored, it is rebuilt from the Snake parts, Food and Obstacles on restore() so a save only
+/// grows with what is in the level. The parts of a Snake almost always touch so most cost a byte rather than a cell.
+/// SaveGame is a leaf class.
+class SaveGame final
+{
+   public:
+      /// The first four bytes of every save
+      static const char kMagic[4];
+
+      /// Increased whenever the layout changes, a save of any other version is refused
+      static const std::uint32_t kVersion = 2;
+
+      /// Written in the byte order of the machine that saved, a save from a machine with another order is refused
+      static const std::uint32_t kByteOrder = 0x01020304;
+
+      /// The longest AI name a save can hold, including the terminating zero
+      static const unsigned int kAILength = 16;
+
+      /// The rot ticks of Food which never rots
+      static const std::uint32_t kNeverRots = 0xFFFFFFFF;
+
+      /// The move of a body part which doesn't touch the part before it, its cell is the next CellRecord instead
+      static const std::uint8_t kJump = 5;
+
+
+      /// Where a section starts, in bytes from the start of the save, and how many entries it holds
+      struct Section final
+      {
+         std::uint32_t offset;
+         std::uint32_t count;
+      };
+
+      struct Header final
+      {
+         char magic[4];
+         std::uint32_t version, byteOrder, size;
+
+         /// The setup, the resolution is only recorded
+         std::uint32_t resX, resY, gridWidth, gridHeight, humans, ai, foodMin, foodMax, scoreFood, snakeInterval,
+                       rotInterval;
+         char snakeAI[kAILength];
+
+         /// The World
+         std::uint32_t seed, tick, spawnAvailable, spawnRequired, freeCells;
+         std::uint32_t random[4], aiRandom[4];
+
+         Section snakes, parts, moves, living, deadIndex, food, foodSlots, freeHandles, obstacles;
+      };
+
+      struct SnakeRecord final
+      {
+         std::uint32_t firstPart;   /// Where the head is in the parts section
+         std::uint32_t firstMove;   /// Where the part after the head is in the moves section
+         std::uint32_t size;        /// How many body parts there are
+         std::uint32_t flakes;      /// How many flakes follow the head and jumps
+         std::uint32_t score;
+         std::uint16_t lastEndX, lastEndY;
+         std::uint8_t alive, passThrough, canRollBack, lastMove;
+      };
+
+      struct CellRecord final
+      {
+         std::uint16_t x, y;
+      };
+
+      struct DeadRecord final
+      {
+         std::uint32_t key, snake;
+      };
+
+      /// Positive effects are FatFood and negative effects are ThinFood
+      struct FoodRecord final
+      {
+         std::uint16_t x, y;
+         std::int32_t effect;
+         std::uint32_t handle;
+         std::uint32_t rotTicks;    /// How many more ticks the Food lasts, kNeverRots if it doesn't rot
+      };
+
+      struct ObstacleRecord final
+      {
+         std::uint16_t x, y;
+         std::uint8_t red, green, blue, alpha;
+      };
+
+
+      /// Constructors and destructor
+      /// Reads a save held in memory, data must be 4-byte aligned and outlive the SaveGame. Throws if data isn't a
+      /// complete save of this version
+      SaveGame (const unsigned char* data, const std::size_t size);
+
+      /// Maps the file into memory where the platform allows it, otherwise it's read in whole
+      SaveGame (const std::string& path);
+
+      ~SaveGame();
+
+      /// Explicitly disallow (Effective C++: Item 6)
+      SaveGame (SaveGame&& move) = delete;
+      SaveGame (const SaveGame& copy) = delete;
+      SaveGame& operator= (const SaveGame& copy) = delete;
+
+
+      /// Functionality
+      /// Fills modify with a save of the World, setup must be the one the World was created with
+      static void write (const SnakeStateSetup& setup, const World& world, std::vector<unsigned char>& modify);
+
+      /// The same but writes straight to the file at path, throws if it can't
+      static void write (const SnakeStateSetup& setup, const World& world, const std::string& path);
+
+      /// Copies the state into a World created from getSetup() and getSeed(), throws if the save doesn't fit it
+      void restore (World& world) const;
+
+
+      /// Getters
+      /// The setup the game was created with
+      SnakeStateSetup getSetup() const;
+
+      const Header& getHeader() const                 { return *m_pHeader; }
+      unsigned int getSeed() const                    { return m_pHeader->seed; }
+      unsigned int getTick() const                    { return m_pHeader->tick; }
+
+      const SnakeRecord* getSnakes() const            { return getSection<SnakeRecord> (m_pHeader->snakes); }
+      const CellRecord* getParts() const              { return getSection<CellRecord> (m_pHeader->parts); }
+      const std::uint8_t* getMoves() const            { return getSection<std::uint8_t> (m_pHeader->moves); }
+      const FoodRecord* getFood() const               { return getSection<FoodRecord> (m_pHeader->food); }
+      const ObstacleRecord* getObstacles() const      { return getSection<ObstacleRecord> (m_pHeader->obstacles); }
+
+   protected:
+
+   private:
+      /// Testing functions
+      bool isInside (const unsigned int x, const unsigned int y) const; /// Whether the cell is inside the level
+
+
+      /// Functionality
+      void validate() const; /// Throws unless every section lies inside the save
+      void unmap();          /// Releases the file mapping, if there is one
+
+      /// Each fills part of the Snapshot restore() builds, throwing if the records don't make sense
+      void restoreSnakes (SnakeManager::Snapshot& modify) const;
+      void restoreFood (const FoodManager& foodManager, FoodManager::Snapshot& modify) const;
+      void restoreObstacles (ObstacleManager::Snapshot& modify) const;
+      /// Rebuilds the grid from the Snakes, Food and Obstacles already restored into modify
+      void restoreGrid (const OccupancyGrid& grid, World::Snapshot& modify) const;
+
+      static void refuse(); /// Throws, called whenever a record doesn't make sense
+
+      /// The move from one part to the next as stored in the moves section, kJump if they don't touch
+      static std::uint8_t getMove (const Header& header, const Cell& from, const Cell& to);
+
+      /// Moves modify by a stored move other than kJump, wrapping at the edges of the level
+      void applyMove (Cell& modify, const std::uint8_t move) const;
+
+
+      /// Getters
+      template <typename T> const T* getSection (const Section& section) const
+      {
+         return reinterpret_cast<const T*> (m_pData + section.offset);
+      }
+
+
+      /// Members
+      const unsigned char* m_pData;         /// The start of the save
+      std::size_t m_size;                   /// How many bytes m_pData points to
+      const Header* m_pHeader;              /// The header at the start of m_pData
+      void* m_pMapping;                     /// The mapping of the file, nullptr if the save wasn't mapped
+      std::vector<unsigned char> m_buffer;  /// Holds the file when it can't be mapped
+};
+
+#endif // SAVEGAME_H
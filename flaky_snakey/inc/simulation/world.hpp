@@ -0,0 +1,168 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef WORLD_H
+#define WORLD_H
+
+
+/// STL
+#include <cstdint> // recordAllocations() and getStateHash()
+#include <memory>  // std::shared_ptr
+#include <vector>  // m_flakes
+
+
+/// Personal
+#include <food/distancefield.hpp>        // m_pFoodField and m_pFatFoodField
+#include <food/foodmanager.hpp>          // m_pFoodManager
+#include <misc/occupancygrid.hpp>        // m_pGrid
+#include <misc/random.hpp>               // m_pRandom
+#include <obstacles/obstaclemanager.hpp> // m_pObstacleManager
+#include <setup/snakestatesetup.hpp>     // Constructor
+#include <snakes/dangermap.hpp>          // m_pDangerMap
+#include <snakes/snakemanager.hpp>       // m_pSnakeManager
+
+
+/// Forward declarations
+class RolloutPool;
+
+
+/// World is the simulation core of the game, it owns every manager and advances the game by exactly one fixed tick each
+/// time step() is called. It knows nothing of timers, states or the canvas; the interactive states step it from a
+/// prg::Timer and draw the managers it exposes. A World owns all of its state, random engines included, so Worlds can
+/// be stepped on separate threads and saved into a Snapshot to be restored any number of times. The rules and the AI
+/// draw from separate engines, so a game is fully described by its seed and the move of every Snake on every tick.
+/// World is a leaf class.
+class World final
+{
+   public:
+      /// Everything that changes during a game. Only the chunks of the level and the Food objects are shared with the
+      /// World rather than copied and neither is ever written to, so restoring costs about as much as the snakes,
+      /// food and obstacles in play. A Snapshot can be restored into any World created from the same setup.
+      class Snapshot final
+      {
+         friend class World;
+         friend class SaveGame;
+
+         OccupancyGrid::Snapshot m_grid {};            /// What is in each cell
+         FoodManager::Snapshot m_food {};              /// Every Food object
+         ObstacleManager::Snapshot m_obstacles {};     /// Every Obstacle object
+         SnakeManager::Snapshot m_snakes {};           /// Every Snake
+         Random m_random {};                           /// The state of the random engine
+         Random m_aiRandom {};                         /// The state of the random engine of the AI
+         unsigned int m_tick {0};                      /// How many ticks had been stepped
+         bool m_spawnAvailable {true};                 /// Whether food could still be spawned
+      };
+
+
+      /// Constructors and destructor
+      /// The same seed and setup always play the same game. The UI is optional, a headless World is given nullptr
+      World (const SnakeStateSetup& setup, const unsigned int seed,
+             const std::shared_ptr<SnakeInterface>& ui = nullptr);
+
+      World (World&& move) = default;
+      ~World() = default;
+
+      /// Explicitly disallow (Effective C++: Item 6)
+      World (const World& copy) = delete;
+      World& operator= (const World& copy) = delete;
+
+
+      /// Testing functions
+      bool isGameOver() const { return m_pSnakeManager->isGameOver(); }
+
+
+      /// Functionality
+      void resume(); /// Allows human players to steer, call when the game becomes visible
+      void pause();  /// Stops human players from steering
+      void step();   /// Advances the game by one tick, does nothing once the game is over
+
+      /// The same but each Snake makes the move of its index instead of asking its Controller, which is how a replay is
+      /// played back. Only the rules draw from the random engine so the game plays out as it did when recorded
+      void step (const std::vector<Movement>& moves);
+
+      /// Saving into the same Snapshot again reuses its memory. Restoring doesn't update the UI
+      void save (Snapshot& modify) const;
+      void restore (const Snapshot& snapshot);
+
+
+      /// Assignment functions
+      /// Replaces the random engine of the rules, a World playing ahead is reseeded so it can't foresee the game
+      void reseed (const unsigned int seed);
+
+      /// Ticks played ahead by the AI aren't ticks of the game, a World stepping them doesn't record its allocations
+      void setAllocationsRecorded (const bool recorded) { m_allocationsRecorded = recorded; }
+
+
+      /// Getters
+      unsigned int getSeed() const                                      { return m_kSeed; }
+      unsigned int getTick() const                                      { return m_tick; }
+      unsigned int getWinnerIndex() const                               { return m_pSnakeManager->getWinnerIndex(); }
+      const std::shared_ptr<OccupancyGrid>& getGrid() const             { return m_pGrid; }
+      const std::shared_ptr<FoodManager>& getFoodManager() const        { return m_pFoodManager; }
+      const std::shared_ptr<ObstacleManager>& getObstacleManager() const { return m_pObstacleManager; }
+      const std::shared_ptr<SnakeManager>& getSnakeManager() const      { return m_pSnakeManager; }
+
+      /// A hash of the tick, the contents of the level, every Snake and the random engine of the rules. The grid keeps
+      /// its part up to date so the hash costs the same on any level. Two Worlds playing the same game have the same
+      /// hash on the same tick, a replay records it to tell when playback diverges
+      std::uint32_t getStateHash() const;
+
+   protected:
+
+   private:
+      /// Ticks before this have containers growing to fit the game so their allocations aren't recorded
+      static const unsigned int kWarmUpTicks = 256;
+
+
+      /// Functionality
+      void resolveTick();                       /// Everything step() does once the Snakes have moved
+      void invalidateSearches();                /// The fields and the map no longer match the game
+      void spawnFood();                         /// Adds Food if FoodManager needs it and there is room
+      void updateCollisions();                  /// Check all cross-Manager collisions
+      void processFlakes();                     /// Extract flakes and convert into Obstacle objects
+      bool findSpawnPoint (Cell& modify) const; /// Fills modify with a free cell, false if the board is full
+
+      /// Hands the allocations made by the tick to the Profiler, allocations is the count from before the tick
+      void recordAllocations (const std::uint64_t allocations) const;
+
+
+      /// Members
+      const unsigned int m_kSeed;                           /// The seed the World was created with
+      unsigned int m_scoreFood;                             /// The score achieved by eating some food
+      std::shared_ptr<Random> m_pRandom;                    /// Every random decision of the rules comes from here
+      std::shared_ptr<Random> m_pAIRandom;                  /// Every random decision of the AI comes from here
+      std::shared_ptr<OccupancyGrid> m_pGrid;               /// Shared by every manager to record what is in each cell
+      std::shared_ptr<FoodManager> m_pFoodManager;          /// Manages all Food objects
+      std::shared_ptr<ObstacleManager> m_pObstacleManager;  /// Manages all Obstacle objects
+      std::shared_ptr<SnakeManager> m_pSnakeManager;        /// Manages all Snake objects
+      std::shared_ptr<DistanceField> m_pFoodField;          /// Leads every AI Snake to the nearest food
+      std::shared_ptr<DistanceField> m_pFatFoodField;       /// Leads every AI Snake to the nearest FatFood
+      std::shared_ptr<DangerMap> m_pDangerMap;              /// Says when every Snake part will have moved away
+      std::shared_ptr<RolloutPool> m_pRollouts;             /// Plays ahead for MCTS AI Snakes, nullptr otherwise
+      std::vector<Cell> m_flakes;                           /// Every flake made during the current tick
+      unsigned int m_tick;                                  /// How many ticks have been stepped
+      bool m_allocationsRecorded;                           /// Whether recordAllocations() records anything
+
+      /// Is a spawn available for FoodManager? This is merely to avoid an infinite loop if all cells are occupied
+      bool m_spawnAvailable;
+};
+
+#endif // WORLD_H
@@ -0,0 +1,97 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef DANGERMAP_H
+#define DANGERMAP_H
+
+
+/// STL
+#include <limits>    // kNever
+#include <memory>    // m_pkSnakeManager
+
+
+/// Personal
+#include <misc/searchbuffers.hpp>   // m_search
+
+
+/// Forward declarations
+class SnakeManager;
+
+
+/// DangerMap knows when the parts of every living Snake will have moved out of the way. Each move takes a part off the
+/// tail so a part k parts from the tail is gone once its Snake has made k + 1 more moves, which lets a search cross a
+/// Snake wherever its body will have cleared by the time the search gets there. The World invalidates the map every
+/// tick and the first AI to need it refreshes it. Only the parts within kHorizon moves of leaving are recorded, any
+/// other Snake part, including every part of a dead Snake, never clears. A Snake which eats keeps its parts for longer
+/// than the map expects, AI Snakes decide again every tick so the mistake is only a problem once they're committed.
+/// DangerMap is a leaf class.
+class DangerMap final
+{
+   public:
+      /// The first safe move of a cell which never clears
+      static const unsigned int kNever = std::numeric_limits<unsigned int>::max();
+
+
+      /// Constructors and destructor
+      DangerMap (const InGameSetup& setup, const std::shared_ptr<const SnakeManager>& snakeManager);
+
+      DangerMap (DangerMap&& move) = default;
+      ~DangerMap() = default;
+
+      /// Explicitly disallow (Effective C++: Item 6)
+      DangerMap (const DangerMap& copy) = delete;
+      DangerMap& operator= (const DangerMap& copy) = delete;
+
+
+      /// Functionality
+      /// Records every living Snake again if the map has been invalidated since the last time. Snakes move in order of
+      /// their player number so every Snake before the deciding one has already moved this tick
+      void refresh (const unsigned int deciding);
+
+
+      /// Assignment functions
+      void invalidate() { m_valid = false; }
+
+
+      /// Getters
+      /// Only meaningful after refresh(). Counting the move the deciding Snake is about to make as the first, the Snake
+      /// parts in the cell are gone by the move returned. kNever if the cell holds no recorded part
+      unsigned int getFirstSafeMove (const Cell& cell) const
+      {
+         const unsigned int index = m_search.getIndex (cell);
+
+         return m_search.isVisited (index) ? m_search.getDistance (index) : kNever;
+      }
+
+   protected:
+
+   private:
+      /// Parts which need more moves than this to clear aren't recorded, no search plans that far ahead
+      static const unsigned int kHorizon = 1024;
+
+
+      /// Members
+      std::weak_ptr<const SnakeManager> m_pkSnakeManager;  /// Provides every living Snake
+      SearchBuffers m_search;                              /// Holds the first safe move of every recorded cell
+      bool m_valid;                                        /// Whether the map is up to date
+};
+
+#endif // DANGERMAP_H
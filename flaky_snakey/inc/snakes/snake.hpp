@@ -23,9 +23,8 @@
 
 
 /// STL
-#include <list>      // m_partsP
-#include <memory>    // m_partsP and m_flakesP
-#include <vector>    // m_flakesP
+#include <memory>    // m_pController and m_pGrid
+#include <vector>    // m_flakes
 
 
 /// Third party
@@ -34,10 +33,14 @@
 
 /// Personal
 #include <interfaces/idrawable.hpp>    // Parent
+#include <misc/cell.hpp>               // m_flakes, m_lastEnd and getHead()
 #include <misc/movement.hpp>           // m_lastMove
-#include <misc/rectangle.hpp>          // m_partsP and m_flakesP
+#include <misc/occupancygrid.hpp>      // m_pGrid
+#include <misc/rectangle.hpp>          // drawHead() and drawBody()
+#include <misc/snakespawn.hpp>         // Constructor
 #include <misc/snakeutilities.hpp>     // moveSnake()
 #include <setup/ingamesetup.hpp>       // m_kSetup
+#include <snakes/snakebody.hpp>        // m_body
 
 
 /// Forward declarations
@@ -50,8 +53,27 @@ class Controller;
 class Snake final : public IDrawable
 {
    public:
+      /// Everything about a Snake that changes during a game. The cells it occupies are recorded in the OccupancyGrid
+      /// so restoring a Snake must be paired with restoring the grid it was saved alongside
+      class Snapshot final
+      {
+         friend class Snake;
+         friend class SaveGame;
+
+         SnakeBody m_body {};                       /// Every part of the Snake, head first
+         std::vector<Cell> m_flakes {};             /// Flakes which hadn't been extracted yet
+         Cell m_lastEnd {};                         /// The cell the tail left during the last move
+         bool m_canRollBack {false};                /// Whether m_lastEnd was still valid
+         bool m_alive {true};                       /// Whether the Snake was alive
+         bool m_passThrough {false};                /// Whether the Snake could pass through other snakes
+         unsigned int m_score {0};                  /// The score the Snake had
+         Movement m_lastMove {Movement::Null};      /// The last movement the Snake made
+      };
+
+
       /// Constructors and destructor
-      Snake (const InGameSetup& setup, const unsigned int playerNumber, const std::string& name = {""});
+      Snake (const InGameSetup& setup, const std::shared_ptr<OccupancyGrid>& grid, const unsigned int playerNumber,
+             const SnakeSpawn& spawn, const std::string& name = {""});
 
       Snake (Snake&& move) = default;
       ~Snake() = default;
@@ -61,24 +83,25 @@ class Snake final : public IDrawable
       Snake& operator= (const Snake& copy) = delete;
 
       /// Testing functions
-      bool intersects (const Rectangle& rect) const;
-      bool intersectsBody (const Rectangle& rect) const;
+      bool intersectsBody (const Cell& cell) const;
 
       bool isAlive() const { return m_alive; }
-      bool isFlakey() const { return !m_flakesP.empty(); }
+      bool isFlakey() const { return !m_flakes.empty(); }
       bool canPassThrough() const { return m_passThrough; }
+      bool canRollBack() const { return m_canRollBack; }
 
 
       /// Functionality
       void draw (prg::Canvas& canvas) override;
       void moveSnake();
+      void moveSnake (Movement currentMove); /// Moves without asking the Controller
       void checkSelfCollision(); /// Check if the head collides with the body
 
       /// Increase or decrease the size of the Snake
       void alterSnakeSize (const int foodEffect);
 
-      /// std::move() each Rectangle from m_flakesP to modify
-      void extractFlakes (std::vector<std::unique_ptr<Rectangle>>& modify);
+      /// Appends each cell from m_flakes to modify
+      void extractFlakes (std::vector<Cell>& modify);
 
 
       /// Assignment functions
@@ -91,23 +114,25 @@ class Snake final : public IDrawable
       void setName (const std::string& name) { m_name = name; }
       void setPassThrough (const bool passThrough) { m_passThrough = passThrough; }
 
+      /// killSnake() undoes a single move, these go back to any earlier point. Both reuse the memory of the Snapshot
+      void save (Snapshot& modify) const;
+      void restore (const Snapshot& snapshot);
+
 
       /// Getters
-      const Rectangle& getHead () const;
+      const Cell& getHead () const;
+      const Cell& getRollBackHead() const; /// Where the head ends up if killSnake() rolls back movement
 
       const std::string& getName() const { return m_name; }
       unsigned int getPlayerNumber() const { return m_kPlayerNumber; }
       unsigned int getScore() const { return m_score; }
-      unsigned int getSize() const { return m_partsP.size(); }
+      unsigned int getSize() const { return m_body.getSize(); }
+      const SnakeBody& getBody() const { return m_body; }
       Movement getLastMove() const { return m_lastMove; }
 
    protected:
 
    private:
-      /// Core requirements
-      void generateSpawn();   /// Generate spawn point based on m_playerNumber
-
-
       /// Testing functions
       bool isValidMove (Movement move) const;   /// Checks if it's a valid move
 
@@ -116,14 +141,16 @@ class Snake final : public IDrawable
       void drawHead (prg::Canvas& canvas, const Rectangle& head);  /// Draws the living or dead image of the head
       void drawBody (prg::Canvas& canvas, const Rectangle& body);  /// Draws the living or dead image of the body
       void growSnake (const int foodEffect);    /// Grows the Snake by foodEffect, can't kill the Snake
-      bool flakeSnake (const int foodEffect);   /// Flakes the snake by foodEffect, returns m_partsP.size() > foodEffect
+      bool flakeSnake (const int foodEffect);   /// Flakes the snake by foodEffect, returns m_body.getSize() > foodEffect
 
 
       /// Members
-      std::list<std::unique_ptr<Rectangle>> m_partsP;    /// Stores all drawable and collidable body parts
-      std::vector<std::unique_ptr<Rectangle>> m_flakesP; /// Stores all flaked off pieces, ready for extraction
-      std::unique_ptr<Rectangle> m_lastEnd;              /// Keeps the previous end element to facilitate rolling back
-      std::weak_ptr<Controller> m_pController;           /// If available, allows the use of a Controller for input
+      SnakeBody m_body;                         /// Stores all drawable and collidable body parts, head first
+      std::vector<Cell> m_flakes;               /// Stores all flaked off pieces, ready for extraction
+      Cell m_lastEnd;                           /// Keeps the previous end element to facilitate rolling back
+      bool m_canRollBack;                       /// Whether m_lastEnd is still valid
+      std::weak_ptr<Controller> m_pController;  /// If available, allows the use of a Controller for input
+      std::shared_ptr<OccupancyGrid> m_pGrid;   /// Every part added or removed is recorded in the grid
 
       const InGameSetup m_kSetup;         /// Contains all game data necessary for the Snake to function
       const unsigned int m_kPlayerNumber; /// Keeps track of which player the Snake represents
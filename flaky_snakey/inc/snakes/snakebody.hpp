@@ -0,0 +1,85 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SNAKEBODY_H
+#define SNAKEBODY_H
+
+
+/// STL
+#include <vector> // m_cells
+
+
+/// Personal
+#include <misc/cell.hpp> // m_cells
+
+
+/// SnakeBody is a ring buffer of cells ordered from head to tail. Moving a Snake only ever touches both ends so it
+/// never needs to allocate, the buffer simply doubles in capacity whenever the Snake outgrows it.
+/// SnakeBody is a leaf class.
+class SnakeBody final
+{
+   public:
+      /// Constructors and destructor
+      SnakeBody();
+
+      SnakeBody (const SnakeBody& copy) = default;
+      SnakeBody (SnakeBody&& move) = default;
+      SnakeBody& operator= (const SnakeBody& copy) = default;
+      ~SnakeBody() = default;
+
+
+      /// Testing functions
+      bool isEmpty() const { return m_size == 0; }
+
+
+      /// Assignment functions
+      void pushHead (const Cell& cell);
+      void pushTail (const Cell& cell);
+
+      /// Both return the removed cell, the body must not be empty
+      Cell popHead();
+      Cell popTail();
+
+      void clear() { m_head = 0; m_size = 0; }
+
+
+      /// Getters
+      /// Index 0 is the head and getSize() - 1 is the tail
+      const Cell& operator[] (const unsigned int index) const { return m_cells[(m_head + index) & m_mask]; }
+
+      const Cell& getHead() const { return m_cells[m_head]; }
+      const Cell& getTail() const { return m_cells[(m_head + m_size - 1) & m_mask]; }
+      unsigned int getSize() const { return m_size; }
+
+   protected:
+
+   private:
+      /// Functionality
+      void grow(); /// Doubles the capacity whilst keeping the head at index 0
+
+
+      /// Members
+      std::vector<Cell> m_cells; /// The buffer itself, its size is always a power of two
+      unsigned int m_head;       /// Where the head currently lives in m_cells
+      unsigned int m_size;       /// How many cells are in use
+      unsigned int m_mask;       /// m_cells.size() - 1, used to wrap indices
+};
+
+#endif // SNAKEBODY_H
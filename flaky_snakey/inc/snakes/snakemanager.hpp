@@ -22,15 +22,18 @@
 #define SNAKEMANAGER_H
 
 
-/// Third party
-#include <prg/interactive/app_state.hpp>  // Parent
-#include <prg/interactive/timer.hpp>      // m_timer
+/// STL
+#include <algorithm> // update()
+#include <utility>   // m_headIndex and m_candidates
+#include <vector>    // m_headIndex and m_candidates
 
 
 /// Personal
-#include <controllers/dumbaicontroller.hpp>  // m_aiP
-#include <controllers/playercontroller.hpp>  // m_playersP
-#include <controllers/smartaicontroller.hpp> // m_aiP
+#include <controllers/dumbaicontroller.hpp>        // m_aiP
+#include <controllers/mctsaicontroller.hpp>        // m_aiP
+#include <controllers/pathfindingaicontroller.hpp> // m_aiP
+#include <controllers/playercontroller.hpp>        // m_playersP
+#include <controllers/smartaicontroller.hpp>       // m_aiP
 #include <snakes/snake.hpp>                  // m_snakesP
 #include <ui/snakeinterface.hpp>             // m_pUI
 
@@ -43,12 +46,25 @@ class ObstacleManager;
 /// SnakeManager is completely in charge of any and all interactions between Snakes and external sources. SnakeManager also
 /// takes charge of Controller classes so that they are appropriately assigned to the correct Snakes.
 /// SnakeManager is a leaf class.
-class SnakeManager final : public prg::ITimerEvent
+class SnakeManager final
 {
    public:
+      /// The state of every Snake and of the collision bookkeeping at the time of save()
+      class Snapshot final
+      {
+         friend class SnakeManager;
+         friend class SaveGame;
+
+         std::vector<Snake::Snapshot> m_snakes {};                          /// Each Snake by index
+         std::vector<unsigned int> m_living {};                             /// A copy of m_living
+         std::vector<std::pair<unsigned int, unsigned int>> m_deadIndex {}; /// A copy of m_deadIndex
+         unsigned int m_livingSnakes {0};                                   /// A copy of m_livingSnakes
+      };
+
+
       /// Constructors and destructor
-      SnakeManager (const InGameSetup& setup, const unsigned int timer_id, const unsigned int moveInterval,
-                    const unsigned int humans, const unsigned int ai, const std::string& difficulty);
+      SnakeManager (const InGameSetup& setup, const std::shared_ptr<OccupancyGrid>& grid, const unsigned int humans,
+                    const unsigned int ai, const std::string& difficulty);
 
       SnakeManager (SnakeManager&& move) = default;
       ~SnakeManager();
@@ -59,20 +75,27 @@ class SnakeManager final : public prg::ITimerEvent
 
 
       /// Core requirements
-      /// Create and assign names to Snake objects
-      void initialiseSnakes (const std::vector<std::string>& names, const std::shared_ptr<SnakeInterface>& ui);
+      /// Create and assign names to Snake objects, each Snake starts at the matching spawn. The UI is optional
+      void initialiseSnakes (const std::vector<SnakeSpawn>& spawns, const std::vector<std::string>& names,
+                             const std::shared_ptr<SnakeInterface>& ui);
 
       /// Create and assign correct Keymap objects to PlayerController classes
       void initialisePlayers (const std::vector<Keymap>& keymaps);
 
-      /// Create and assign correct pointers to AIController classes
+      /// Create and assign correct pointers to AIController classes, every AIController draws from the same Random,
+      /// follows the same distance fields and reads the same DangerMap. MCTS AI plays ahead with the RolloutPool
       void initialiseAI (const std::shared_ptr<SnakeManager>& snakeManager, const std::shared_ptr<FoodManager>& foodManager,
-                         const std::shared_ptr<ObstacleManager>& obstacleManager);
+                         const std::shared_ptr<ObstacleManager>& obstacleManager,
+                         const std::shared_ptr<Random>& random,
+                         const std::shared_ptr<DistanceField>& foodField,
+                         const std::shared_ptr<DistanceField>& fatFoodField,
+                         const std::shared_ptr<DangerMap>& dangerMap,
+                         const std::shared_ptr<RolloutPool>& rollouts);
 
 
       /// Testing functions
       bool isSnakeAlive (const unsigned int index) const;
-      bool isSnakeHere (const Rectangle& rect) const;
+      bool isSnakeHere (const Cell& cell) const;
 
       bool isGameOver() const { return m_livingSnakes == 0; }
 
@@ -80,10 +103,12 @@ class SnakeManager final : public prg::ITimerEvent
       /// Functionality
       void resume(); /// Must be called when game is ready to start
       void pause();  /// Must be called on change of state
+      void moveSnakes(); /// Moves every living Snake one cell, called once per tick
+      void moveSnakes (const std::vector<Movement>& moves); /// The same but each Snake makes the move of its index
       void update();
-      void onTimer (prg::Timer& timer) override;
+      void updateInterface(); /// Shows every score and death on the UI, update() calls it every tick
       void drawSnakes(prg::Canvas& canvas);
-      void extractFlakes (std::vector<std::unique_ptr<Rectangle>>& modify);   /// Obtain all flakes and move them to modify
+      void extractFlakes (std::vector<Cell>& modify);   /// Obtain all flakes and move them to modify
 
 
       /// Assignment functions
@@ -91,24 +116,58 @@ class SnakeManager final : public prg::ITimerEvent
       void alterSnakeSize (const unsigned int index, const int foodEffect);
       void incrementScore (const unsigned int index, const unsigned int toAdd);
 
+      /// Controllers aren't part of a Snapshot, they decide each move from the state of the game. Neither updates
+      /// the UI
+      void save (Snapshot& modify) const;
+      void restore (const Snapshot& snapshot);
+
 
       /// Getters
       unsigned int getWinnerIndex() const;
-      const Rectangle& getSnakeHead (const unsigned int index) const;
+      const Cell& getSnakeHead (const unsigned int index) const;
+      Movement getSnakeLastMove (const unsigned int index) const;
+      unsigned int getSnakeScore (const unsigned int index) const;
+      const SnakeBody& getSnakeBody (const unsigned int index) const;
 
       unsigned int getSnakeAmount() const { return m_snakesP.size(); }
+      unsigned int getHumans() const      { return m_kHumans; }
+
+      /// The index of every Snake that was alive at the end of the last update(), in ascending order
+      const std::vector<unsigned int>& getLivingSnakes() const { return m_living; }
 
    protected:
 
    private:
       /// Testing functions
       bool snakesCrossed (const unsigned int snake, const unsigned int other);   /// See .cpp for information
+      unsigned int countHeads (const Cell& cell) const;   /// How many heads are in cell, requires indexHeads()
+
+      /// Allows m_headIndex and m_deadIndex to be searched by cell key alone
+      static bool compareKeys (const std::pair<unsigned int, unsigned int>& lhs,
+                               const std::pair<unsigned int, unsigned int>& rhs) { return lhs.first < rhs.first; }
 
       /// Functionality
       void updateSelfCollisions();  /// Check if any living snakes collide with themselves
       void updateHeadCollisions();  /// Check if any snake heads collide with each other
       void updateBodyCollisions();  /// Check if any head-body collisions happen
 
+      /// Sorts the head of every living Snake into m_headIndex, optionally including where each would roll back to
+      void indexHeads (const bool includeRollBack);
+
+      /// Adds every pairing of snake with a head indexed at cell to m_candidates
+      void addCandidates (const unsigned int snake, const Cell& cell);
+      void addCandidates (const unsigned int snake, const Cell& cell,
+                          const std::vector<std::pair<unsigned int, unsigned int>>& index);
+
+      /// Moves every Snake which has died from m_living into m_deadIndex
+      void removeDeadSnakes();
+      void addDeadHead (const unsigned int snake, const Cell& cell);
+
+
+      /// Getters
+      unsigned int getCellKey (const Cell& cell) const { return cell.y * m_kSetup.getGridWidth() + cell.x; }
+      Cell getPreviousCell (const Cell& cell, const Movement lastMove) const; /// Undoes lastMove
+
 
       /// Members
       const InGameSetup m_kSetup;      /// Required to pass to Snake and Controller objects
@@ -116,6 +175,8 @@ class SnakeManager final : public prg::ITimerEvent
       const unsigned int m_kAI;        /// The total number of AI players in the game
       const std::string m_kDifficulty; /// What level of AI should be spawned
 
+      std::shared_ptr<OccupancyGrid> m_pGrid; /// Shared with every Snake so they can record their parts
+
       std::vector<std::shared_ptr<Snake>> m_snakesP;  /// Contains every Snake in the game
 
       /// Separate the PlayerController objects from the AIController objects to ensure that each PlayerController removes
@@ -123,9 +184,16 @@ class SnakeManager final : public prg::ITimerEvent
       std::vector<std::shared_ptr<PlayerController>> m_playersP;
       std::vector<std::shared_ptr<AIController>> m_aiP;
 
+      /// Collisions are found by sorting heads by cell rather than comparing every pair of snakes. Dead Snakes never
+      /// move so their heads are indexed once when they die, each update only sorts the heads of the living. The
+      /// vectors are kept between updates so their memory is reused.
+      std::vector<unsigned int> m_living;                               /// The index of every living Snake
+      std::vector<std::pair<unsigned int, unsigned int>> m_headIndex;   /// Cell key and snake index of living heads
+      std::vector<std::pair<unsigned int, unsigned int>> m_deadIndex;   /// The same for dead heads, kept sorted
+      std::vector<std::pair<unsigned int, unsigned int>> m_candidates;  /// Pairs of snakes whose heads may meet
+
       unsigned int m_livingSnakes;           /// The number of living Snakes
-      std::shared_ptr<SnakeInterface> m_pUI; /// All scores are updated to the UI
-      prg::Timer m_timer;                    /// A timer used to move all Snakes at the set interval
+      std::shared_ptr<SnakeInterface> m_pUI; /// All scores are updated to the UI when there is one
 };
 
 #endif // SNAKEMANAGER_H
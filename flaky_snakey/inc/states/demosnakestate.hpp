@@ -27,8 +27,8 @@
 
 
 /// DemoSnakeState is a gameplay state which is designed as a pause menu to showcase how you play the game. It features a
-/// random number of AI snakes all trying to compete with each other. Due to limitations of prg::Timer, ThinFood decay is
-/// disabled in DemoSnakeState.
+/// random number of AI snakes all trying to compete with each other. The paused game can be saved to disk from here and
+/// the last save loaded back into the main state.
 /// DemoSnakeState is a leaf class.
 class DemoSnakeState final : public SnakeState
 {
@@ -59,6 +59,10 @@ class DemoSnakeState final : public SnakeState
       void prepareButtons() override;
 
 
+      /// Functionality
+      void saveGame(); /// Writes the paused game to the setup's save path
+
+
       /// Members
       Button m_continueButton;   /// onButton returns to the main state
 };
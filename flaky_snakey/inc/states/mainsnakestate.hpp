@@ -22,12 +22,19 @@
 #define MAINSNAKESTATE_H
 
 
+/// STL
+#include <memory> // m_pRecorder
+
+
 /// Personal
-#include <states/snakestate.hpp> // Parent
+#include <simulation/replayrecorder.hpp> // m_pRecorder
+#include <states/snakestate.hpp>         // Parent
 
 
 /// MainSnakeState is the primary gameplay state used in the game. Most functionality is derived from SnakeState but it
-/// it manages when to switch to the demo or game over states whilst managing gameplay.
+/// it manages when to switch to the demo or game over states whilst managing gameplay. Every game is recorded and
+/// handed to the setup as a Replay once it's over so it can be watched in the replay state. A game still being played
+/// is handed to the setup as a SaveGame whenever the state is left so the pause state can write it to disk.
 /// MainSnakeState is a leaf class.
 class MainSnakeState final : public SnakeState
 {
@@ -43,11 +50,14 @@ class MainSnakeState final : public SnakeState
 
 
       /// Functionality
+      void onEntry() override;
+      void onExit() override;
       void onUpdate() override;
       void onRender (prg::Canvas& canvas) override;
       bool onKey (const KeyEvent& keyEvent) override;
       bool onMotion (const MouseEvent& mouseEvent) override;
       bool onButton (const MouseEvent& mouseEvent) override;
+      void onTimer (prg::Timer& timer) override;
 
    protected:
 
@@ -59,10 +69,12 @@ class MainSnakeState final : public SnakeState
 
       /// Functionality
       void drawGameOver (prg::Canvas& canvas);
+      void loadGame(); /// Replaces the game with the save at the setup's save path
 
 
       /// Members
       unsigned int m_winnerIndex;
+      std::unique_ptr<ReplayRecorder> m_pRecorder;  /// Records every tick of the current game
 };
 
 #endif // MAINSNAKESTATE_H
@@ -0,0 +1,80 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef REPLAYSTATE_H
+#define REPLAYSTATE_H
+
+
+/// STL
+#include <memory> // m_pPlayer
+
+
+/// Personal
+#include <simulation/replayplayer.hpp> // m_pPlayer
+#include <states/snakestate.hpp>       // Parent
+
+
+/// ReplayState plays back the last game of the main state, stepping it at the speed it was played. Playback can be
+/// paused and scrubbed backwards and forwards, ReplayPlayer keeps keyframes so scrubbing never plays the whole game
+/// again. The replay restarts whenever a new game has been recorded since it was last entered.
+/// ReplayState is a leaf class.
+class ReplayState final : public SnakeState
+{
+   public:
+      /// Constructors and destructor
+      ReplayState();
+
+      ReplayState (ReplayState&& move) = default;
+      ~ReplayState() override = default;
+
+      /// Explicitly disallow (Effective C++: Item 6)
+      ReplayState (const ReplayState& copy) = delete;
+      ReplayState& operator= (const ReplayState& copy) = delete;
+
+
+      /// Functionality
+      void onEntry() override;
+      void onUpdate() override;
+      void onRender (prg::Canvas& canvas) override;
+      bool onKey (const KeyEvent& keyEvent) override;
+      bool onMotion (const MouseEvent& mouseEvent) override;
+      bool onButton (const MouseEvent& mouseEvent) override;
+      void onTimer (prg::Timer& timer) override;
+
+   protected:
+
+   private:
+      /// Core requirements
+      void reset() override;
+      void prepareButtons() override;
+
+
+      /// Functionality
+      void seek (const int ticks); /// Moves playback by the given number of ticks and refreshes the UI
+
+
+      /// Members
+      static const int kSeekTicks = 50;          /// How far the arrow keys move playback
+
+      std::unique_ptr<ReplayPlayer> m_pPlayer;   /// Steps m_pWorld through the replay, nullptr without a replay
+      bool m_paused;                             /// Whether playback is paused
+};
+
+#endif // REPLAYSTATE_H
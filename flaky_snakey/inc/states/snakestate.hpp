@@ -23,35 +23,31 @@
 
 
 /// STL
-#include <ctime>  // time(0)
+#include <ctime>  // createWorld()
 
 
 /// Third party
 #include <prg/interactive/app_state.hpp>  // Parent
+#include <prg/interactive/timer.hpp>      // m_timer
 
 
 /// Personal
-#include <food/foodmanager.hpp>           // onEntry()
-#include <obstacles/obstaclemanager.hpp>  // updateCollisions()
 #include <setup/snakestatesetup.hpp>      // m_pSetup
-#include <snakes/snakemanager.hpp>        // onEntry()
+#include <simulation/world.hpp>           // m_pWorld
 #include <ui/button.hpp>                  // m_resetButton
 
 
-/// Forward declaration
-class ObstacleManager;
-
-
-/// SnakeState is the main gameplay state class. Every piece of gameplay is managed with this class. SnakeState is
-/// designed to be a base class for more specific implementations, for example a pause state would inherit SnakeState as
-/// it functions incredibly similarly but has slight differences which are handled in the derived class.
-/// SnakeState manages all interactions between the manager classes.
+/// SnakeState is the main gameplay state class. SnakeState is designed to be a base class for more specific
+/// implementations, for example a pause state would inherit SnakeState as it functions incredibly similarly but has
+/// slight differences which are handled in the derived class.
+/// SnakeState drives a World, stepping it once every time its timer fires and drawing what the World contains.
 /// SnakeState is a branch class.
-class SnakeState : public prg::IAppState, public prg::IKeyEvent, public prg::IMouseEvent
+class SnakeState : public prg::IAppState, public prg::IKeyEvent, public prg::IMouseEvent, public prg::ITimerEvent
 {
    public:
       /// Constructors and destructor
-      SnakeState();
+      /// Each state needs its own timer ID
+      SnakeState (const unsigned int timerID);
 
       SnakeState (SnakeState&& move) = default;
       virtual ~SnakeState() = default;
@@ -76,33 +72,33 @@ class SnakeState : public prg::IAppState, public prg::IKeyEvent, public prg::IMo
       virtual bool onKey (const KeyEvent& keyEvent) override = 0;
       virtual bool onMotion (const MouseEvent& mouseEvent) override = 0;
       virtual bool onButton (const MouseEvent& mouseEvent) override = 0;
+      void onTimer (prg::Timer& timer) override;
 
    protected:
       /// Core requirements
       virtual void reset() = 0;           /// Starts the game again
       virtual void prepareButtons() = 0;  /// Prepares and places buttons
 
+      /// Replaces the World with a new game made from setup and starts stepping it at the setup's interval
+      void createWorld (const SnakeStateSetup& setup);
+      void createWorld (const SnakeStateSetup& setup, const unsigned int seed);
+
+
       /// Functionality
       void drawBorder (prg::Canvas& canvas); /// Draws a border around the play area
-      void updateCollisions();               /// Check all cross-Manager collisions
-      void processFlakes();                  /// Extract flakes and convert into Obstacle objects
-      Rectangle findSpawnPoint();   /// Obtain a valid spawn point for FoodManager, return {10, 10, 0, 0} if impossible
+      void drawWorld (prg::Canvas& canvas);  /// Draws the UI and every object in the World
 
 
       /// Members
-      std::shared_ptr<SnakeStateSetup> m_pSetup;            /// Contains all information necessary for the game to work
-      std::shared_ptr<FoodManager> m_pFoodManager;          /// Manages all Food objects
-      std::shared_ptr<ObstacleManager> m_pObstacleManager;  /// Manages all Obstacle objects
-      std::shared_ptr<SnakeManager> m_pSnakeManager;        /// Manages all Snake objects
-      std::shared_ptr<SnakeInterface> m_pUI;                /// Contains information on current Snake scores
+      std::shared_ptr<SnakeStateSetup> m_pSetup;   /// Contains all information necessary for the game to work
+      std::unique_ptr<World> m_pWorld;             /// The game itself, stepped by m_timer
+      std::shared_ptr<SnakeInterface> m_pUI;       /// Contains information on current Snake scores
+      prg::Timer m_timer;                          /// Steps m_pWorld at the snake update interval
 
 
       Button m_resetButton;   /// Allows for restarting the game
       Button m_quitButton;    /// Allows for quitting of the game
 
-      /// Is a spawn available for FoodManager? This is merely to avoid an infinite loop if all cells are occupied
-      bool m_spawnAvailable;
-
       /// Is a reset needed due to in-game events? (e.g. isGameOver())
       bool m_needsReset;
 
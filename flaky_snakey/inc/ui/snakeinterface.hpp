@@ -23,12 +23,13 @@
 
 
 /// STL
-#include <stdexcept> // addPlayer()
+#include <algorithm> // draw()
+#include <stdexcept> // updateScore(), setAlive(), getName() and getScore()
 #include <vector>    // m_scores
 
 
 /// Third party
-#include <prg/core/font.hpp>  // draw()
+#include <prg/core/font.hpp>  // m_font
 #include <prg/core/image.hpp> // draw()
 
 
@@ -59,7 +60,7 @@ class SnakeInterface final : public IDrawable
 
 
       /// Assignment functions
-      void addPlayer (const unsigned int playerNumber, const std::string& name);
+      void addPlayer (const unsigned int playerNumber, const std::string& name, const prg::Colour& colour);
       void updateScore (const unsigned int playerNumber, const unsigned int score);
       void setAlive (const unsigned int playerNumber, const bool alive);
 
@@ -77,7 +78,9 @@ class SnakeInterface final : public IDrawable
 
       /// Members
       const InGameSetup m_kSetup;         /// Contains all necessary settings to draw to the screen
+      prg::Font m_font;                   /// Fits 10 characters across the interface, loaded once rather than per draw
       std::vector<SnakeScore> m_scores;   /// Contains all snakes scores, names, numbers and living state
+      std::vector<prg::Colour> m_colours; /// The colour of each player's text, kept between draws
 
 };
 
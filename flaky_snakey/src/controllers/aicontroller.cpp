@@ -19,6 +19,7 @@
 
 
 #include <controllers/aicontroller.hpp>
+#include <misc/profiler.hpp>
 #include <obstacles/obstaclemanager.hpp>
 #include <snakes/snakemanager.hpp>
 
@@ -26,8 +27,11 @@
 /// Constructors and destructor
 AIController::AIController(const InGameSetup& setup)
    :  Controller(), m_kSetup (setup),
-      m_pkSnakeManager (), m_pkFoodManager (), m_pkObstacleManager ()
+      m_pkSnakeManager (), m_pkFoodManager (), m_pkObstacleManager (), m_pRandom (nullptr), m_moves (0),
+      m_pGrid (nullptr), m_pSearch (nullptr), m_pFoodField (nullptr), m_pFatFoodField (nullptr), m_pDangerMap (nullptr)
 {
+   /// A Snake can never have more than three moves to choose from
+   m_moves.reserve (3);
 }
 
 
@@ -47,23 +51,66 @@ bool AIController::exists (const Movement test, const std::vector<Movement>& mov
 }
 
 
+/// The eight cells around the head are walked clockwise from the cell above it, each run of free cells is a path
+/// between the moves that lead into it
+bool AIController::isOneRegion (const Cell& head, const std::vector<Movement>& moves) const
+{
+   static const int kRing[8][2] { {0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, -1}, {-1, 0}, {-1, 1} };
+
+   /// Where the cell each move leads to lies on the ring
+   static const unsigned int kPlace[5] { 8, 0, 6, 2, 4 };
+
+   std::array<bool, 8> free {};
+   unsigned int wall {8};
+
+   for (unsigned int i {0}; i < 8; ++i)
+   {
+      Cell cell = head;
+      utility::moveCell (m_kSetup, cell, kRing[i][0], kRing[i][1]);
+
+      free[i] = !m_pGrid->isCollidable (cell);
+      wall = !free[i] && wall == 8 ? i : wall;
+   }
+
+   /// Label the runs starting after a wall so no run is split where the walk begins, a ring without walls is one run
+   std::array<unsigned int, 8> runs {};
+   unsigned int run {0};
+
+   for (unsigned int step {1}; step <= 8 && wall != 8; ++step)
+   {
+      const unsigned int i = (wall + step) % 8;
+      run += free[i] && !free[(i + 7) % 8] ? 1 : 0;
+      runs[i] = run;
+   }
+
+   for (const auto move : moves)
+   {
+      if (runs[kPlace[(int) move]] != runs[kPlace[(int) moves.front()]])
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+
 
 /// Functionality
 Movement AIController::basicMove() const
 {
-   return Movement (rand() % 4 + 1);
+   return Movement (m_pRandom->next (4) + 1);
 }
 
 
 Movement AIController::safeMove()
 {
-   std::vector<Movement> moves;
-   generateSafeMoves (moves);
+   generateSafeMoves (m_moves);
 
-   if (!moves.empty())
+   if (!m_moves.empty())
    {
 
-      return moves[rand() % moves.size()];
+      return m_moves[m_pRandom->next (m_moves.size())];
 
    }
 
@@ -73,8 +120,8 @@ Movement AIController::safeMove()
    }
 }
 
-/// Moves a Rectangle one cell forward, taking into account the ability to spawn at the other side
-void AIController::moveForward (Rectangle& modify, const Movement move)
+/// Moves a Cell one cell forward, taking into account the ability to spawn at the other side
+void AIController::moveForward (Cell& modify, const Movement move)
 {
    switch (move)
    {
@@ -100,9 +147,11 @@ void AIController::moveForward (Rectangle& modify, const Movement move)
 }
 
 
-/// Fills modify with possible moves based on m_lastMove
+/// Fills modify with possible moves based on m_lastMove, anything already in modify is replaced
 void AIController::generatePossibleMoves (std::vector<Movement>& modify)
 {
+   modify.clear();
+
    switch (m_lastMove)
    {
       case Movement::Up:
@@ -135,7 +184,10 @@ void AIController::generatePossibleMoves (std::vector<Movement>& modify)
 }
 
 
-/// Calls generatePossibleMoves then checks if any don't contain collidable objects
+/// Calls generatePossibleMoves then checks if any don't contain collidable objects. Each remaining move is scored by
+/// the size of the region it leads into, a Snake which enters a region smaller than itself will run out of room so
+/// those moves are only kept when nothing roomier exists, and then only the largest. A small region which a Snake
+/// walling it in will have left before it could be filled beats every other small region, but never an open one
 void AIController::generateSafeMoves (std::vector<Movement>& modify)
 {
    generatePossibleMoves (modify);
@@ -144,7 +196,7 @@ void AIController::generateSafeMoves (std::vector<Movement>& modify)
    const auto& snakeManager = m_pkSnakeManager.lock();
    const auto& snake = m_pkSnake.lock();
 
-   if (snake && obstacleManager && obstacleManager)
+   if (snake && obstacleManager && snakeManager)
    {
       // Avoid ranged based loop for the ability to erase the move
       for (int i {0}; (unsigned int) i < modify.size(); ++i)
@@ -160,6 +212,195 @@ void AIController::generateSafeMoves (std::vector<Movement>& modify)
       }
    }
    // Else just return possible moves
+
+   if (!snake || !m_pGrid || !m_pSearch || modify.empty())
+   {
+      return;
+   }
+
+   if (m_pDangerMap)
+   {
+      m_pDangerMap->refresh (snake->getPlayerNumber());
+   }
+
+   /// Moves into one region are all as roomy as each other so there is nothing to fill
+   if (modify.size() == 1 || isOneRegion (snake->getHead(), modify))
+   {
+      return;
+   }
+
+   /// Every move shares one search, a move into a region another move already filled takes its size
+   const unsigned int limit = snake->getSize() < kRoomyRegion ? snake->getSize() : kRoomyRegion;
+   std::array<unsigned int, 5> regions {};
+   unsigned int largest {0};
+
+   m_pSearch->beginSearch();
+
+   for (const auto move : modify)
+   {
+      auto start = snake->getHead();
+      moveForward (start, move);
+
+      const unsigned int index = m_pSearch->getIndex (start);
+      auto& region = regions[(int) move];
+
+      region = m_pSearch->isVisited (index) ? regions[(int) m_pSearch->getFirstMove (index)]
+                                            : fillRegion (start, move, limit);
+
+      largest = region > largest ? region : largest;
+   }
+
+   const unsigned int needed = largest > limit ? limit + 1 : largest;
+
+   for (int i {0}; (unsigned int) i < modify.size(); ++i)
+   {
+      if (regions[(int) modify[i]] < needed)
+      {
+         modify.erase (modify.begin() + i--);
+      }
+   }
+}
+
+
+/// A scanline fill, the run of free cells along the row of each seed is filled at once and only the first cell of each
+/// free run above and below it is pushed as a new seed. Cells are marked with the move so that a fill running into a
+/// region already filled by another move knows the two are connected, which only happens if that fill stopped early.
+/// The Snake can make at most one move per cell of the region, a wall which clears within that many moves opens it up.
+/// Snakes can eat and stay put for longer so such a region is still ranked below one which is already open
+unsigned int AIController::fillRegion (const Cell& start, const Movement move, const unsigned int limit)
+{
+   auto& search = *m_pSearch;
+   auto& seeds = search.getFrontier();
+   const unsigned short width = m_kSetup.getGridWidth();
+   const unsigned short height = m_kSetup.getGridHeight();
+
+   unsigned int size {0}, soonest {DangerMap::kNever};
+   bool joined {false};
+
+   /// Whether a cell can still be filled, noting whether it belongs to another move and when each wall clears
+   const auto isOpen = [&] (const Cell& cell)
+   {
+      const unsigned int index = search.getIndex (cell);
+
+      if (search.isVisited (index))
+      {
+         joined |= search.getFirstMove (index) != move;
+         return false;
+      }
+
+      if (!m_pGrid->isCollidable (cell))
+      {
+         return true;
+      }
+
+      if (m_pDangerMap)
+      {
+         const unsigned int clears = m_pDangerMap->getFirstSafeMove (cell);
+         soonest = clears < soonest ? clears : soonest;
+      }
+
+      return false;
+   };
+
+   seeds.clear();
+   seeds.push_back (search.getIndex (start));
+
+   while (!seeds.empty() && size <= limit && !joined)
+   {
+      const Cell seed = search.getCell (seeds.back());
+      seeds.pop_back();
+
+      if (!isOpen (seed))
+      {
+         continue;
+      }
+
+      /// Find the run the seed belongs to, the level wraps so a run could cover the whole row of a huge level but it
+      /// never needs to be longer than the cells remaining before the limit. Wrapping by comparison avoids a division
+      search.visit (search.getIndex (seed), move);
+      unsigned short left {seed.x}, length {1};
+
+      for (Cell next {(unsigned short) (left == 0 ? width - 1 : left - 1), seed.y};
+           size + length <= limit && isOpen (next); next.x = next.x == 0 ? width - 1 : next.x - 1)
+      {
+         search.visit (search.getIndex (next), move);
+         left = next.x;
+         ++length;
+      }
+
+      for (Cell next {(unsigned short) (seed.x + 1 == width ? 0 : seed.x + 1), seed.y};
+           size + length <= limit && isOpen (next); next.x = next.x + 1 == width ? 0 : next.x + 1)
+      {
+         search.visit (search.getIndex (next), move);
+         ++length;
+      }
+
+      size += length;
+
+      /// Seed every run of open cells in the rows either side
+      for (const unsigned short y : { (unsigned short) (seed.y + 1 == height ? 0 : seed.y + 1),
+                                      (unsigned short) (seed.y == 0 ? height - 1 : seed.y - 1) })
+      {
+         Cell cell {left, y};
+         bool inRun {false};
+
+         for (unsigned short i {0}; i < length; ++i, cell.x = cell.x + 1 == width ? 0 : cell.x + 1)
+         {
+            const bool open = isOpen (cell);
+
+            if (open && !inRun)
+            {
+               seeds.push_back (search.getIndex (cell));
+            }
+
+            inRun = open;
+         }
+      }
+   }
+
+   return joined ? limit + 1 : soonest <= size && size < limit ? limit : size;
+}
+
+
+/// Every safe move leads to a free cell so the field knows its distance unless it was out of reach
+Movement AIController::descendField (DistanceField& field, const bool randomTies)
+{
+   const auto& snake = m_pkSnake.lock();
+
+   if (!snake)
+   {
+      return Movement::Null;
+   }
+
+   generateSafeMoves (m_moves);
+   field.refresh();
+
+   unsigned int nearest {DistanceField::kUnknown}, ties {0};
+   Movement move {Movement::Null};
+
+   for (const auto candidate : m_moves)
+   {
+      auto cell = snake->getHead();
+      moveForward (cell, candidate);
+
+      const unsigned int distance = field.getDistance (cell);
+
+      if (distance < nearest)
+      {
+         nearest = distance;
+         move = candidate;
+         ties = 1;
+      }
+
+      /// Each of the tied moves replaces the choice with an equal chance
+      else if (distance == nearest && distance != DistanceField::kUnknown && randomTies &&
+               m_pRandom->next (++ties) == 0)
+      {
+         move = candidate;
+      }
+   }
+
+   return move;
 }
 
 
@@ -194,11 +435,65 @@ void AIController::setObstacleManager (const std::shared_ptr<ObstacleManager>& o
 }
 
 
+void AIController::setRandom (const std::shared_ptr<Random>& random)
+{
+   /// Ensure shared_ptr is valid
+   if (random)
+   {
+      m_pRandom = random;
+   }
+}
+
+
+void AIController::setGrid (const std::shared_ptr<const OccupancyGrid>& grid)
+{
+   /// Ensure shared_ptr is valid
+   if (grid)
+   {
+      m_pGrid = grid;
+   }
+}
+
+
+void AIController::setSearchBuffers (const std::shared_ptr<SearchBuffers>& search)
+{
+   /// Ensure shared_ptr is valid
+   if (search)
+   {
+      m_pSearch = search;
+   }
+}
+
+
+void AIController::setDistanceFields (const std::shared_ptr<DistanceField>& foodField,
+                                      const std::shared_ptr<DistanceField>& fatFoodField)
+{
+   /// Ensure shared_ptrs are valid
+   if (foodField && fatFoodField)
+   {
+      m_pFoodField = foodField;
+      m_pFatFoodField = fatFoodField;
+   }
+}
+
+
+void AIController::setDangerMap (const std::shared_ptr<DangerMap>& dangerMap)
+{
+   /// Ensure shared_ptr is valid
+   if (dangerMap)
+   {
+      m_pDangerMap = dangerMap;
+   }
+}
+
+
 
 /// Getters
 /// AIController will check for any safe movements and randomly choose one
 Movement AIController::getMove()
 {
+   const Profiler::Scope scope {Profiler::Phase::GenericMove};
+
    /// Check validity of each necessary weak_ptr
    const auto& snake = m_pkSnake.lock();
    const auto& obstacleManager = m_pkObstacleManager.lock();
@@ -20,6 +20,7 @@
 
 #include <controllers/dumbaicontroller.hpp>
 #include <food/foodmanager.hpp>
+#include <misc/profiler.hpp>
 
 
 /// Constructors and destructor
@@ -31,21 +32,11 @@ DumbAIController::DumbAIController(const InGameSetup& setup)
 
 
 /// Functionality
-Movement DumbAIController::chaseFood (const Rectangle& head, const Rectangle& food)
+Movement DumbAIController::chaseFood (const Cell& head, const Cell& food)
 {
-   /// Improve efficiency by getting parameters
-   const unsigned int startX = m_kSetup.getStartX();
-   const unsigned int startY = m_kSetup.getStartY();
-   const unsigned int rectWidth = m_kSetup.getRectWidth();
-   const unsigned int rectHeight = m_kSetup.getRectHeight();
-
-   unsigned int headX = (head.getX() - startX) / rectWidth;
-   unsigned int headY = (head.getY() - startY) / rectHeight;
-   unsigned int foodX = (food.getX() - startX) / rectWidth;
-   unsigned int foodY = (food.getY() - startY) / rectHeight;
-
-   int diffX = foodX - headX;
-   int diffY = foodY - headY;
+   // The level wraps so the food may be closer going the other way
+   int diffX = utility::wrapDifference (food.x - head.x, m_kSetup.getGridWidth());
+   int diffY = utility::wrapDifference (food.y - head.y, m_kSetup.getGridHeight());
    Movement preferred, secondary;
 
 
@@ -61,7 +52,7 @@ Movement DumbAIController::chaseFood (const Rectangle& head, const Rectangle& fo
    else                 { secondary = Movement::Right; }
 
    // Random chance to swap directions
-   if (rand() % 2 == 0)
+   if (m_pRandom->next (2) == 0)
    {
       Movement temp = preferred;
       preferred = secondary;
@@ -69,24 +60,23 @@ Movement DumbAIController::chaseFood (const Rectangle& head, const Rectangle& fo
    }
 
 
-   std::vector<Movement> moves;
-   generateSafeMoves (moves);
+   generateSafeMoves (m_moves);
 
-   if (!moves.empty())
+   if (!m_moves.empty())
    {
-      if (exists (preferred, moves))
+      if (exists (preferred, m_moves))
       {
          return preferred;
       }
 
-      else if (exists (secondary, moves))
+      else if (exists (secondary, m_moves))
       {
          return secondary;
       }
 
       else
       {
-         return moves[rand() % moves.size()];
+         return m_moves[m_pRandom->next (m_moves.size())];
       }
    }
 
@@ -102,6 +92,8 @@ Movement DumbAIController::chaseFood (const Rectangle& head, const Rectangle& fo
 /// Getters
 Movement DumbAIController::getMove()
 {
+   const Profiler::Scope scope {Profiler::Phase::DumbMove};
+
    const auto& snake = m_pkSnake.lock();
    const auto& foodManager = m_pkFoodManager.lock();
    const auto& obstacleManager = m_pkObstacleManager.lock();
@@ -110,32 +102,39 @@ Movement DumbAIController::getMove()
    if (snake && foodManager && obstacleManager && snakeManager)
    {
       const auto head = snake->getHead();
-      const auto& food = foodManager->findNearestFood (head, false);
-      const auto foodIndex = foodManager->getFoodIndex (food);
       m_lastMove = snake->getLastMove();
 
-      // If food isn't available the head will be returned
-      if (head != food)
+      /// Avoid eating ThinFood if size is less than half of the max effect, small Snakes only follow FatFood
+      const unsigned int avoid = m_kSetup.getGridWidth() * m_kSetup.getGridHeight() * 0.005;
+      const auto& field = snake->getSize() >= avoid ? m_pFoodField : m_pFatFoodField;
+      m_move = field && field->isWorthSearching() ? descendField (*field, true) : Movement::Null;
+
+      // The field isn't shared by enough Snakes or doesn't reach this far so head straight for the nearest food
+      if (m_move == Movement::Null)
       {
-         /// Avoid eating ThinFood if size is less than half of the max effect
-         const unsigned int avoid = m_kSetup.getGridWidth() * m_kSetup.getGridHeight() * 0.005;
-         if (snake->getSize() >= avoid ||
-            (snake->getSize() < avoid && foodManager->getFoodEffect (foodIndex) > 0))
+         const auto food = foodManager->findNearestFood (head, false);
+
+         // If food isn't available there's no handle
+         if (food != FoodIndex::kNoFood)
          {
-            m_move = chaseFood (head, food);
+            if (snake->getSize() >= avoid ||
+               (snake->getSize() < avoid && foodManager->getFoodEffect (food) > 0))
+            {
+               m_move = chaseFood (head, foodManager->getFoodPosition (food));
+            }
+
+            /// If food can kill then just move to a safe place
+            else
+            {
+               m_move = safeMove();
+            }
          }
 
-         /// If food can kill then just move to a safe place
          else
          {
             m_move = safeMove();
          }
       }
-
-      else
-      {
-         m_move = safeMove();
-      }
    }
 
    else // weak_ptrs are invalid
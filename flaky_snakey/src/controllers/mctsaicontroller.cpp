@@ -0,0 +1,415 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <controllers/mctsaicontroller.hpp>
+
+
+/// STL
+#include <chrono>    // getMove()
+#include <cmath>     // select()
+#include <stdexcept> // Constructor
+#include <utility>   // std::swap
+
+
+/// Personal
+#include <food/foodmanager.hpp>       // rolloutMove()
+#include <misc/profiler.hpp>          // getMove()
+#include <simulation/rolloutpool.hpp> // m_pRollouts
+
+
+namespace
+{
+   /// How much of the result surviving the whole rollout is worth, growing is worth the rest
+   const float kSurvivalShare = 0.75f;
+
+   /// How strongly UCT favours moves which have been tried less
+   const float kExploration = 0.7f;
+
+
+   /// The move which would turn the Snake back into itself
+   Movement getReverse (const Movement move)
+   {
+      return Movement (5 - (int) move);
+   }
+}
+
+
+
+/// Constructors and destructor
+MCTSAIController::MCTSAIController (const InGameSetup& setup, const std::shared_ptr<RolloutPool>& rollouts)
+   :  AIController (setup), m_pRollouts (rollouts), m_workers (0), m_firstMoves (0), m_mutex(), m_nodes (0),
+      m_spare (0), m_index (0), m_decisionTick (0),
+      m_avoidSize (setup.getGridWidth() * setup.getGridHeight() * 0.005)
+{
+   // Pre-condition: There must be somewhere to play ahead
+   if (!m_pRollouts)
+   {
+      throw std::runtime_error ("Attempt to create an MCTSAIController without a RolloutPool.");
+   }
+
+   /// Nothing reallocates once the threads are playing
+   m_workers.resize (m_pRollouts->getWorkers());
+   m_nodes.reserve (kMaxNodes);
+   m_spare.reserve (kMaxNodes);
+
+   for (auto& worker : m_workers)
+   {
+      worker.path.reserve (kHorizon + 1);
+      worker.plan.reserve (kHorizon);
+   }
+}
+
+
+
+/// Functionality
+/// The game only continued from the last move if the root is the very next tick and the Snake made the move chosen,
+/// the nodes of that move's subtree are copied breadth first so the tree stays packed at the front of the vector
+void MCTSAIController::prepareTree (const Snake& snake)
+{
+   const unsigned int rootTick = m_pRollouts->getRootTick();
+   unsigned int kept {0};
+
+   if (!m_nodes.empty() && rootTick == m_decisionTick + 1 && m_lastMove != Movement::Null &&
+       snake.getLastMove() == m_lastMove)
+   {
+      kept = m_nodes.front().children[(int) m_lastMove - 1];
+   }
+
+   if (kept != 0)
+   {
+      m_spare.clear();
+      m_spare.push_back (m_nodes[kept]);
+
+      for (unsigned int i {0}; i < m_spare.size(); ++i)
+      {
+         for (auto& child : m_spare[i].children)
+         {
+            if (child != 0)
+            {
+               m_spare.push_back (m_nodes[child]);
+               child = m_spare.size() - 1;
+            }
+         }
+      }
+
+      m_nodes.swap (m_spare);
+   }
+
+   else
+   {
+      m_nodes.clear();
+      m_nodes.push_back ({ {0, 0, 0, 0}, snake.getLastMove(), 0, 0.f });
+   }
+
+   m_decisionTick = rootTick;
+}
+
+
+/// Each node visited is counted straight away but its reward only arrives with the result, until then the path looks
+/// like a loss and the other threads are steered elsewhere. Descends by UCT until it expands a move which has never
+/// been tried, a move is never the reverse of the one before it
+void MCTSAIController::select (Worker& worker)
+{
+   std::lock_guard<std::mutex> lock {m_mutex};
+
+   worker.path.clear();
+   worker.plan.clear();
+
+   unsigned int node {0};
+   ++m_nodes[node].visits;
+   worker.path.push_back (node);
+
+   while (worker.plan.size() < kHorizon)
+   {
+      const Movement reverse = getReverse (m_nodes[node].move);
+      const float exploration = kExploration * std::sqrt (std::log ((float) m_nodes[node].visits));
+      unsigned int best {0};
+      float bestScore {0.f};
+
+      for (int i {0}; i < 4; ++i)
+      {
+         const Movement move = Movement (i + 1);
+         const unsigned int child = m_nodes[node].children[i];
+
+         if (move == reverse)
+         {
+            continue;
+         }
+
+         /// Expand the first move never tried, m_nodes has room reserved for every node so this never reallocates
+         if (child == 0)
+         {
+            if (m_nodes.size() < kMaxNodes)
+            {
+               m_nodes.push_back ({ {0, 0, 0, 0}, move, 1, 0.f });
+               m_nodes[node].children[i] = m_nodes.size() - 1;
+
+               worker.path.push_back (m_nodes.size() - 1);
+               worker.plan.push_back (move);
+               return;
+            }
+
+            continue;
+         }
+
+         const Node& candidate = m_nodes[child];
+         const float score = candidate.reward / candidate.visits + exploration / std::sqrt ((float) candidate.visits);
+
+         if (best == 0 || score > bestScore)
+         {
+            best = child;
+            bestScore = score;
+         }
+      }
+
+      /// The tree is full and this node has no children
+      if (best == 0)
+      {
+         return;
+      }
+
+      node = best;
+      ++m_nodes[node].visits;
+      worker.path.push_back (node);
+      worker.plan.push_back (m_nodes[node].move);
+   }
+}
+
+
+void MCTSAIController::backPropagate (const Worker& worker, const float reward)
+{
+   std::lock_guard<std::mutex> lock {m_mutex};
+
+   for (const auto node : worker.path)
+   {
+      m_nodes[node].reward += reward;
+   }
+}
+
+
+/// The Snakes before this one have already made their move this tick so they make it again, everything else not on
+/// the path is decided by rolloutMove(). The rules are reseeded so food spawns differently each time. Surviving the
+/// whole rollout is worth most, growing along the way adds the rest
+void MCTSAIController::rollout (World& world, const unsigned int index)
+{
+   auto& worker = m_workers[index];
+   select (worker);
+
+   world.restore (m_pRollouts->getRoot());
+   world.reseed (worker.random.next());
+
+   const auto& snakeManager = *world.getSnakeManager();
+   const unsigned int startSize = snakeManager.getSnakeBody (m_index).getSize();
+   unsigned int survived {0};
+
+   while (survived < kHorizon)
+   {
+      for (const auto i : snakeManager.getLivingSnakes())
+      {
+         if (i == m_index)
+         {
+            worker.moves[i] = survived < worker.plan.size() ? worker.plan[survived] :
+                              rolloutMove (world, i, worker.random);
+         }
+
+         else if (survived == 0 && m_firstMoves[i] != Movement::Null)
+         {
+            worker.moves[i] = m_firstMoves[i];
+         }
+
+         else if (snakeManager.isSnakeAlive (i))
+         {
+            worker.moves[i] = rolloutMove (world, i, worker.random);
+         }
+      }
+
+      world.step (worker.moves);
+
+      if (!snakeManager.isSnakeAlive (m_index))
+      {
+         break;
+      }
+
+      ++survived;
+   }
+
+   float reward = kSurvivalShare * survived / kHorizon;
+
+   if (survived == kHorizon)
+   {
+      const unsigned int size = snakeManager.getSnakeBody (m_index).getSize();
+      const unsigned int growth = size > startSize ? size - startSize : 0;
+
+      reward += (1.f - kSurvivalShare) * (growth < kFullGrowth ? growth : kFullGrowth) / kFullGrowth;
+   }
+
+   backPropagate (worker, reward);
+}
+
+
+/// Only the cells next to the head are looked at, a rollout is played many times and has to be cheap
+Movement MCTSAIController::rolloutMove (World& world, const unsigned int index, Random& random)
+{
+   const auto& snakeManager = *world.getSnakeManager();
+   const auto& foodManager = *world.getFoodManager();
+   const auto& grid = *world.getGrid();
+
+   const Cell& head = snakeManager.getSnakeHead (index);
+   const Movement lastMove = snakeManager.getSnakeLastMove (index);
+   const Movement reverse = getReverse (lastMove);
+
+   Movement safe[3];
+   unsigned int count {0};
+
+   for (int i {1}; i <= 4; ++i)
+   {
+      Cell next = head;
+      moveForward (next, Movement (i));
+
+      if (Movement (i) != reverse && !grid.isCollidable (next))
+      {
+         safe[count++] = Movement (i);
+      }
+   }
+
+   // Accept death
+   if (count == 0)
+   {
+      return lastMove;
+   }
+
+   /// Small Snakes are killed by ThinFood so they only chase FatFood
+   const bool fatOnly = snakeManager.getSnakeBody (index).getSize() < m_avoidSize;
+   const unsigned int food = foodManager.findNearestFood (head, fatOnly);
+
+   if (food != FoodIndex::kNoFood)
+   {
+      const Cell& target = foodManager.getFoodPosition (food);
+      const int diffX = utility::wrapDifference (target.x - head.x, m_kSetup.getGridWidth());
+      const int diffY = utility::wrapDifference (target.y - head.y, m_kSetup.getGridHeight());
+      Movement preferred, secondary;
+
+      if       (diffX < 0) { preferred = Movement::Left; }
+      else if  (diffX > 0) { preferred = Movement::Right; }
+      else if  (diffY > 0) { preferred = Movement::Up; }
+      else                 { preferred = Movement::Down; }
+
+      if       (diffY > 0) { secondary = Movement::Up; }
+      else if  (diffY < 0) { secondary = Movement::Down; }
+      else if  (diffX < 0) { secondary = Movement::Left; }
+      else                 { secondary = Movement::Right; }
+
+      if (random.next (2) == 0)
+      {
+         std::swap (preferred, secondary);
+      }
+
+      for (unsigned int i {0}; i < count; ++i)
+      {
+         if (safe[i] == preferred)
+         {
+            return preferred;
+         }
+      }
+
+      for (unsigned int i {0}; i < count; ++i)
+      {
+         if (safe[i] == secondary)
+         {
+            return secondary;
+         }
+      }
+   }
+
+   return safe[random.next (count)];
+}
+
+
+
+/// Getters
+/// The Snakes which still have to move this tick share what is left of its budget equally, the threads then play until
+/// this Snake's share runs out. The move tried most often is the one the tree trusts the most
+Movement MCTSAIController::getMove()
+{
+   const Profiler::Scope scope {Profiler::Phase::MCTSMove};
+
+   const auto& snake = m_pkSnake.lock();
+   const auto& snakeManager = m_pkSnakeManager.lock();
+
+   if (snake && snakeManager)
+   {
+      m_index = snake->getPlayerNumber();
+      prepareTree (*snake);
+      m_lastMove = snake->getLastMove();
+
+      /// Index order is move order, any Snake before this one has moved and any after it is still to decide
+      unsigned int deciding {0};
+      m_firstMoves.assign (snakeManager->getSnakeAmount(), Movement::Null);
+
+      for (const auto i : snakeManager->getLivingSnakes())
+      {
+         if (snakeManager->isSnakeAlive (i))
+         {
+            if (i < m_index)
+            {
+               m_firstMoves[i] = snakeManager->getSnakeLastMove (i);
+            }
+
+            else
+            {
+               ++deciding;
+            }
+         }
+      }
+
+      const auto now = std::chrono::steady_clock::now();
+      const auto tickDeadline = m_pRollouts->getTickDeadline();
+      const auto deadline = now < tickDeadline ? now + (tickDeadline - now) / deciding : now;
+
+      const unsigned int seed = m_pRandom->next();
+
+      for (unsigned int i {0}; i < m_workers.size(); ++i)
+      {
+         m_workers[i].random.seed (seed, i);
+         m_workers[i].moves.resize (snakeManager->getSnakeAmount(), Movement::Null);
+      }
+
+      m_pRollouts->run ([this] (World& world, const unsigned int worker) { rollout (world, worker); }, deadline);
+
+      unsigned int best {0};
+
+      for (const auto child : m_nodes.front().children)
+      {
+         if (child != 0 && (best == 0 || m_nodes[child].visits > m_nodes[best].visits))
+         {
+            best = child;
+         }
+      }
+
+      m_move = best != 0 ? m_nodes[best].move : safeMove();
+   }
+
+   else // weak_ptrs are invalid
+   {
+      m_move = basicMove();
+   }
+
+   m_lastMove = m_move;
+   return m_move;
+}
@@ -0,0 +1,231 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <controllers/pathfindingaicontroller.hpp>
+#include <food/foodmanager.hpp>
+#include <misc/profiler.hpp>
+
+
+/// Constructors and destructor
+PathfindingAIController::PathfindingAIController (const InGameSetup& setup)
+   :  AIController (setup)
+{
+}
+
+
+
+/// Testing functions
+bool PathfindingAIController::isEdible (const Cell& cell, const Snake& snake, const FoodManager& foodManager) const
+{
+   const int effect = foodManager.getFoodEffect (foodManager.getFoodHandle (cell));
+
+   return effect > 0 || snake.getSize() > (unsigned int) -effect;
+}
+
+
+
+/// Functionality
+/// Aim for the nearest food which always helps, any edible food found along the way ends the search
+bool PathfindingAIController::findGoal (const Snake& snake, const FoodManager& foodManager, Cell& modify) const
+{
+   unsigned int target = foodManager.findNearestFood (snake.getHead(), true);
+
+   if (target == FoodIndex::kNoFood)
+   {
+      target = foodManager.findNearestFood (snake.getHead(), false);
+
+      if (target == FoodIndex::kNoFood)
+      {
+         return false;
+      }
+   }
+
+   modify = foodManager.getFoodPosition (target);
+   return true;
+}
+
+
+/// A* with the wrapped Manhattan distance to the nearest food as the heuristic. Every step changes that distance by one
+/// so a cell's estimate either stays the same as its parent's or rises by two, which lets the open list be two stacks
+/// instead of a heap. Cells are closed as they're found, the path may occasionally be a step longer than the shortest
+/// but each cell is only handled once and the stacks never outgrow the level. Huge levels would make a search for food
+/// walled off from the Snake flood the entire level, so the search gives up after a budget relative to the distance
+/// and takes the first step towards the closest cell it found instead. Every cell remembers how many moves it is from
+/// the head so the path can cross a Snake part the DangerMap says will be gone by then, with some slack as the part
+/// stays longer if its Snake eats. A part which is still there isn't closed, a longer path may reach it once it's gone
+Movement PathfindingAIController::findPath (const Snake& snake, const FoodManager& foodManager, const Cell& goal)
+{
+   const Cell& head = snake.getHead();
+   const unsigned int width = m_kSetup.getGridWidth();
+   const unsigned int height = m_kSetup.getGridHeight();
+   const unsigned int headDistance = utility::getWrappedDistance (m_kSetup, head, goal);
+
+   unsigned int budget = getBudget (head, goal);
+   unsigned int bestDistance = headDistance;
+   Movement bestMove = Movement::Null;
+
+   auto& search = *m_pSearch;
+   auto& frontier = search.getFrontier();
+   auto& nextFrontier = search.getNextFrontier();
+
+   /// The first moves can't reverse into the Snake or lead into a dead end, after that every direction is considered
+   generateSafeMoves (m_moves);
+   search.beginSearch();
+
+   search.visit (search.getIndex (head), Movement::Null, 0);
+
+   for (const auto move : m_moves)
+   {
+      Cell next = head;
+      moveForward (next, move);
+
+      const unsigned int index = search.getIndex (next);
+
+      if (!m_pGrid->isOccupied (next))
+      {
+         if (!search.isVisited (index))
+         {
+            search.visit (index, move, 1);
+            const bool closer = utility::getWrappedDistance (m_kSetup, next, goal) < headDistance;
+            (closer ? frontier : nextFrontier).push_back (index);
+         }
+      }
+
+      else if (m_pGrid->isFoodHere (next) && isEdible (next, snake, foodManager))
+      {
+         return move;
+      }
+   }
+
+   static const int kOffsets[4][2] { {0, 1}, {-1, 0}, {1, 0}, {0, -1} };
+
+   /// Whether the Snake part in a cell will be gone by the move which arrives there
+   const auto hasCleared = [&] (const Cell& cell, const unsigned int arrival)
+   {
+      return m_pDangerMap && arrival >= kClearanceSlack &&
+             m_pDangerMap->getFirstSafeMove (cell) <= arrival - kClearanceSlack;
+   };
+
+   while ((!frontier.empty() || !nextFrontier.empty()) && budget-- != 0)
+   {
+      if (frontier.empty())
+      {
+         frontier.swap (nextFrontier);
+      }
+
+      const unsigned int current = frontier.back();
+      frontier.pop_back();
+
+      const Cell cell = search.getCell (current);
+      const unsigned int distance = utility::getWrappedDistance (m_kSetup, cell, goal);
+      const Movement firstMove = search.getFirstMove (current);
+      const unsigned int arrival = search.getDistance (current) + 1;
+
+      if (distance < bestDistance)
+      {
+         bestDistance = distance;
+         bestMove = firstMove;
+      }
+
+      for (const auto& offset : kOffsets)
+      {
+         const Cell next {(unsigned short) ((cell.x + width + offset[0]) % width),
+                          (unsigned short) ((cell.y + height + offset[1]) % height)};
+         const unsigned int index = search.getIndex (next);
+
+         if (search.isVisited (index))
+         {
+            continue;
+         }
+
+         if (!m_pGrid->isOccupied (next) || hasCleared (next, arrival))
+         {
+            search.visit (index, firstMove, arrival);
+            (utility::getWrappedDistance (m_kSetup, next, goal) < distance ? frontier : nextFrontier).push_back (index);
+         }
+
+         else if (m_pGrid->isFoodHere (next) && isEdible (next, snake, foodManager))
+         {
+            return firstMove;
+         }
+      }
+   }
+
+   // Every reachable cell was searched without finding edible food
+   if (frontier.empty() && nextFrontier.empty())
+   {
+      return Movement::Null;
+   }
+
+   return bestMove;
+}
+
+
+
+/// Getters
+unsigned int PathfindingAIController::getBudget (const Cell& head, const Cell& goal) const
+{
+   return kBudgetPerStep * utility::getWrappedDistance (m_kSetup, head, goal) + kBudgetBase;
+}
+
+
+Movement PathfindingAIController::getMove()
+{
+   const Profiler::Scope scope {Profiler::Phase::PathfindingMove};
+
+   const auto& snake = m_pkSnake.lock();
+   const auto& foodManager = m_pkFoodManager.lock();
+   const auto& obstacleManager = m_pkObstacleManager.lock();
+   const auto& snakeManager = m_pkSnakeManager.lock();
+
+   if (snake && foodManager && obstacleManager && snakeManager && m_pGrid && m_pSearch)
+   {
+      m_lastMove = snake->getLastMove();
+
+      Cell goal {0, 0};
+      const bool hasGoal = findGoal (*snake, *foodManager, goal);
+
+      /// Every ThinFood is edible once the Snake is bigger than the largest effect, until then only FatFood is. Food
+      /// far enough away for the search to be allowed the whole level is worth the field even without sharing it
+      const auto& field = snake->getSize() > foodManager->getFoodEffectMax() ? m_pFoodField : m_pFatFoodField;
+      const unsigned int cost = hasGoal ? getBudget (snake->getHead(), goal) : 0;
+      m_move = field && field->isWorthSearching (cost) ? descendField (*field, false) : Movement::Null;
+
+      // The field isn't worth searching or doesn't reach this far so search for a path instead
+      if (m_move == Movement::Null && hasGoal)
+      {
+         m_move = findPath (*snake, *foodManager, goal);
+      }
+
+      // No edible food can be reached
+      if (m_move == Movement::Null)
+      {
+         m_move = safeMove();
+      }
+   }
+
+   else // weak_ptrs are invalid
+   {
+      m_move = basicMove();
+   }
+
+   m_lastMove = m_move;
+   return m_move;
+}
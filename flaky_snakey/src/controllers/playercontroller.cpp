@@ -19,6 +19,7 @@
 
 
 #include <controllers/playercontroller.hpp>
+#include <misc/profiler.hpp>
 
 
 /// Constructors and destructor
@@ -83,6 +84,8 @@ bool PlayerController::onKey (const KeyEvent& keyEvent)
 /// Getters
 Movement PlayerController::getMove()
 {
+   const Profiler::Scope scope {Profiler::Phase::PlayerMove};
+
    // Although m_lastMove isn't used by PlayerController, set it anyway for future functionality expansion
    m_lastMove = m_move;
    return m_move;
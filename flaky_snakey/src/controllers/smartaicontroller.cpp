@@ -20,6 +20,7 @@
 
 #include <controllers/smartaicontroller.hpp>
 #include <food/foodmanager.hpp>
+#include <misc/profiler.hpp>
 
 
 
@@ -32,21 +33,11 @@ SmartAIController::SmartAIController(const InGameSetup& setup)
 
 // TODO: Make smarter, currently only avoids ThinFood that can kill and never switches preferred/secondary, need bigger difference than DumbAIController
 /// Functionality
-Movement SmartAIController::chaseFood (const Rectangle& head, const Rectangle& food)
+Movement SmartAIController::chaseFood (const Cell& head, const Cell& food)
 {
-   /// Improve efficiency by getting parameters
-   const unsigned int startX = m_kSetup.getStartX();
-   const unsigned int startY = m_kSetup.getStartY();
-   const unsigned int rectWidth = m_kSetup.getRectWidth();
-   const unsigned int rectHeight = m_kSetup.getRectHeight();
-
-   unsigned int headX = (head.getX() - startX) / rectWidth;
-   unsigned int headY = (head.getY() - startY) / rectHeight;
-   unsigned int foodX = (food.getX() - startX) / rectWidth;
-   unsigned int foodY = (food.getY() - startY) / rectHeight;
-
-   int diffX = foodX - headX;
-   int diffY = foodY - headY;
+   // The level wraps so the food may be closer going the other way
+   int diffX = utility::wrapDifference (food.x - head.x, m_kSetup.getGridWidth());
+   int diffY = utility::wrapDifference (food.y - head.y, m_kSetup.getGridHeight());
    Movement preferred, secondary;
 
 
@@ -62,24 +53,23 @@ Movement SmartAIController::chaseFood (const Rectangle& head, const Rectangle& f
    else                 { secondary = Movement::Right; }
 
 
-   std::vector<Movement> moves;
-   generateSafeMoves (moves);
+   generateSafeMoves (m_moves);
 
-   if (!moves.empty())
+   if (!m_moves.empty())
    {
-      if (exists (preferred, moves))
+      if (exists (preferred, m_moves))
       {
          return preferred;
       }
 
-      else if (exists (secondary, moves))
+      else if (exists (secondary, m_moves))
       {
          return secondary;
       }
 
       else
       {
-         return moves[rand() % moves.size()];
+         return m_moves[m_pRandom->next (m_moves.size())];
       }
    }
 
@@ -95,6 +85,8 @@ Movement SmartAIController::chaseFood (const Rectangle& head, const Rectangle& f
 /// Getters
 Movement SmartAIController::getMove()
 {
+   const Profiler::Scope scope {Profiler::Phase::SmartMove};
+
    const auto& snake = m_pkSnake.lock();
    const auto& foodManager = m_pkFoodManager.lock();
    const auto& obstacleManager = m_pkObstacleManager.lock();
@@ -104,28 +96,36 @@ Movement SmartAIController::getMove()
    {
       m_lastMove = snake->getLastMove();
       const auto head = snake->getHead();
-      Rectangle food = head;
+      unsigned int food = FoodIndex::kNoFood;
 
+      // Only follow FatFood to prevent death
       const unsigned int avoid = m_kSetup.getGridWidth() * m_kSetup.getGridHeight() * 0.01;
-      if (snake->getSize() <= avoid)
-      {
-         // Only look for FatFood to prevent death
-         food = foodManager->findNearestFood (head, true);
-      }
-      else
-      {
-         food = foodManager->findNearestFood (head, false);
-      }
+      const auto& field = snake->getSize() <= avoid ? m_pFatFoodField : m_pFoodField;
+      m_move = field && field->isWorthSearching() ? descendField (*field, false) : Movement::Null;
 
-      if (head != food)
-      {
-         m_move = chaseFood (head, food);
-      }
-
-      // No edible food available
-      else
+      // The field isn't shared by enough Snakes or doesn't reach this far so head straight for the nearest food
+      if (m_move == Movement::Null)
       {
-         m_move = safeMove();
+         if (snake->getSize() <= avoid)
+         {
+            // Only look for FatFood to prevent death
+            food = foodManager->findNearestFood (head, true);
+         }
+         else
+         {
+            food = foodManager->findNearestFood (head, false);
+         }
+
+         if (food != FoodIndex::kNoFood)
+         {
+            m_move = chaseFood (head, foodManager->getFoodPosition (food));
+         }
+
+         // No edible food available
+         else
+         {
+            m_move = safeMove();
+         }
       }
    }
 
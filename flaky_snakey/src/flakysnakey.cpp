@@ -25,7 +25,7 @@
 FlakySnakey::FlakySnakey()
    :  m_pSetup (std::make_shared<SnakeStateSetup>()),
       m_pMainMenu (new MainMenuState()), m_pConfig (new ConfigurationState()),
-      m_pMainGame (new MainSnakeState()), m_pPauseDemo (new DemoSnakeState())
+      m_pMainGame (new MainSnakeState()), m_pPauseDemo (new DemoSnakeState()), m_pReplay (new ReplayState())
 {
 }
 
@@ -112,7 +112,10 @@ bool FlakySnakey::initialise()
    /// Output controls
    std::cout << "\nControls:\n"
              << "Exit:\t \tESCAPE\n"
-             << "Pause:\t \tP\n\n"
+             << "Pause:\t \tP\n"
+             << "Save:\t \tS while paused\n"
+             << "Load:\t \tL while paused\n"
+             << "Replay:\t \tV once the game is over, then Space to pause, Left and Right to seek, Q to return\n\n"
              << "P1 Up:\t \tW\n"
              << "P1 Left: \tA\n"
              << "P1 Right: \tD\n"
@@ -141,14 +144,20 @@ bool FlakySnakey::initialise()
    m_pConfig->setSetup (m_pSetup);
    m_pMainGame->setSetup (m_pSetup);
    m_pPauseDemo->setSetup (m_pSetup);
+   m_pReplay->setSetup (m_pSetup);
 
    prg::application.addState ("menu", *m_pMainMenu);
    prg::application.addState ("config", *m_pConfig);
    prg::application.addState ("game", *m_pMainGame);
    prg::application.addState ("pause", *m_pPauseDemo);
+   prg::application.addState ("replay", *m_pReplay);
 
    prg::application.setState ("menu");
 
+   /// Every phase of the game is timed and reported on close()
+   Profiler::clear();
+   Profiler::setEnabled (true);
+
    return true;
 }
 
@@ -156,6 +165,23 @@ bool FlakySnakey::initialise()
 /// Perform shutdown process
 void FlakySnakey::close()
 {
+   if (Profiler::isEnabled())
+   {
+      Profiler::setEnabled (false);
+
+      prg::Log::Message profile (prg::Log::Message::LT_Info);
+      profile << "Time spent in each phase:\n";
+      Profiler::report (profile);
+      prg::logger.add (profile);
+
+      if (Profiler::isTickAllocating())
+      {
+         prg::Log::Message warning (prg::Log::Message::LT_Warning);
+         warning << "The game tick is allocating memory, it should reuse what the last tick used.\n";
+         prg::logger.add (warning);
+      }
+   }
+
    log (0, "Flaky Snakey closed successfully.");
 }
 
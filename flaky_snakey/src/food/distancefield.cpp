@@ -0,0 +1,109 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <food/distancefield.hpp>
+#include <misc/profiler.hpp>
+
+
+/// Constructors and destructor
+DistanceField::DistanceField (const InGameSetup& setup, const std::shared_ptr<const OccupancyGrid>& grid,
+                              const std::shared_ptr<const FoodManager>& foodManager, const bool fatFoodOnly)
+   :  m_kSetup (setup), m_pGrid (grid), m_pFoodManager (foodManager), m_kFatFoodOnly (fatFoodOnly), m_search (setup),
+      m_sources (0), m_askers (0), m_valid (false)
+{
+   // Pre-condition: The field needs the level and the food in it
+   if (!m_pGrid || !m_pFoodManager)
+   {
+      throw std::runtime_error ("Attempt to create DistanceField without an OccupancyGrid or FoodManager.");
+   }
+}
+
+
+
+/// Functionality
+/// Every food starts in the first frontier, each frontier holds the cells one move further than the last. Cells are
+/// marked as they're found so each is only handled once and its distance is final as soon as it's known. The frontiers
+/// hold packed co-ordinates rather than indices so a cell never has to be worked out from its index
+void DistanceField::refresh()
+{
+   if (m_valid)
+   {
+      return;
+   }
+
+   const Profiler::Scope scope {Profiler::Phase::DistanceField};
+   const unsigned short width = m_kSetup.getGridWidth();
+   const unsigned short height = m_kSetup.getGridHeight();
+
+   m_valid = true;
+
+   /// A search fills the level anyway, so the first one may as well make room for every cell
+   m_search.reserve (width * height);
+   m_search.beginSearch();
+
+   auto& frontier = m_search.getFrontier();
+   auto& nextFrontier = m_search.getNextFrontier();
+
+   m_pFoodManager->getFoodCells (m_sources, m_kFatFoodOnly);
+
+   for (const auto& source : m_sources)
+   {
+      const unsigned int index = m_search.getIndex (source);
+
+      m_search.visit (index, Movement::Null, 0);
+      frontier.push_back ((source.y << 16) | source.x);
+   }
+
+   for (unsigned int distance {1}; !frontier.empty(); ++distance)
+   {
+      for (unsigned int i {0}; i < frontier.size(); ++i)
+      {
+         const Cell cell {(unsigned short) (frontier[i] & 0xFFFF), (unsigned short) (frontier[i] >> 16)};
+         const Cell neighbours[4] { {cell.x, (unsigned short) (cell.y + 1 == height ? 0 : cell.y + 1)},
+                                    {(unsigned short) (cell.x == 0 ? width - 1 : cell.x - 1), cell.y},
+                                    {(unsigned short) (cell.x + 1 == width ? 0 : cell.x + 1), cell.y},
+                                    {cell.x, (unsigned short) (cell.y == 0 ? height - 1 : cell.y - 1)} };
+
+         for (const auto& next : neighbours)
+         {
+            const unsigned int index = m_search.getIndex (next);
+
+            if (!m_search.isVisited (index) && !m_pGrid->isOccupied (next))
+            {
+               m_search.visit (index, Movement::Null, distance);
+               nextFrontier.push_back ((next.y << 16) | next.x);
+            }
+         }
+      }
+
+      frontier.swap (nextFrontier);
+      nextFrontier.clear();
+   }
+}
+
+
+
+/// Getters
+unsigned int DistanceField::getDistance (const Cell& cell) const
+{
+   const unsigned int index = m_search.getIndex (cell);
+
+   return m_search.isVisited (index) ? m_search.getDistance (index) : kUnknown;
+}
@@ -23,16 +23,8 @@
 
 /// Constructors and destructor
 // Assign default values
-FatFood::FatFood (const Rectangle& rectangle, const prg::Colour& colour)
-   :  Food (rectangle, colour)
-{
-   m_foodEffect = 1;
-}
-
-
-FatFood::FatFood (const unsigned short timerID, const unsigned int milliseconds,
-                  const Rectangle& rectangle, const prg::Colour& colour)
-   :  Food (timerID, milliseconds, rectangle, colour)
+FatFood::FatFood (const Cell& cell, const prg::Colour& colour)
+   :  Food (cell, colour)
 {
    m_foodEffect = 1;
 }
@@ -41,7 +33,7 @@ FatFood::FatFood (const unsigned short timerID, const unsigned int milliseconds,
 
 /// Assignment functions
 // Trust is placed in the programmer not to abuse effectMax
-void FatFood::setFoodEffect (unsigned int effectMin, unsigned int effectMax)
+void FatFood::setFoodEffect (unsigned int effectMin, unsigned int effectMax, Random& random)
 {
    // Pre-condition: Guarantee parameters won't cause truncation issues
    unsigned int intMax = std::numeric_limits<int>::max();
@@ -60,7 +52,7 @@ void FatFood::setFoodEffect (unsigned int effectMin, unsigned int effectMax)
    // Calculate food effect
    if (effectMin < effectMax)
    {
-      m_foodEffect = rand() % (effectMax - effectMin) + effectMin;
+      m_foodEffect = random.next (effectMax - effectMin) + effectMin;
    }
 
    else if (effectMin == effectMax)
@@ -70,6 +62,6 @@ void FatFood::setFoodEffect (unsigned int effectMin, unsigned int effectMax)
 
    else // If effectMin > effectMax, handle error by swapping values
    {
-      m_foodEffect = rand() % (effectMin - effectMax) + effectMax;
+      m_foodEffect = random.next (effectMin - effectMax) + effectMax;
    }
 }
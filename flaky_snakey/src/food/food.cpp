@@ -19,53 +19,28 @@
 
 
 #include <food/food.hpp>
+#include <misc/snakeutilities.hpp>
 
 
 /// Constructors and destructor
 // Assign default values
-Food::Food (const Rectangle& rectangle, const prg::Colour& colour)
-   :  Obstacle (rectangle, colour),
-      m_timer (),
-      m_rotten (false), m_foodEffect (0)
+Food::Food (const Cell& cell, const prg::Colour& colour)
+   :  Obstacle (cell, colour),
+      m_foodEffect (0)
 {
 }
 
 
-Food::Food (const unsigned short timerID, const unsigned int milliseconds,
-            const Rectangle& rectangle, const prg::Colour& colour)
-   :  Obstacle (rectangle, colour),
-      m_timer (timerID, milliseconds, *this),
-      m_rotten (false), m_foodEffect (0)
-{
-   m_timer.start();
-}
-
-
 
 /// Functionality
-void Food::pause()
-{
-   m_timer.stop();
-}
-
-
-void Food::resume()
-{
-   /// 255 indicates that the Timer is invalid, prevent access violation errors by testing for it
-   if (m_timer.getID() != 255)
-   {
-      m_timer.start();
-   }
-}
-
-
-void Food::draw (prg::Canvas& canvas)
+void Food::draw (prg::Canvas& canvas, const InGameSetup& projection) const
 {
    /// Get parameters for the sake of efficiency
-   const unsigned int x = getRectangle().getX();
-   const unsigned int y = getRectangle().getY();
-   const unsigned int width = getRectangle().getWidth();
-   const unsigned int height = getRectangle().getHeight();
+   const Rectangle rectangle = utility::toRectangle (projection, m_kCell);
+   const unsigned int x = rectangle.getX();
+   const unsigned int y = rectangle.getY();
+   const unsigned int width = rectangle.getWidth();
+   const unsigned int height = rectangle.getHeight();
 
    /*                       ____
                            /    \
@@ -117,9 +92,3 @@ void Food::draw (prg::Canvas& canvas)
                     x + width * 0.75,  y,                   m_kColour);
 }
 
-
-void Food::onTimer (prg::Timer& timer)
-{
-   timer.stop();
-   m_rotten = true;
-}
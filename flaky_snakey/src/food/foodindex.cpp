@@ -0,0 +1,213 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <food/foodindex.hpp>
+
+
+/// STL
+#include <algorithm> // std::max and std::min
+#include <cstdlib>   // std::abs
+#include <stdexcept> // insert()
+
+
+/// Personal
+#include <misc/snakeutilities.hpp> // getWrappedDistance()
+
+
+/// Constructors and destructor
+/// Buckets are square with power of two sides so finding one is a shift, they never get smaller than 4x4 cells
+FoodIndex::FoodIndex (const InGameSetup& setup, const unsigned int expected)
+   :  m_kSetup (setup), m_bucketShift (2), m_bucketsX (0), m_bucketsY (0), m_buckets (0), m_size (0)
+{
+   const unsigned int area = setup.getGridWidth() * setup.getGridHeight();
+   const unsigned int cellsPerItem = area / std::max (expected, 1u);
+
+   while (m_bucketShift < 12 && (1u << (m_bucketShift * 2)) < cellsPerItem)
+   {
+      ++m_bucketShift;
+   }
+
+   m_bucketsX = (setup.getGridWidth() + (1u << m_bucketShift) - 1) >> m_bucketShift;
+   m_bucketsY = (setup.getGridHeight() + (1u << m_bucketShift) - 1) >> m_bucketShift;
+   m_buckets.resize (m_bucketsX * m_bucketsY);
+
+   /// Buckets are sized to hold about one item each, room for a few means inserting rarely has to allocate
+   for (auto& bucket : m_buckets)
+   {
+      bucket.reserve (4);
+   }
+}
+
+
+
+/// Functionality
+/// Buckets are searched in square rings around the cell, stopping once no unvisited bucket could hold anything closer
+unsigned int FoodIndex::findNearest (const Cell& cell) const
+{
+   if (m_size == 0)
+   {
+      return kNoFood;
+   }
+
+   /// Offsets are kept within half of the buckets either way, around the wrap each bucket is then visited only once
+   const int lowX = -(int) ((m_bucketsX - 1) / 2);
+   const int highX = m_bucketsX / 2;
+   const int lowY = -(int) ((m_bucketsY - 1) / 2);
+   const int highY = m_bucketsY / 2;
+   const int lastRing = std::max (std::max (-lowX, highX), std::max (-lowY, highY));
+
+   const int bucketX = cell.x >> m_bucketShift;
+   const int bucketY = cell.y >> m_bucketShift;
+   const unsigned int bucketSize = 1u << m_bucketShift;
+
+   unsigned int nearest = kNoFood;
+   unsigned int nearestDistance = std::numeric_limits<unsigned int>::max();
+
+   auto search = [&] (const int offsetX, const int offsetY)
+   {
+      const unsigned int x = (bucketX + offsetX + m_bucketsX) % m_bucketsX;
+      const unsigned int y = (bucketY + offsetY + m_bucketsY) % m_bucketsY;
+
+      for (const auto& entry : m_buckets[y * m_bucketsX + x])
+      {
+         const unsigned int distance = utility::getWrappedDistance (m_kSetup, cell, entry.cell);
+
+         if (distance < nearestDistance || (distance == nearestDistance && entry.handle < nearest))
+         {
+            nearest = entry.handle;
+            nearestDistance = distance;
+         }
+      }
+   };
+
+   for (int ring {0}; ring <= lastRing; ++ring)
+   {
+      // A bucket r rings away is at least r - 1 buckets away, one of which may be a partial bucket at the edge
+      if (ring >= 2 && (ring - 2) * bucketSize + 1 > nearestDistance)
+      {
+         break;
+      }
+
+      for (int offsetY {std::max (-ring, lowY)}; offsetY <= std::min (ring, highY); ++offsetY)
+      {
+         /// The top and bottom rows of a ring are searched fully, every other row only has its two ends
+         if (std::abs (offsetY) == ring)
+         {
+            for (int offsetX {std::max (-ring, lowX)}; offsetX <= std::min (ring, highX); ++offsetX)
+            {
+               search (offsetX, offsetY);
+            }
+         }
+
+         else
+         {
+            if (-ring >= lowX)
+            {
+               search (-ring, offsetY);
+            }
+
+            if (ring <= highX)
+            {
+               search (ring, offsetY);
+            }
+         }
+      }
+   }
+
+   return nearest;
+}
+
+
+
+/// Assignment functions
+void FoodIndex::insert (const Cell& cell, const unsigned int handle)
+{
+   // Pre-condition: The cell is inside the level
+   if (cell.x >= m_kSetup.getGridWidth() || cell.y >= m_kSetup.getGridHeight())
+   {
+      throw std::runtime_error ("Attempt to index food outside of the level in FoodIndex::insert().");
+   }
+
+   Entry entry;
+   entry.cell = cell;
+   entry.handle = handle;
+
+   m_buckets[getBucketIndex (cell)].push_back (entry);
+   ++m_size;
+}
+
+
+/// Order within a bucket doesn't matter so the last entry is swapped into the gap
+void FoodIndex::remove (const Cell& cell, const unsigned int handle)
+{
+   if (cell.x < m_kSetup.getGridWidth() && cell.y < m_kSetup.getGridHeight())
+   {
+      auto& bucket = m_buckets[getBucketIndex (cell)];
+
+      for (auto& entry : bucket)
+      {
+         if (entry.handle == handle)
+         {
+            entry = bucket.back();
+            bucket.pop_back();
+            --m_size;
+            return;
+         }
+      }
+   }
+}
+
+
+/// Buckets keep their capacity so refilling the index doesn't allocate
+void FoodIndex::clear()
+{
+   for (auto& bucket : m_buckets)
+   {
+      bucket.clear();
+   }
+
+   m_size = 0;
+}
+
+
+
+/// Getters
+/// Returns kNoFood if nothing is stored in the cell
+unsigned int FoodIndex::getHandle (const Cell& cell) const
+{
+   if (cell.x < m_kSetup.getGridWidth() && cell.y < m_kSetup.getGridHeight())
+   {
+      for (const auto& entry : m_buckets[getBucketIndex (cell)])
+      {
+         if (entry.cell == cell)
+         {
+            return entry.handle;
+         }
+      }
+   }
+
+   return kNoFood;
+}
+
+
+unsigned int FoodIndex::getBucketIndex (const Cell& cell) const
+{
+   return (cell.y >> m_bucketShift) * m_bucketsX + (cell.x >> m_bucketShift);
+}
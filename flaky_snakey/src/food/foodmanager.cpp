@@ -19,15 +19,17 @@
 
 
 #include <food/foodmanager.hpp>
+#include <misc/profiler.hpp>
 
 
 /// Indicate the FoodManager is ready for food to be spawned
-FoodManager::FoodManager (const InGameSetup& setup, const unsigned int rotInterval,
-                          const unsigned int foodMin, const unsigned int foodMax, const bool demoMode)
-   :  m_kSetup (setup), m_kFoodMin (foodMin), m_kFoodMax (foodMax), m_kRotInterval (rotInterval),
-      m_foodP (0),
-      m_timerID (2), m_timerCount (0), m_foodEffectMax (1),
-      m_spawnRequired (false), m_demoMode (demoMode)
+FoodManager::FoodManager (const InGameSetup& setup, const std::shared_ptr<OccupancyGrid>& grid,
+                          const std::shared_ptr<Random>& random, const unsigned int rotTicks,
+                          const unsigned int foodMin, const unsigned int foodMax)
+   :  m_kSetup (setup), m_kFoodMin (foodMin), m_kFoodMax (foodMax), m_kRotTicks (rotTicks),
+      m_pGrid (grid), m_pRandom (random), m_foodP (0), m_handles (0), m_slots (0), m_freeHandles (0),
+      m_allFood (setup, foodMax), m_fatFood (setup, foodMax), m_rotWheel(), m_rotten (0),
+      m_foodAllocator (std::make_shared<BlockPool>()), m_foodEffectMax (1), m_spawnRequired (false)
 {
    // Pre-condition: Ensure min can't be > max
    if (foodMin > foodMax)
@@ -35,9 +37,29 @@ FoodManager::FoodManager (const InGameSetup& setup, const unsigned int rotInterv
       throw std::runtime_error ("foodMin > foodMax in FoodManager(), shoot the programmer.");
    }
 
+   // Pre-condition: Food must be able to be recorded
+   if (!m_pGrid)
+   {
+      throw std::runtime_error ("Attempt to create FoodManager without an OccupancyGrid.");
+   }
+
+   // Pre-condition: Spawning needs random numbers
+   if (!m_pRandom)
+   {
+      throw std::runtime_error ("Attempt to create FoodManager without a Random engine.");
+   }
+
    // Max food effect is 1% of total grid size
    m_foodEffectMax = m_kSetup.getGridWidth() * m_kSetup.getGridHeight() * 0.01;
 
+   /// There's never more than foodMax food or handles, making room now means spawning and rotting never allocate
+   m_foodP.reserve (foodMax);
+   m_handles.reserve (foodMax);
+   m_slots.reserve (foodMax);
+   m_freeHandles.reserve (foodMax);
+   m_rotten.reserve (foodMax);
+   m_rotWheel.reserve (foodMax);
+
    if (m_foodP.size() < m_kFoodMin)
    {
       m_spawnRequired = true;
@@ -45,60 +67,28 @@ FoodManager::FoodManager (const InGameSetup& setup, const unsigned int rotInterv
 }
 
 
-FoodManager::~FoodManager()
-{
-   pause();
-}
-
-
-
 /// Testing functions
-bool FoodManager::isFoodHere (const Rectangle& rect) const
+bool FoodManager::isFoodHere (const Cell& cell) const
 {
-   /// Simply check the vector for intersecting rectangles
-   for (const auto& food : m_foodP)
-   {
-      if (rect.intersects (food->getRectangle()))
-      {
-         return true;
-      }
-   }
-
-   return false;
+   return m_pGrid->isFoodHere (cell);
 }
 
 
 
 /// Functionality
 // Basic game facilities
-void FoodManager::pause()
+/// Called once per tick
+void FoodManager::update()
 {
-   for (const auto& food : m_foodP)
-   {
-      food->pause();
-   }
-}
+   const Profiler::Scope scope {Profiler::Phase::FoodUpdate};
 
+   /// Only food whose deadline has come round is touched
+   m_rotten.clear();
+   m_rotWheel.advance (m_rotten);
 
-void FoodManager::resume()
-{
-   for (const auto& food : m_foodP)
+   for (const auto handle : m_rotten)
    {
-      food->resume();
-   }
-}
-
-
-void FoodManager::update()
-{
-   /// Check if any food is rotten
-   for (unsigned int i {0}; i < m_foodP.size(); ++i)
-   {
-      if (m_foodP[i]->isRotten())
-      {
-         m_foodP.erase (m_foodP.begin() + i--);
-         --m_timerCount;
-      }
+      eraseFood (getFoodIndex (handle, "update"));
    }
 
    /// Check if the minimum amount of food exists
@@ -111,7 +101,7 @@ void FoodManager::update()
    else if (m_foodP.size() < m_kFoodMax)
    {
       /// 1% chance per 64 cells (8x8) for food to spawn
-      if (rand() % 1000 < (m_kSetup.getGridWidth() * m_kSetup.getGridHeight() / 64.0))
+      if (m_pRandom->next (1000) < (m_kSetup.getGridWidth() * m_kSetup.getGridHeight() / 64.0))
       {
          m_spawnRequired = true;
       }
@@ -121,106 +111,83 @@ void FoodManager::update()
 
 void FoodManager::drawFood (prg::Canvas& canvas)
 {
+   const Profiler::Scope scope {Profiler::Phase::DrawFood};
+
    /// Simply call draw on all Food objects
    for (const auto& food : m_foodP)
    {
-      food->draw (canvas);
+      food->draw (canvas, m_kSetup);
    }
 }
 
 
 // AI facilities
-const Rectangle FoodManager::findNearestFood (const Rectangle& rect, const bool fatFoodOnly) const
+/// Returns the handle of the nearest food around the wrapping level, FoodIndex::kNoFood if none is suitable
+unsigned int FoodManager::findNearestFood (const Cell& cell, const bool fatFoodOnly) const
 {
-   // Pre-condition: Food is available
-   if (m_foodP.empty()) { return rect; }
-
-   /// Reduce function calls by obtaining constantly accessed data
-   const unsigned int rectWidth = m_kSetup.getRectWidth();
-   const unsigned int rectHeight = m_kSetup.getRectHeight();
-   const unsigned int startX = m_kSetup.getStartX();
-   const unsigned int startY = m_kSetup.getStartY();
-   const unsigned int rectX = (rect.getX() - startX) / rectWidth;
-   const unsigned int rectY = (rect.getY() - startY) / rectHeight;
-
-   // Create some fail-safe defaults
-   Rectangle closest = rect;
-   unsigned int closestTotal = std::numeric_limits<unsigned int>::max();
-
-   unsigned int tempX, tempY, diffX, diffY, diffTotal;
-   for (const auto& food : m_foodP)
-   {
-      if (!fatFoodOnly || food->getFoodEffect() > 0)
-      {
-         /// Obtain food co-ordinates on the grid
-         tempX = (food->getRectangle().getX() - startX) / rectWidth;
-         tempY = (food->getRectangle().getY() - startY) / rectHeight;
-
-         /// Determine difference, maintain positive numbers
-         if (rectX > tempX) { diffX = rectX - tempX; }
-
-         else { diffX = tempX - rectX; }
-
-         if (rectY > tempY) { diffY = rectY - tempY; }
-
-         else { diffY = tempY - rectY; }
-
-         /// Compare values
-         diffTotal = diffX + diffY;
-
-         if (diffTotal < closestTotal)
-         {
-            closest = food->getRectangle();
-            closestTotal = diffTotal;
-         }
-      }
-   }
-
-   return closest;
+   return fatFoodOnly ? m_fatFood.findNearest (cell) : m_allFood.findNearest (cell);
 }
 
 
 
 /// Assignment functions
-/// Relies on being passed a rectangle containing a valid spawn location
-void FoodManager::addFood (const Rectangle& rect)
+/// Relies on being passed a cell containing a valid spawn location
+void FoodManager::addFood (const Cell& cell)
 {
    // FoodManager has no idea what other manager classes exist so it has to assume it's being passed a valid location
    // to spawn food. Therefore, it can only check against its own food locations.
-   if (isFoodHere (rect))
+   if (isFoodHere (cell))
    {
       throw std::runtime_error ("Attempt to spawn Food in occupied cell, shoot the programmer.");
    }
 
-   std::unique_ptr<Food> food;
-   const unsigned int rng = rand() % 100;
+   std::shared_ptr<Food> food;
+   const unsigned int rng = m_pRandom->next (100);
 
    /// 75% chance for spawning FatFood
-   if (rng < 75 || m_timerCount == 6)
+   if (rng < 75)
    {
-      food.reset (new FatFood {rect});
+      food = std::allocate_shared<FatFood> (m_foodAllocator, cell);
    }
 
    /// 25% chance for spawning ThinFood
    else
    {
-      if (!m_demoMode)
-      {
-         /// EXTENDED GAME RULE: ThinFood rot in 5 seconds
-         food.reset (new ThinFood {m_timerID++, m_kRotInterval, rect});
-         ++m_timerCount;
+      food = std::allocate_shared<ThinFood> (m_foodAllocator, cell);
+   }
 
-         // 0 and 1 are reserved for SnakeManager
-         if (m_timerID < 2 || m_timerID == 255) { m_timerID = 2; }
-      }
-      else
-      {
-         food.reset (new ThinFood {rect});
-      }
+   food->setFoodEffect (1, m_foodEffectMax, *m_pRandom);
+
+   /// Reuse a handle if one is free
+   unsigned int handle = m_slots.size();
+
+   if (m_freeHandles.empty())
+   {
+      m_slots.push_back (m_foodP.size());
+   }
+
+   else
+   {
+      handle = m_freeHandles.back();
+      m_freeHandles.pop_back();
+      m_slots[handle] = m_foodP.size();
+   }
+
+   m_allFood.insert (cell, handle);
+
+   if (food->getFoodEffect() > 0)
+   {
+      m_fatFood.insert (cell, handle);
    }
 
-   food->setFoodEffect (1, m_foodEffectMax);
+   /// EXTENDED GAME RULE: ThinFood rots after m_kRotTicks
+   if (food->getFoodEffect() < 0 && m_kRotTicks != 0)
+   {
+      m_rotWheel.schedule (handle, m_rotWheel.getTick() + m_kRotTicks);
+   }
 
+   m_pGrid->setFood (cell, true);
+   m_handles.push_back (handle);
    m_foodP.push_back (std::move (food));
 
    if (m_foodP.size() >= m_kFoodMin)
@@ -230,59 +197,124 @@ void FoodManager::addFood (const Rectangle& rect)
 }
 
 
-void FoodManager::removeFood (const unsigned int index)
+void FoodManager::removeFood (const unsigned int handle)
 {
-   // Pre-condition: index won't cause an out of bounds error
-   if (index > m_foodP.size())
+   eraseFood (getFoodIndex (handle, "removeFood"));
+}
+
+
+void FoodManager::save (Snapshot& modify) const
+{
+   modify.m_foodP = m_foodP;
+   modify.m_handles = m_handles;
+   modify.m_slots = m_slots;
+   modify.m_freeHandles = m_freeHandles;
+   modify.m_rotWheel = m_rotWheel;
+   modify.m_spawnRequired = m_spawnRequired;
+}
+
+
+/// The indices can't be copied so the current food is taken out of them and the saved food put back in, this only
+/// costs as much as the food there is rather than the size of the level
+void FoodManager::restore (const Snapshot& snapshot)
+{
+   for (unsigned int i {0}; i < m_foodP.size(); ++i)
    {
-      throw std::runtime_error ("Out of bounds error in FoodManager::removeFood(), shoot the programmer.");
+      m_allFood.remove (m_foodP[i]->getCell(), m_handles[i]);
+      m_fatFood.remove (m_foodP[i]->getCell(), m_handles[i]);
+   }
+
+   m_foodP = snapshot.m_foodP;
+   m_handles = snapshot.m_handles;
+   m_slots = snapshot.m_slots;
+   m_freeHandles = snapshot.m_freeHandles;
+   m_rotWheel = snapshot.m_rotWheel;
+   m_spawnRequired = snapshot.m_spawnRequired;
+
+   for (unsigned int i {0}; i < m_foodP.size(); ++i)
+   {
+      m_allFood.insert (m_foodP[i]->getCell(), m_handles[i]);
+
+      if (m_foodP[i]->getFoodEffect() > 0)
+      {
+         m_fatFood.insert (m_foodP[i]->getCell(), m_handles[i]);
+      }
    }
+}
+
+
+/// Removes the food stored at index of m_foodP, the last food takes its place
+void FoodManager::eraseFood (const unsigned int index)
+{
+   const auto& food = m_foodP[index];
+   const unsigned int handle = m_handles[index];
+
+   m_pGrid->setFood (food->getCell(), false);
+   m_allFood.remove (food->getCell(), handle);
+   m_fatFood.remove (food->getCell(), handle);
+   m_rotWheel.cancel (handle);
 
-   if (m_foodP[index]->getTimerID() != 255)
+   m_slots[handle] = FoodIndex::kNoFood;
+   m_freeHandles.push_back (handle);
+
+   // shared_ptr takes care of deallocation once no Snapshot holds the Food either
+   if (index != m_foodP.size() - 1)
    {
-      --m_timerCount;
+      m_foodP[index] = std::move (m_foodP.back());
+      m_handles[index] = m_handles.back();
+      m_slots[m_handles[index]] = index;
    }
 
-   // unique_ptr takes care of deallocation
-   m_foodP.erase (m_foodP.begin() + index);
+   m_foodP.pop_back();
+   m_handles.pop_back();
 }
 
 
 
 /// Getters
-/// Returns maximum unsigned int if invalid
-unsigned int FoodManager::getFoodIndex (const Rectangle& position) const
+/// Returns FoodIndex::kNoFood if there's no food in the cell
+unsigned int FoodManager::getFoodHandle (const Cell& position) const
 {
-   for (unsigned int i {0}; i < m_foodP.size(); ++i)
-   {
-      if (position == m_foodP[i]->getRectangle())
-      {
-         return i;
-      }
-   }
+   return m_allFood.getHandle (position);
+}
 
-   return std::numeric_limits<unsigned int>::max();
+
+int FoodManager::getFoodEffect (const unsigned int handle) const
+{
+   return m_foodP[getFoodIndex (handle, "getFoodEffect")]->getFoodEffect();
 }
 
 
-int FoodManager::getFoodEffect (const unsigned int index) const
+const Cell& FoodManager::getFoodPosition (const unsigned int handle) const
 {
-   // Pre-condition: index won't cause an out of bounds error
-   if (index > m_foodP.size())
+   return m_foodP[getFoodIndex (handle, "getFoodPosition")]->getCell();
+}
+
+
+/// Fills modify with the cell of every food, or only FatFood, anything already in modify is replaced
+void FoodManager::getFoodCells (std::vector<Cell>& modify, const bool fatFoodOnly) const
+{
+   modify.clear();
+
+   for (const auto& food : m_foodP)
    {
-      throw std::runtime_error ("Out of bounds error in FoodManager::getFoodEffect(), shoot the programmer.");
+      if (!fatFoodOnly || food->getFoodEffect() > 0)
+      {
+         modify.push_back (food->getCell());
+      }
    }
-
-   return m_foodP[index]->getFoodEffect();
 }
 
-const Rectangle& FoodManager::getFoodPosition (const unsigned int index) const
+
+/// Converts a handle into an index of m_foodP, throws if the handle doesn't refer to food
+unsigned int FoodManager::getFoodIndex (const unsigned int handle, const char* caller) const
 {
-   // Pre-condition: index won't cause an out of bounds error
-   if (index > m_foodP.size())
+   // Pre-condition: handle refers to existing food
+   if (handle >= m_slots.size() || m_slots[handle] == FoodIndex::kNoFood)
    {
-      throw std::runtime_error ("Out of bounds error in FoodManager::getFoodPosition(), shoot the programmer.");
+      throw std::runtime_error (std::string ("Invalid food handle in FoodManager::") + caller +
+                                "(), shoot the programmer.");
    }
 
-   return m_foodP[index]->getRectangle();
+   return m_slots[handle];
 }
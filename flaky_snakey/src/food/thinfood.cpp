@@ -23,24 +23,17 @@
 
 /// Constructors and destructor
 // Assign default values
-ThinFood::ThinFood (const Rectangle& rectangle, const prg::Colour& colour)
-   :  Food (rectangle, colour)
+ThinFood::ThinFood (const Cell& cell, const prg::Colour& colour)
+   :  Food (cell, colour)
 {
    m_foodEffect = -1;
 }
 
 
-ThinFood::ThinFood (const unsigned short timerID, const unsigned int milliseconds,
-                    const Rectangle& rectangle, const prg::Colour& colour)
-   :  Food (timerID, milliseconds, rectangle, colour)
-{
-   m_foodEffect = -1;
-}
-
 
 /// Functionality
 // Trust is placed in the programmer not to abuse effectMax
-void ThinFood::setFoodEffect (unsigned int effectMin, unsigned int effectMax)
+void ThinFood::setFoodEffect (unsigned int effectMin, unsigned int effectMax, Random& random)
 {
    // Pre-condition: Guarantee parameters won't cause truncation issues
    unsigned int intMax = std::numeric_limits<int>::max();
@@ -59,7 +52,7 @@ void ThinFood::setFoodEffect (unsigned int effectMin, unsigned int effectMax)
    // Calculate food effect
    if (effectMin < effectMax)
    {
-      m_foodEffect = -1 * (rand() % (effectMax - effectMin) + effectMin);
+      m_foodEffect = -1 * (random.next (effectMax - effectMin) + effectMin);
    }
 
    else if (effectMin == effectMax)
@@ -69,6 +62,6 @@ void ThinFood::setFoodEffect (unsigned int effectMin, unsigned int effectMax)
 
    else // If effectMin > effectMax, handle error by swapping values
    {
-      m_foodEffect = -1 * (rand() % (effectMin - effectMax) + effectMax);
+      m_foodEffect = -1 * (random.next (effectMin - effectMax) + effectMax);
    }
 }
@@ -0,0 +1,135 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <misc/allocationcounter.hpp>
+
+
+/// STL
+#include <cstdlib>   // std::malloc and std::free
+#include <new>       // The replaced operators
+
+
+
+#ifdef FLAKY_COUNT_ALLOCATIONS
+
+namespace
+{
+   /// Each thread counts its own allocations so counting never needs synchronising
+   thread_local std::uint64_t allocations {0};
+
+
+   void* allocate (const std::size_t size)
+   {
+      ++allocations;
+
+      /// malloc may return nullptr for 0 bytes but new never can
+      return std::malloc (size != 0 ? size : 1);
+   }
+}
+
+
+/// The replacements every other form of new and delete is built on
+void* operator new (const std::size_t size)
+{
+   void* const memory = allocate (size);
+
+   if (!memory)
+   {
+      throw std::bad_alloc();
+   }
+
+   return memory;
+}
+
+
+void* operator new[] (const std::size_t size)
+{
+   return operator new (size);
+}
+
+
+void* operator new (const std::size_t size, const std::nothrow_t&) noexcept
+{
+   return allocate (size);
+}
+
+
+void* operator new[] (const std::size_t size, const std::nothrow_t&) noexcept
+{
+   return allocate (size);
+}
+
+
+void operator delete (void* memory) noexcept
+{
+   std::free (memory);
+}
+
+
+void operator delete[] (void* memory) noexcept
+{
+   std::free (memory);
+}
+
+
+void operator delete (void* memory, const std::nothrow_t&) noexcept
+{
+   std::free (memory);
+}
+
+
+void operator delete[] (void* memory, const std::nothrow_t&) noexcept
+{
+   std::free (memory);
+}
+
+
+
+/// Testing functions
+bool AllocationCounter::isAvailable()
+{
+   return true;
+}
+
+
+
+/// Getters
+std::uint64_t AllocationCounter::getCount()
+{
+   return allocations;
+}
+
+#else
+
+/// Testing functions
+bool AllocationCounter::isAvailable()
+{
+   return false;
+}
+
+
+
+/// Getters
+std::uint64_t AllocationCounter::getCount()
+{
+   return 0;
+}
+
+#endif // FLAKY_COUNT_ALLOCATIONS
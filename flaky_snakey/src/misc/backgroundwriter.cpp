@@ -0,0 +1,139 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <misc/backgroundwriter.hpp>
+
+
+/// Constructors and destructor
+BackgroundWriter::BackgroundWriter (const std::string& path, const bool append, const std::size_t bufferSize)
+   :  m_kBufferSize (bufferSize), m_file (path, std::ios::binary | (append ? std::ios::app : std::ios::trunc)),
+      m_buffer (0), m_pending (0), m_writing (0), m_mutex(), m_ready(), m_done(), m_closing (false),
+      m_failed (false), m_thread()
+{
+   // Pre-condition: The file can be written to
+   if (!m_file)
+   {
+      throw std::runtime_error ("BackgroundWriter was unable to open \"" + path + "\".");
+   }
+
+   m_buffer.reserve (m_kBufferSize);
+   m_pending.reserve (m_kBufferSize);
+   m_writing.reserve (m_kBufferSize);
+
+   m_thread = std::thread (&BackgroundWriter::run, this);
+}
+
+
+BackgroundWriter::~BackgroundWriter()
+{
+   stop();
+}
+
+
+
+/// Functionality
+void BackgroundWriter::write (const void* data, const std::size_t size)
+{
+   std::unique_lock<std::mutex> lock {m_mutex};
+
+   // Pre-condition: The file is still open
+   if (m_closing)
+   {
+      throw std::runtime_error ("Attempt to write to a BackgroundWriter after close().");
+   }
+
+   const char* bytes = static_cast<const char*> (data);
+   m_buffer.insert (m_buffer.end(), bytes, bytes + size);
+
+   /// Only wait for the disk if it hasn't taken the last full buffer yet
+   if (m_buffer.size() >= m_kBufferSize)
+   {
+      m_done.wait (lock, [this] () { return m_pending.empty(); });
+
+      m_buffer.swap (m_pending);
+      m_ready.notify_one();
+   }
+}
+
+
+void BackgroundWriter::close()
+{
+   stop();
+
+   std::lock_guard<std::mutex> lock {m_mutex};
+
+   if (m_failed)
+   {
+      throw std::runtime_error ("BackgroundWriter was unable to write everything to the file.");
+   }
+}
+
+
+/// Each buffer is swapped with m_writing so the disk is written to without holding the lock
+void BackgroundWriter::run()
+{
+   std::unique_lock<std::mutex> lock {m_mutex};
+
+   while (true)
+   {
+      m_ready.wait (lock, [this] () { return !m_pending.empty() || m_closing; });
+
+      if (m_pending.empty())
+      {
+         break;
+      }
+
+      m_writing.swap (m_pending);
+      m_done.notify_all();
+      lock.unlock();
+
+      m_file.write (m_writing.data(), m_writing.size());
+      m_writing.clear();
+
+      lock.lock();
+      m_failed = m_failed || !m_file;
+   }
+
+   m_file.flush();
+   m_failed = m_failed || !m_file;
+}
+
+
+/// Hands over the last buffer and waits for m_thread to finish, does nothing the second time
+void BackgroundWriter::stop()
+{
+   {
+      std::unique_lock<std::mutex> lock {m_mutex};
+
+      if (!m_closing)
+      {
+         m_done.wait (lock, [this] () { return m_pending.empty(); });
+
+         m_buffer.swap (m_pending);
+         m_closing = true;
+         m_ready.notify_one();
+      }
+   }
+
+   if (m_thread.joinable())
+   {
+      m_thread.join();
+   }
+}
@@ -0,0 +1,97 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <misc/blockpool.hpp>
+
+
+/// STL
+#include <new> // ::operator new
+
+
+
+/// Constructors and destructor
+BlockPool::BlockPool()
+   :  m_free (0)
+{
+}
+
+
+/// Every block in use holds a PoolAllocator which keeps the pool alive, so only free blocks are left
+BlockPool::~BlockPool()
+{
+   for (const auto& list : m_free)
+   {
+      for (const auto block : list.blocks)
+      {
+         ::operator delete (block);
+      }
+   }
+}
+
+
+
+/// Functionality
+void* BlockPool::allocate (const std::size_t size)
+{
+   auto& list = getFreeList (size);
+
+   if (list.blocks.empty())
+   {
+      /// Make room for every block now so deallocate() never has to allocate, it can't be allowed to throw
+      if (list.count == list.blocks.capacity())
+      {
+         list.blocks.reserve (list.count * 2 + 1);
+      }
+
+      void* const block = ::operator new (size);
+      ++list.count;
+
+      return block;
+   }
+
+   void* const block = list.blocks.back();
+   list.blocks.pop_back();
+
+   return block;
+}
+
+
+void BlockPool::deallocate (void* block, const std::size_t size)
+{
+   getFreeList (size).blocks.push_back (block);
+}
+
+
+
+/// Getters
+BlockPool::FreeList& BlockPool::getFreeList (const std::size_t size)
+{
+   for (auto& list : m_free)
+   {
+      if (list.size == size)
+      {
+         return list;
+      }
+   }
+
+   m_free.push_back ({size, 0, {}});
+
+   return m_free.back();
+}
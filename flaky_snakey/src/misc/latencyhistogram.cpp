@@ -0,0 +1,128 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <misc/latencyhistogram.hpp>
+
+
+/// Constructors and destructor
+/// std::atomic is left uninitialised by its default constructor
+LatencyHistogram::LatencyHistogram()
+{
+   clear();
+}
+
+
+
+/// Functionality
+void LatencyHistogram::record (const std::uint64_t nanoseconds)
+{
+   m_buckets[getBucket (nanoseconds)].fetch_add (1, std::memory_order_relaxed);
+   m_count.fetch_add (1, std::memory_order_relaxed);
+
+   /// Only write when the maximum actually grows, which quickly becomes rare
+   std::uint64_t max = m_max.load (std::memory_order_relaxed);
+
+   while (nanoseconds > max && !m_max.compare_exchange_weak (max, nanoseconds, std::memory_order_relaxed))
+   {
+   }
+}
+
+
+void LatencyHistogram::clear()
+{
+   for (auto& bucket : m_buckets)
+   {
+      bucket.store (0, std::memory_order_relaxed);
+   }
+
+   m_count.store (0, std::memory_order_relaxed);
+   m_max.store (0, std::memory_order_relaxed);
+}
+
+
+
+/// Getters
+/// Walks the buckets until enough durations have been passed, the result never exceeds the maximum recorded
+std::uint64_t LatencyHistogram::getPercentile (const double percentile) const
+{
+   const std::uint64_t count = getCount();
+
+   if (count == 0)
+   {
+      return 0;
+   }
+
+   /// The rank of the duration being looked for, at least the first
+   const double clamped = percentile < 0.0 ? 0.0 : percentile > 100.0 ? 100.0 : percentile;
+   std::uint64_t rank = static_cast<std::uint64_t> (clamped / 100.0 * count + 0.5);
+   rank = rank == 0 ? 1 : rank;
+
+   std::uint64_t passed {0};
+
+   for (unsigned int i {0}; i < kBucketCount; ++i)
+   {
+      passed += m_buckets[i].load (std::memory_order_relaxed);
+
+      if (passed >= rank)
+      {
+         const std::uint64_t value = getBucketValue (i);
+         return value < getMax() ? value : getMax();
+      }
+   }
+
+   /// Only reachable if buckets were counted while being read
+   return getMax();
+}
+
+
+/// Values below 2^kSubBits index directly, larger values are shifted until they fit and then offset by the shift
+unsigned int LatencyHistogram::getBucket (std::uint64_t value)
+{
+   const std::uint64_t limit = (std::uint64_t (1) << kMaxBits) - 1;
+   value = value < limit ? value : limit;
+
+   unsigned int shift {0};
+
+   while ((value >> shift) >= (1 << kSubBits))
+   {
+      ++shift;
+   }
+
+   if (shift == 0)
+   {
+      return value;
+   }
+
+   return (1 << kSubBits) + (shift - 1) * kHalfCount + ((value >> shift) - kHalfCount);
+}
+
+
+std::uint64_t LatencyHistogram::getBucketValue (const unsigned int bucket)
+{
+   if (bucket < (1 << kSubBits))
+   {
+      return bucket;
+   }
+
+   const unsigned int shift = (bucket - (1 << kSubBits)) / kHalfCount + 1;
+   const std::uint64_t sub = (bucket - (1 << kSubBits)) % kHalfCount + kHalfCount;
+
+   return ((sub + 1) << shift) - 1;
+}
@@ -0,0 +1,409 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <misc/occupancygrid.hpp>
+
+
+/// Constructors and destructor
+// Every cell starts empty and free, chunks are allocated as they're used
+OccupancyGrid::OccupancyGrid (const InGameSetup& setup)
+   :  m_kSetup (setup),
+      m_chunksX ((setup.getGridWidth() + kChunkMask) >> kChunkShift),
+      m_chunks (m_chunksX * ((setup.getGridHeight() + kChunkMask) >> kChunkShift)),
+      m_freeTree (m_chunks.size() + 1, 0),
+      m_freeCells (0), m_hash (0), m_spareChunks (0)
+{
+   /// Build the Fenwick tree in linear time by passing each count up to its parent
+   for (unsigned int i {1}; i < m_freeTree.size(); ++i)
+   {
+      m_freeTree[i] += getChunkWidth (i - 1) * getChunkHeight (i - 1);
+      m_freeCells += getChunkWidth (i - 1) * getChunkHeight (i - 1);
+
+      const unsigned int parent = i + (i & -i);
+
+      if (parent < m_freeTree.size())
+      {
+         m_freeTree[parent] += m_freeTree[i];
+      }
+   }
+}
+
+
+
+/// Testing functions
+bool OccupancyGrid::isSnakeHere (const Cell& cell) const
+{
+   const auto contents = find (cell);
+
+   return contents && contents->snakeParts != 0;
+}
+
+
+bool OccupancyGrid::isObstacleHere (const Cell& cell) const
+{
+   const auto contents = find (cell);
+
+   return contents && contents->obstacle;
+}
+
+
+bool OccupancyGrid::isFoodHere (const Cell& cell) const
+{
+   const auto contents = find (cell);
+
+   return contents && contents->food;
+}
+
+
+
+/// Assignment functions
+/// Positions outside of the level are ignored, there is nothing there to keep track of
+void OccupancyGrid::addSnakePart (const Cell& cell)
+{
+   const unsigned int chunkIndex = getChunkIndex (cell);
+   const auto chunk = fetch (chunkIndex, true);
+
+   if (chunk)
+   {
+      const unsigned int local = getLocalIndex (cell);
+      auto& contents = chunk->cells[local];
+      const Contents before = contents;
+
+      ++contents.snakeParts;
+      updateCell (chunkIndex, local, before);
+   }
+}
+
+
+void OccupancyGrid::removeSnakePart (const Cell& cell)
+{
+   const unsigned int chunkIndex = getChunkIndex (cell);
+   const auto chunk = fetch (chunkIndex, false);
+
+   // Pre-condition: Never underflow the counter
+   if (chunk && chunk->cells[getLocalIndex (cell)].snakeParts != 0)
+   {
+      const unsigned int local = getLocalIndex (cell);
+      auto& contents = chunk->cells[local];
+      const Contents before = contents;
+
+      --contents.snakeParts;
+      updateCell (chunkIndex, local, before);
+   }
+}
+
+
+void OccupancyGrid::setObstacle (const Cell& cell, const bool obstacle)
+{
+   const unsigned int chunkIndex = getChunkIndex (cell);
+   const auto chunk = fetch (chunkIndex, obstacle);
+
+   if (chunk)
+   {
+      const unsigned int local = getLocalIndex (cell);
+      auto& contents = chunk->cells[local];
+      const Contents before = contents;
+
+      contents.obstacle = obstacle;
+      updateCell (chunkIndex, local, before);
+   }
+}
+
+
+void OccupancyGrid::setFood (const Cell& cell, const bool food)
+{
+   const unsigned int chunkIndex = getChunkIndex (cell);
+   const auto chunk = fetch (chunkIndex, food);
+
+   if (chunk)
+   {
+      const unsigned int local = getLocalIndex (cell);
+      auto& contents = chunk->cells[local];
+      const Contents before = contents;
+
+      contents.food = food;
+      updateCell (chunkIndex, local, before);
+   }
+}
+
+
+void OccupancyGrid::save (Snapshot& modify) const
+{
+   for (const auto& chunk : modify.m_chunks)
+   {
+      if (chunk && chunk.use_count() == 1)
+      {
+         m_spareChunks.push_back (std::const_pointer_cast<Chunk> (chunk));
+      }
+   }
+
+   modify.m_chunks.assign (m_chunks.begin(), m_chunks.end());
+   modify.m_freeTree = m_freeTree;
+   modify.m_freeCells = m_freeCells;
+   modify.m_hash = m_hash;
+}
+
+
+/// The chunks are shared rather than copied, fetch() copies any of them the grid writes to again
+void OccupancyGrid::restore (const Snapshot& snapshot)
+{
+   // Pre-condition: The snapshot was taken of a grid with the same dimensions
+   if (snapshot.m_chunks.size() != m_chunks.size())
+   {
+      throw std::runtime_error ("OccupancyGrid::restore() was given a Snapshot of a different sized grid.");
+   }
+
+   for (unsigned int i {0}; i < m_chunks.size(); ++i)
+   {
+      if (m_chunks[i] && m_chunks[i].use_count() == 1)
+      {
+         m_spareChunks.push_back (std::move (m_chunks[i]));
+      }
+
+      m_chunks[i] = std::const_pointer_cast<Chunk> (snapshot.m_chunks[i]);
+   }
+
+   m_freeTree = snapshot.m_freeTree;
+   m_freeCells = snapshot.m_freeCells;
+   m_hash = snapshot.m_hash;
+}
+
+
+
+/// Functionality
+/// Keeps the free cells and the hash in sync whenever a cell changes, before is what the cell held until now
+void OccupancyGrid::updateCell (const unsigned int chunkIndex, const unsigned int local, const Contents before)
+{
+   auto& chunk = *m_chunks[chunkIndex];
+   const Contents after = chunk.cells[local];
+
+   m_hash += getCellHash (chunkIndex, local, after) - getCellHash (chunkIndex, local, before);
+
+   if (before.isOccupied() == after.isOccupied())
+   {
+      return;
+   }
+
+   const std::uint64_t bit = (std::uint64_t) 1 << (local & kChunkMask);
+
+   if (after.isOccupied())
+   {
+      chunk.free[local >> kChunkShift] &= ~bit;
+
+      addToFreeTree (chunkIndex, -1);
+      --m_freeCells;
+   }
+
+   else
+   {
+      chunk.free[local >> kChunkShift] |= bit;
+
+      addToFreeTree (chunkIndex, 1);
+      ++m_freeCells;
+   }
+}
+
+
+/// Adds change to the free cell count of a chunk, the counts are stored as a Fenwick tree
+void OccupancyGrid::addToFreeTree (const unsigned int chunkIndex, const int change)
+{
+   for (unsigned int i {chunkIndex + 1}; i < m_freeTree.size(); i += i & -i)
+   {
+      m_freeTree[i] += change;
+   }
+}
+
+
+
+/// Getters
+unsigned int OccupancyGrid::getSnakeParts (const Cell& cell) const
+{
+   const auto contents = find (cell);
+
+   return contents ? contents->snakeParts : 0;
+}
+
+
+unsigned int OccupancyGrid::getAllocatedChunks() const
+{
+   unsigned int allocated {0};
+
+   for (const auto& chunk : m_chunks)
+   {
+      if (chunk)
+      {
+         ++allocated;
+      }
+   }
+
+   return allocated;
+}
+
+
+/// Descends the Fenwick tree to the chunk containing the index, then reads the chunk's own free array
+Cell OccupancyGrid::getFreeCell (const unsigned int index) const
+{
+   // Pre-condition: The index must refer to a free cell
+   if (index >= m_freeCells)
+   {
+      throw std::runtime_error ("OccupancyGrid::getFreeCell() was given an index with no free cell.");
+   }
+
+   unsigned int position {0}, remaining {index}, step {1};
+
+   while (step * 2 < m_freeTree.size())
+   {
+      step *= 2;
+   }
+
+   for (; step != 0; step /= 2)
+   {
+      if (position + step < m_freeTree.size() && m_freeTree[position + step] <= remaining)
+      {
+         position += step;
+         remaining -= m_freeTree[position];
+      }
+   }
+
+   /// position is now the index of the chunk, a chunk which has never been used is free everywhere inside the level.
+   /// Otherwise the rows are counted off until the one holding the cell, then its free cells before it are cleared
+   const auto& chunk = m_chunks[position];
+   unsigned int localX {0}, localY {0};
+
+   if (chunk)
+   {
+      for (unsigned int count = countBits (chunk->free[0]); count <= remaining; count = countBits (chunk->free[localY]))
+      {
+         remaining -= count;
+         ++localY;
+      }
+
+      std::uint64_t row = chunk->free[localY];
+
+      for (; remaining != 0; --remaining)
+      {
+         row &= row - 1;
+      }
+
+      while (!(row & ((std::uint64_t) 1 << localX)))
+      {
+         ++localX;
+      }
+   }
+
+   else
+   {
+      localX = remaining % getChunkWidth (position);
+      localY = remaining / getChunkWidth (position);
+   }
+
+   return { (unsigned short) (((position % m_chunksX) << kChunkShift) + localX),
+            (unsigned short) (((position / m_chunksX) << kChunkShift) + localY) };
+}
+
+
+/// Every cell and its contents are mixed into 64 bits by the finaliser of SplitMix64
+std::uint64_t OccupancyGrid::getCellHash (const unsigned int chunkIndex, const unsigned int local,
+                                          const Contents contents)
+{
+   const std::uint32_t code = contents.getCode();
+
+   if (code == 0)
+   {
+      return 0;
+   }
+
+   std::uint64_t hash = ((((std::uint64_t) chunkIndex << (kChunkShift * 2)) | local) << 32) | code;
+   hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+   hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+
+   return hash ^ (hash >> 31);
+}
+
+
+/// Counts the set bits of a word in parallel, a pair of bits at a time and then ever wider groups
+unsigned int OccupancyGrid::countBits (std::uint64_t bits)
+{
+   bits -= (bits >> 1) & 0x5555555555555555ull;
+   bits = (bits & 0x3333333333333333ull) + ((bits >> 2) & 0x3333333333333333ull);
+   bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+
+   return (bits * 0x0101010101010101ull) >> 56;
+}
+
+
+/// Chunks along the right and top edges can hang over the end of the level
+unsigned int OccupancyGrid::getChunkWidth (const unsigned int chunkIndex) const
+{
+   const unsigned int remaining = m_kSetup.getGridWidth() - ((chunkIndex % m_chunksX) << kChunkShift);
+
+   return remaining < kChunkSize ? remaining : kChunkSize;
+}
+
+
+unsigned int OccupancyGrid::getChunkHeight (const unsigned int chunkIndex) const
+{
+   const unsigned int remaining = m_kSetup.getGridHeight() - ((chunkIndex / m_chunksX) << kChunkShift);
+
+   return remaining < kChunkSize ? remaining : kChunkSize;
+}
+
+
+/// Clearing a cell never needs to allocate as an unused chunk is already empty, every cell of a new chunk is free.
+/// Every caller writes to the chunk so one that is still shared with a Snapshot is given its own copy first, made into
+/// a spare chunk when there is one so the copy reuses its memory
+OccupancyGrid::Chunk* OccupancyGrid::fetch (const unsigned int chunkIndex, const bool allocate)
+{
+   if (chunkIndex == m_chunks.size())
+   {
+      return nullptr;
+   }
+
+   auto& chunk = m_chunks[chunkIndex];
+
+   if (chunk && chunk.use_count() != 1)
+   {
+      if (m_spareChunks.empty())
+      {
+         chunk = std::make_shared<Chunk> (*chunk);
+      }
+
+      else
+      {
+         *m_spareChunks.back() = *chunk;
+         chunk = std::move (m_spareChunks.back());
+         m_spareChunks.pop_back();
+      }
+   }
+
+   else if (!chunk && allocate)
+   {
+      chunk = std::make_shared<Chunk>();
+      chunk->cells.resize (kChunkSize * kChunkSize);
+
+      /// Shifting by the width of the word is undefined, so a full row is made by shifting by one less
+      const unsigned int width = getChunkWidth (chunkIndex);
+      const std::uint64_t row = (((std::uint64_t) 1 << (width - 1)) << 1) - 1;
+      chunk->free.assign (getChunkHeight (chunkIndex), row);
+      chunk->free.resize (kChunkSize, 0);
+   }
+
+   return chunk.get();
+}
@@ -0,0 +1,209 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <misc/profiler.hpp>
+
+
+/// STL
+#include <iomanip>   // report()
+#include <stdexcept> // Phases are checked
+
+
+/// Static members need defining
+std::atomic<bool> Profiler::m_enabled {false};
+
+
+
+namespace
+{
+   /// Constructed on first use so a Scope in another static's constructor still finds them
+   LatencyHistogram* getHistograms()
+   {
+      static LatencyHistogram histograms[static_cast<unsigned int> (Profiler::Phase::Count)];
+      return histograms;
+   }
+
+
+   LatencyHistogram& getAllocationHistogram()
+   {
+      static LatencyHistogram allocations;
+      return allocations;
+   }
+
+
+   const char* const kNames[static_cast<unsigned int> (Profiler::Phase::Count)]
+   {
+      "Food update",
+      "Spawn search",
+      "Snake update",
+      "Collisions",
+      "Flakes",
+      "Draw snakes",
+      "Draw food",
+      "Draw obstacles",
+      "Draw interface",
+      "Player move",
+      "Generic AI move",
+      "Dumb AI move",
+      "Smart AI move",
+      "Pathfinding AI move",
+      "MCTS AI move",
+      "Distance field",
+      "Danger map"
+   };
+}
+
+
+
+/// Scope
+Profiler::Scope::Scope (const Phase phase)
+   :  m_kPhase (phase), m_kEnabled (isEnabled()), m_start ()
+{
+   if (m_kEnabled)
+   {
+      m_start = std::chrono::steady_clock::now();
+   }
+}
+
+
+Profiler::Scope::~Scope()
+{
+   if (m_kEnabled)
+   {
+      const auto elapsed = std::chrono::steady_clock::now() - m_start;
+      getHistograms()[static_cast<unsigned int> (m_kPhase)]
+         .record (std::chrono::duration_cast<std::chrono::nanoseconds> (elapsed).count());
+   }
+}
+
+
+
+/// Testing functions
+bool Profiler::isTickAllocating()
+{
+   return getAllocationHistogram().getPercentile (90.0) != 0;
+}
+
+
+
+/// Functionality
+void Profiler::record (const Phase phase, const std::uint64_t nanoseconds)
+{
+   // Pre-condition: The phase exists
+   if (phase >= Phase::Count)
+   {
+      throw std::runtime_error ("Profiler::record() was given an invalid phase.");
+   }
+
+   getHistograms()[static_cast<unsigned int> (phase)].record (nanoseconds);
+}
+
+
+void Profiler::recordAllocations (const std::uint64_t allocations)
+{
+   if (isEnabled())
+   {
+      getAllocationHistogram().record (allocations);
+   }
+}
+
+
+void Profiler::clear()
+{
+   getAllocationHistogram().clear();
+
+   for (unsigned int i {0}; i < static_cast<unsigned int> (Phase::Count); ++i)
+   {
+      getHistograms()[i].clear();
+   }
+}
+
+
+/// Durations are reported in microseconds as every phase is expected to be well below a millisecond
+void Profiler::report (std::ostream& output)
+{
+   bool header {false};
+
+   for (unsigned int i {0}; i < static_cast<unsigned int> (Phase::Count); ++i)
+   {
+      const auto& histogram = getHistograms()[i];
+
+      if (histogram.getCount() == 0)
+      {
+         continue;
+      }
+
+      if (!header)
+      {
+         output << std::left << std::setw (18) << "Phase" << std::right << std::setw (12) << "Count"
+                << std::setw (12) << "p50 (us)" << std::setw (12) << "p99 (us)" << std::setw (12) << "max (us)"
+                << std::endl;
+         header = true;
+      }
+
+      output << std::left << std::setw (18) << kNames[i] << std::right << std::setw (12) << histogram.getCount()
+             << std::fixed << std::setprecision (2)
+             << std::setw (12) << histogram.getPercentile (50.0) / 1000.0
+             << std::setw (12) << histogram.getPercentile (99.0) / 1000.0
+             << std::setw (12) << histogram.getMax() / 1000.0 << std::endl;
+   }
+
+   const auto& allocations = getAllocationHistogram();
+
+   if (allocations.getCount() != 0)
+   {
+      output << std::left << std::setw (18) << "Allocations" << std::right << std::setw (12) << allocations.getCount()
+             << std::setw (12) << allocations.getPercentile (50.0) << std::setw (12) << allocations.getPercentile (99.0)
+             << std::setw (12) << allocations.getMax() << "  per tick"
+             << (isTickAllocating() ? ", the tick is allocating" : "") << std::endl;
+   }
+}
+
+
+
+/// Getters
+const LatencyHistogram& Profiler::getHistogram (const Phase phase)
+{
+   // Pre-condition: The phase exists
+   if (phase >= Phase::Count)
+   {
+      throw std::runtime_error ("Profiler::getHistogram() was given an invalid phase.");
+   }
+
+   return getHistograms()[static_cast<unsigned int> (phase)];
+}
+
+
+const LatencyHistogram& Profiler::getAllocations()
+{
+   return getAllocationHistogram();
+}
+
+
+const char* Profiler::getName (const Phase phase)
+{
+   // Pre-condition: The phase exists
+   if (phase >= Phase::Count)
+   {
+      throw std::runtime_error ("Profiler::getName() was given an invalid phase.");
+   }
+
+   return kNames[static_cast<unsigned int> (phase)];
+}
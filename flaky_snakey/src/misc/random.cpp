@@ -0,0 +1,100 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include <misc/random.hpp>
+
+
+/// Constructors and destructor
+Random::Random (const unsigned int seed, const unsigned int stream)
+{
+   this->seed (seed, stream);
+}
+
+
+
+/// Functionality
+/// Any seed is valid, the state is expanded from it with SplitMix64 so it can never be all zero. The stream fills the
+/// upper half of the SplitMix64 seed so no two pairs of seed and stream share a sequence
+void Random::seed (const unsigned int seed, const unsigned int stream)
+{
+   std::uint64_t mix {((std::uint64_t) stream << 32) | seed};
+
+   for (unsigned int i {0}; i < 4; i += 2)
+   {
+      mix += 0x9E3779B97F4A7C15ULL;
+
+      std::uint64_t word {mix};
+      word = (word ^ (word >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      word = (word ^ (word >> 27)) * 0x94D049BB133111EBULL;
+      word ^= word >> 31;
+
+      m_state[i] = (std::uint32_t) word;
+      m_state[i + 1] = (std::uint32_t) (word >> 32);
+   }
+}
+
+
+/// Returns a uniformly random 32-bit number
+std::uint32_t Random::next()
+{
+   const auto rotate = [] (const std::uint32_t value, const unsigned int bits)
+   {
+      return (value << bits) | (value >> (32 - bits));
+   };
+
+   const std::uint32_t result = rotate (m_state[1] * 5, 7) * 9;
+   const std::uint32_t shifted = m_state[1] << 9;
+
+   m_state[2] ^= m_state[0];
+   m_state[3] ^= m_state[1];
+   m_state[1] ^= m_state[2];
+   m_state[0] ^= m_state[3];
+   m_state[2] ^= shifted;
+   m_state[3] = rotate (m_state[3], 11);
+
+   return result;
+}
+
+
+/// Lemire's method: the high half of next() * bound is the result, the rare low halves which would bias it are redrawn
+unsigned int Random::next (const unsigned int bound)
+{
+   // Pre-condition: There must be a number to return
+   if (bound == 0)
+   {
+      throw std::runtime_error ("Random::next() was given a bound of 0.");
+   }
+
+   std::uint64_t product = (std::uint64_t) next() * bound;
+
+   if ((std::uint32_t) product < bound)
+   {
+      /// Low halves below 2^32 % bound would be picked once too often
+      const std::uint32_t threshold = -bound % bound;
+
+      while ((std::uint32_t) product < threshold)
+      {
+         product = (std::uint64_t) next() * bound;
+      }
+   }
+
+   return product >> 32;
+}
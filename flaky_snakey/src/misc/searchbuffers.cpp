@@ -0,0 +1,93 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <misc/searchbuffers.hpp>
+
+
+/// Constructors and destructor
+SearchBuffers::SearchBuffers (const InGameSetup& setup)
+   :  m_chunksX ((setup.getGridWidth() + kChunkMask) >> kChunkShift),
+      m_chunks (m_chunksX * ((setup.getGridHeight() + kChunkMask) >> kChunkShift)),
+      m_frontier (0), m_nextFrontier (0), m_generation (1)
+{
+}
+
+
+
+/// Functionality
+/// The stamps only need clearing when the generation wraps round, once every four billion searches
+void SearchBuffers::beginSearch()
+{
+   if (++m_generation == 0)
+   {
+      for (auto& chunk : m_chunks)
+      {
+         chunk.stamps.assign (chunk.stamps.size(), 0);
+      }
+
+      m_generation = 1;
+   }
+
+   m_frontier.clear();
+   m_nextFrontier.clear();
+}
+
+
+void SearchBuffers::reserve (const unsigned int frontier)
+{
+   if ((m_chunks.size() << kChunkBits) > kMaxReservedCells)
+   {
+      return;
+   }
+
+   for (auto& chunk : m_chunks)
+   {
+      if (chunk.stamps.empty())
+      {
+         allocate (chunk);
+      }
+   }
+
+   m_frontier.reserve (frontier);
+   m_nextFrontier.reserve (frontier);
+}
+
+
+
+/// Assignment functions
+/// Gives a chunk its buffers the first time a search visits it
+void SearchBuffers::allocate (Chunk& chunk)
+{
+   chunk.stamps.resize (1 << kChunkBits, 0);
+   chunk.firstMoves.resize (1 << kChunkBits, 0);
+   chunk.distances.resize (1 << kChunkBits, 0);
+}
+
+
+
+/// Getters
+Cell SearchBuffers::getCell (const unsigned int index) const
+{
+   const unsigned int chunk = index >> kChunkBits;
+   const unsigned int local = index & kLocalMask;
+
+   return { (unsigned short) (((chunk % m_chunksX) << kChunkShift) | (local & kChunkMask)),
+            (unsigned short) (((chunk / m_chunksX) << kChunkShift) | (local >> kChunkShift)) };
+}
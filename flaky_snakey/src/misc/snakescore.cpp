@@ -23,7 +23,7 @@
 
 /// Constructors and destructor
 SnakeScore::SnakeScore()
-   :  m_name ("NULL"), m_playerNumber (999), m_score (0), m_alive (false)
+   :  m_name ("NULL"), m_playerNumber (999), m_score (0), m_scoreText ("0"), m_alive (false), m_colour (255, 255, 255)
 {
 }
 
@@ -54,3 +54,14 @@ void SnakeScore::setPlayerNumber (const unsigned int playerNumber)
       m_playerNumber = 10;
    }
 }
+
+
+/// The interface draws the text every frame but scores rarely change, so converting here saves work and allocations
+void SnakeScore::setScore (const unsigned int score)
+{
+   if (score != m_score)
+   {
+      m_score = score;
+      utility::intToString (m_score, m_scoreText);
+   }
+}
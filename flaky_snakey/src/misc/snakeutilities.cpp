@@ -21,6 +21,12 @@
 #include <misc/snakeutilities.hpp>
 
 
+/// STL
+#include <cmath>     // Used in generateColour() and generateSpawns()
+#include <cstdlib>   // Used in getWrappedDistance()
+#include <stdexcept> // Used in generateSpawns()
+
+
 /// Completely flushes the buffer from cin to prevent input errors
 void utility::flushCin()
 {
@@ -48,34 +54,43 @@ std::string utility::intToString (const unsigned int value)
 }
 
 
-/// A boundary aware function to move a Rectangle however many cells is specified
-Rectangle& utility::moveCell (const InGameSetup& setup, Rectangle& modify, int moveX, int moveY)
+/// Digits are written backwards into a local buffer so modify only has to be assigned once
+void utility::intToString (unsigned int value, std::string& modify)
 {
-   if (moveX == 0 && moveY == 0)
+   char digits[10];
+   unsigned int count {0};
+
+   do
    {
-      return modify;
-   }
+      digits[sizeof (digits) - ++count] = '0' + value % 10;
+      value /= 10;
+   } while (value != 0);
+
+   modify.assign (digits + sizeof (digits) - count, count);
+}
 
-   const unsigned int gridWidth = setup.getGridWidth();
-   const unsigned int gridHeight = setup.getGridHeight();
 
-   // Adjust moveX and moveY to the actual cells modify should be moved
-   if (moveX > (int) gridWidth || moveX < (int) gridWidth * -1)
+/// A boundary aware function to move a Cell however many cells is specified
+Cell& utility::moveCell (const InGameSetup& setup, Cell& modify, int moveX, int moveY)
+{
+   const int gridWidth = setup.getGridWidth();
+   const int gridHeight = setup.getGridHeight();
+
+   // Adjust moveX and moveY to the actual cells modify should be moved, single steps never need it
+   if (moveX >= gridWidth || moveX <= -gridWidth)
    {
       moveX %= gridWidth;
    }
 
-   if (moveY > (int) gridHeight || moveY < (int) gridHeight * -1)
+   if (moveY >= gridHeight || moveY <= -gridHeight)
    {
       moveY %= gridHeight;
    }
 
 
    // Calculate targetX
-   unsigned int currentX = (modify.getX() - setup.getStartX()) / setup.getRectWidth();
-
-   int targetX = currentX + moveX;
-   if (targetX >= (int) gridWidth)
+   int targetX = modify.x + moveX;
+   if (targetX >= gridWidth)
    {
       targetX -= gridWidth;
    }
@@ -87,10 +102,8 @@ Rectangle& utility::moveCell (const InGameSetup& setup, Rectangle& modify, int m
 
 
    // Calculate targetY
-   unsigned int currentY = (modify.getY() - setup.getStartY()) / setup.getRectHeight();
-
-   int targetY = currentY + moveY;
-   if (targetY >= (int) gridHeight)
+   int targetY = modify.y + moveY;
+   if (targetY >= gridHeight)
    {
       targetY -= gridHeight;
    }
@@ -100,10 +113,175 @@ Rectangle& utility::moveCell (const InGameSetup& setup, Rectangle& modify, int m
        targetY += gridHeight;
    }
 
-
-   /// Move modify to the correct cell
-   modify.setPosition (setup.getStartX() + targetX * setup.getRectWidth(),
-                       setup.getStartY() + targetY * setup.getRectHeight());
+   modify.x = (unsigned short) targetX;
+   modify.y = (unsigned short) targetY;
 
    return modify;
 }
+
+
+/// Moving the other way round the level is shorter once the difference passes half of size
+int utility::wrapDifference (const int difference, const int size)
+{
+   if (difference * 2 > size)
+   {
+      return difference - size;
+   }
+
+   else if (difference * 2 < -size)
+   {
+      return difference + size;
+   }
+
+   return difference;
+}
+
+
+unsigned int utility::getWrappedDistance (const InGameSetup& setup, const Cell& from, const Cell& to)
+{
+   const int diffX = wrapDifference (to.x - from.x, setup.getGridWidth());
+   const int diffY = wrapDifference (to.y - from.y, setup.getGridHeight());
+
+   return std::abs (diffX) + std::abs (diffY);
+}
+
+
+/// Projects a cell onto the screen, on an overview of a huge grid neighbouring cells share a Rectangle
+Rectangle utility::toRectangle (const InGameSetup& setup, const Cell& cell)
+{
+   const unsigned int scale = setup.getCellsPerRect();
+
+   return  {  setup.getRectWidth(), setup.getRectHeight(),
+              setup.getStartX() + cell.x / scale * setup.getRectWidth(),
+              setup.getStartY() + cell.y / scale * setup.getRectHeight() };
+}
+
+
+/// Players 1-4 keep their red, green, blue and yellow, everyone after is spread evenly around the colour wheel
+prg::Colour utility::generateColour (const unsigned int playerNumber)
+{
+   switch (playerNumber)
+   {
+      case 0: return {255, 0, 0};   // Red
+      case 1: return {0, 255, 0};   // Green
+      case 2: return {0, 0, 255};   // Blue
+      case 3: return {255, 255, 0}; // Yellow
+      default: break;
+   }
+
+   /// Stepping by the golden ratio keeps neighbouring players visibly different however many there are
+   double hue = std::fmod (playerNumber * 0.618033988749895, 1.0) * 6.0;
+   const unsigned int sector = (unsigned int) hue;
+   const unsigned char rising = (unsigned char) ((hue - sector) * 255);
+   const unsigned char falling = 255 - rising;
+
+   switch (sector)
+   {
+      case 0: return {255, rising, 0};
+      case 1: return {falling, 255, 0};
+      case 2: return {0, 255, rising};
+      case 3: return {0, falling, 255};
+      case 4: return {rising, 0, 255};
+      default: return {255, 0, falling};
+   }
+}
+
+
+/// Spawns are kept two cells away from the edge of the grid so they can never overlap the default walls
+unsigned int utility::getSpawnCapacity (const InGameSetup& setup)
+{
+   if (setup.getGridWidth() < 5 || setup.getGridHeight() < 5)
+   {
+      return 0;
+   }
+
+   return (setup.getGridWidth() - 4) * (setup.getGridHeight() - 4);
+}
+
+
+/// Fills modify with amount spawn points, the first four are always the classic corners. Throws if they won't fit
+void utility::generateSpawns (const InGameSetup& setup, const unsigned int amount, std::vector<SnakeSpawn>& modify)
+{
+   // Pre-condition: Every Snake can have its own cell
+   if (amount > getSpawnCapacity (setup))
+   {
+      throw std::runtime_error ("Too many snakes for the grid in utility::generateSpawns().");
+   }
+
+   modify.clear();
+
+   /// The usable area is inset by two cells on each side
+   const unsigned short usableWidth = setup.getGridWidth() - 4;
+   const unsigned short usableHeight = setup.getGridHeight() - 4;
+
+   // Only the cells handed out are remembered so huge grids cost no more than small ones
+   std::unordered_set<unsigned int> used (amount);
+
+   auto addSpawn = [&] (const unsigned short x, const unsigned short y, const Movement direction)
+   {
+      SnakeSpawn spawn;
+      spawn.cell = {x, y};
+      spawn.direction = direction;
+      spawn.colour = generateColour (modify.size());
+
+      used.insert ((y - 2) * usableWidth + (x - 2));
+      modify.push_back (spawn);
+   };
+
+
+   /// The classic spawns, Player 1 = (2, end-2), Player 2 = (end-2, end-2), Player 3 = (2, 2), Player 4 = (end-2, 2)
+   const unsigned short right = setup.getGridWidth() - 3;
+   const unsigned short top = setup.getGridHeight() - 3;
+
+   const unsigned short classicX[4] { 2, right, 2, right };
+   const unsigned short classicY[4] { top, top, 2, 2 };
+   const Movement classicDirection[4] { Movement::Right, Movement::Down, Movement::Up, Movement::Left };
+
+   for (unsigned int i {0}; i < amount && i < 4; ++i)
+   {
+      addSpawn (classicX[i], classicY[i], classicDirection[i]);
+   }
+
+   if (amount <= 4)
+   {
+      return;
+   }
+
+
+   /// Everyone else is placed on an evenly spaced lattice, neighbouring rows travel in opposite directions
+   const unsigned int extra = amount - 4;
+   unsigned int columns = (unsigned int) std::ceil (std::sqrt ((double) extra * usableWidth / usableHeight));
+
+   if (columns == 0) { columns = 1; }
+
+   if (columns > usableWidth) { columns = usableWidth; }
+
+   unsigned int rows = (extra + columns - 1) / columns;
+
+   if (rows > usableHeight) { rows = usableHeight; }
+
+   for (unsigned int row {0}; row < rows && modify.size() < amount; ++row)
+   {
+      const unsigned short y = 2 + (2 * row + 1) * usableHeight / (2 * rows);
+
+      for (unsigned int column {0}; column < columns && modify.size() < amount; ++column)
+      {
+         const unsigned short x = 2 + (2 * column + 1) * usableWidth / (2 * columns);
+
+         if (used.count ((y - 2) * usableWidth + (x - 2)) == 0)
+         {
+            addSpawn (x, y, row % 2 == 0 ? Movement::Right : Movement::Left);
+         }
+      }
+   }
+
+
+   /// The lattice can land on a classic spawn, fill any shortfall with the first free cells
+   for (unsigned int i {0}; modify.size() < amount; ++i)
+   {
+      if (used.count (i) == 0)
+      {
+         addSpawn (2 + i % usableWidth, 2 + i / usableWidth, Movement::Right);
+      }
+   }
+}
@@ -0,0 +1,205 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include <misc/timingwheel.hpp>
+
+
+/// Static members are passed by reference so they need defining
+const unsigned int TimingWheel::kNone;
+
+
+
+/// Constructors and destructor
+TimingWheel::TimingWheel()
+   :  m_tick (0), m_heads (kLevels * kLevelSlots, kNone),
+      m_deadlines (0), m_slots (0), m_next (0), m_previous (0)
+{
+}
+
+
+
+/// Functionality
+/// Moves time on by one tick, fills modify with every id which expires on the new tick
+void TimingWheel::advance (std::vector<unsigned int>& modify)
+{
+   ++m_tick;
+
+   /// When the lower bits of the tick roll over the matching slot of the level above comes due, the highest level
+   /// that rolled over is cascaded first so its entries can fall all the way down
+   unsigned int levels {1};
+
+   while (levels < kLevels && ((m_tick >> (kLevelBits * levels)) << (kLevelBits * levels)) == m_tick)
+   {
+      ++levels;
+   }
+
+   for (unsigned int level {levels - 1}; level > 0; --level)
+   {
+      cascade (level);
+   }
+
+   /// Everything left in the level 0 slot expires now
+   auto& head = m_heads[m_tick & kLevelMask];
+
+   while (head != kNone)
+   {
+      const unsigned int id = head;
+
+      unlink (id);
+      modify.push_back (id);
+   }
+}
+
+
+/// Removes every deadline, time carries on from the current tick
+void TimingWheel::clear()
+{
+   m_heads.assign (m_heads.size(), kNone);
+   m_slots.assign (m_slots.size(), kNone);
+}
+
+
+void TimingWheel::reserve (const unsigned int count)
+{
+   m_deadlines.reserve (count);
+   m_slots.reserve (count);
+   m_next.reserve (count);
+   m_previous.reserve (count);
+}
+
+
+/// Adds a scheduled id to the slot its deadline belongs in
+void TimingWheel::link (const unsigned int id)
+{
+   /// The level is decided by the highest group of bits in which the deadline and the current tick differ
+   const unsigned int deadline = m_deadlines[id];
+   unsigned int difference {deadline ^ m_tick}, level {0};
+
+   while (difference > kLevelMask)
+   {
+      difference >>= kLevelBits;
+      ++level;
+   }
+
+   const unsigned int slot = level * kLevelSlots + ((deadline >> (kLevelBits * level)) & kLevelMask);
+   auto& head = m_heads[slot];
+
+   m_slots[id] = slot;
+   m_previous[id] = kNone;
+   m_next[id] = head;
+
+   if (head != kNone)
+   {
+      m_previous[head] = id;
+   }
+
+   head = id;
+}
+
+
+/// Removes an id from its slot
+void TimingWheel::unlink (const unsigned int id)
+{
+   const unsigned int next = m_next[id];
+   const unsigned int previous = m_previous[id];
+
+   if (previous != kNone)
+   {
+      m_next[previous] = next;
+   }
+
+   else
+   {
+      m_heads[m_slots[id]] = next;
+   }
+
+   if (next != kNone)
+   {
+      m_previous[next] = previous;
+   }
+
+   m_slots[id] = kNone;
+}
+
+
+/// Moves every entry of a slot down into the levels below
+void TimingWheel::cascade (const unsigned int level)
+{
+   auto& head = m_heads[level * kLevelSlots + ((m_tick >> (kLevelBits * level)) & kLevelMask)];
+
+   while (head != kNone)
+   {
+      const unsigned int id = head;
+
+      unlink (id);
+      link (id);
+   }
+}
+
+
+
+/// Assignment functions
+/// The id expires when getTick() reaches deadline, a deadline which has already passed expires on the next tick
+void TimingWheel::schedule (const unsigned int id, const unsigned int deadline)
+{
+   // Pre-condition: kNone is reserved
+   if (id == kNone)
+   {
+      throw std::runtime_error ("TimingWheel::schedule() was given an invalid id.");
+   }
+
+   if (id >= m_slots.size())
+   {
+      m_deadlines.resize (id + 1, 0);
+      m_slots.resize (id + 1, kNone);
+      m_next.resize (id + 1, kNone);
+      m_previous.resize (id + 1, kNone);
+   }
+
+   cancel (id);
+
+   m_deadlines[id] = deadline > m_tick ? deadline : m_tick + 1;
+   link (id);
+}
+
+
+/// Does nothing if the id isn't scheduled
+void TimingWheel::cancel (const unsigned int id)
+{
+   if (isScheduled (id))
+   {
+      unlink (id);
+   }
+}
+
+
+
+/// Getters
+unsigned int TimingWheel::getDeadline (const unsigned int id) const
+{
+   // Pre-condition: The id has a deadline
+   if (!isScheduled (id))
+   {
+      throw std::runtime_error ("TimingWheel::getDeadline() was given an id which isn't scheduled.");
+   }
+
+   return m_deadlines[id];
+}
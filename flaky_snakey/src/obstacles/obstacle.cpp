@@ -19,25 +19,27 @@
 
 
 #include <obstacles/obstacle.hpp>
+#include <misc/snakeutilities.hpp>
 
 
 /// Constructors and destructor
 // Assign default values
-Obstacle::Obstacle (const Rectangle& rectangle, const prg::Colour& colour)
-   : m_kRectangle (rectangle), m_kColour (colour)
+Obstacle::Obstacle (const Cell& cell, const prg::Colour& colour)
+   : m_kCell (cell), m_kColour (colour)
 {
 }
 
 
 
 /// Functionality
-void Obstacle::draw (prg::Canvas& canvas)
+void Obstacle::draw (prg::Canvas& canvas, const InGameSetup& projection) const
 {
    /// Get parameters for the sake of efficiency
-   const unsigned int x = getRectangle().getX();
-   const unsigned int y = getRectangle().getY();
-   const unsigned int width = getRectangle().getWidth();
-   const unsigned int height = getRectangle().getHeight();
+   const Rectangle rectangle = utility::toRectangle (projection, m_kCell);
+   const unsigned int x = rectangle.getX();
+   const unsigned int y = rectangle.getY();
+   const unsigned int width = rectangle.getWidth();
+   const unsigned int height = rectangle.getHeight();
 
    // Bottom line
    canvas.drawLine (x,           y,
@@ -19,90 +19,66 @@
 
 
 #include <obstacles/obstaclemanager.hpp>
+#include <misc/profiler.hpp>
 
 
 /// Constructors and destructor
-ObstacleManager::ObstacleManager (const InGameSetup& setup, const std::vector<Obstacle>& levelObs)
-   :  m_kSetup (setup), m_levelObstacles (levelObs) //, m_flakes (0)
+ObstacleManager::ObstacleManager (const InGameSetup& setup, const std::shared_ptr<OccupancyGrid>& grid,
+                                  const std::vector<SnakeSpawn>& spawns, const std::vector<Obstacle>& levelObs)
+   :  m_kSetup (setup), m_pGrid (grid), m_levelObstacles (0), m_spawnKeys (0) //, m_flakes (0)
 {
+   // Pre-condition: Obstacles must be able to be recorded
+   if (!m_pGrid)
+   {
+      throw std::runtime_error ("Attempt to create ObstacleManager without an OccupancyGrid.");
+   }
+
+   /// Sort the spawn points so isSpawnSafe() can search them quickly however many snakes there are
+   for (const auto& spawn : spawns)
+   {
+      m_spawnKeys.push_back (spawn.cell.y * m_kSetup.getGridWidth() + spawn.cell.x);
+   }
+
+   std::sort (m_spawnKeys.begin(), m_spawnKeys.end());
+
    // Pre-condition: levelObs doesn't contain more obstacles than the grid size
    // Pre-condition: levelObs isn't empty
    if (levelObs.size() > m_kSetup.getGridWidth() * m_kSetup.getGridHeight() ||
-         m_levelObstacles.empty())
+         levelObs.empty())
    {
       generateDefaultWalls();
    }
-}
-
 
-
-/// Testing functions
-bool ObstacleManager::isObstacleHere (const Rectangle& rect) const
-{
-   if (!m_levelObstacles.empty())
+   else
    {
-      for (const auto& ob : m_levelObstacles)
+      m_levelObstacles.reserve (levelObs.size());
+
+      for (const auto& ob : levelObs)
       {
-         if (ob.getRectangle().intersects (rect))
-         {
-            return true;
-         }
+         insertObstacle (ob);
       }
    }
-
-   return false;
 }
 
 
-/// Ensures that default snake spawn points are clear in the passed vector
-bool ObstacleManager::isSpawnSafe (const std::vector<Obstacle>& levelObs)
-{
-   /// Create copies of common attributes for the sake of efficiency
-   const unsigned int rectWidth = m_kSetup.getRectWidth();
-   const unsigned int startX = m_kSetup.getStartX();
-   const unsigned int endX = m_kSetup.getEndX();
-
-   const unsigned int rectHeight = m_kSetup.getRectHeight();
-   const unsigned int startY = m_kSetup.getStartY();
-   const unsigned int endY = startY + m_kSetup.getWorkingY();
 
-   /// Create spawn points for comparison purposes
-   std::vector<Rectangle> spawnPoints
-   {
-      // Player 1 = (2, 2)
-      {
-         rectWidth, rectHeight,
-         startX + 2 * rectWidth, startY + 2 * rectHeight
-      },
-
-      // Player 2 = (end-2, 2)
-      {
-         rectWidth, rectHeight,
-         endX - 3 * rectWidth, startY + 2 * rectHeight
-      },
-
-      // Player 3 = (2, end-2)
-      {
-         rectWidth, rectHeight,
-         startX + 2 * rectWidth, endY - 3 * rectHeight
-      },
+/// Testing functions
+bool ObstacleManager::isObstacleHere (const Cell& cell) const
+{
+   return m_pGrid->isObstacleHere (cell);
+}
 
-      // Player 4 = (end-2, end-2)
-      {
-         rectWidth, rectHeight,
-         endX - 3 * rectWidth, endY - 3 * rectHeight
-      }
-   };
 
-   /// Check for intersections
+/// Ensures that every snake spawn point is clear in the passed vector
+bool ObstacleManager::isSpawnSafe (const std::vector<Obstacle>& levelObs) const
+{
    for (const auto& ob : levelObs)
    {
-      for (const auto& spawn : spawnPoints)
+      const unsigned int key = ob.getCell().y * m_kSetup.getGridWidth() + ob.getCell().x;
+
+      if (std::binary_search (m_spawnKeys.begin(), m_spawnKeys.end(), key))
       {
-         if (ob.getRectangle().intersects (spawn))
-         {
-            return false;
-         }
+         return false;
       }
    }
 
@@ -113,11 +89,13 @@ bool ObstacleManager::isSpawnSafe (const std::vector<Obstacle>& levelObs)
 /// Functionality
 void ObstacleManager::drawObstacles (prg::Canvas& canvas)
 {
+   const Profiler::Scope scope {Profiler::Phase::DrawObstacles};
+
    if (!m_levelObstacles.empty())
    {
       for (auto& ob : m_levelObstacles)
       {
-         ob.draw (canvas);
+         ob.draw (canvas, m_kSetup);
       }
    }
 }
@@ -136,75 +114,81 @@ void ObstacleManager::drawObstacles (prg::Canvas& canvas)
 void ObstacleManager::generateDefaultWalls()
 {
    /// Create copies of common attributes for the sake of efficiency
-   const unsigned int gridWidth = m_kSetup.getGridWidth();
-   const unsigned int rectWidth = m_kSetup.getRectWidth();
-   const unsigned int startX = m_kSetup.getStartX();
-   const unsigned int endX = m_kSetup.getEndX();
-
-   const unsigned int gridHeight = m_kSetup.getGridHeight();
-   const unsigned int rectHeight = m_kSetup.getRectHeight();
-   const unsigned int startY = m_kSetup.getStartY();
-   const unsigned int endY = m_kSetup.getEndY();
+   const unsigned short gridWidth = m_kSetup.getGridWidth();
+   const unsigned short gridHeight = m_kSetup.getGridHeight();
+   const unsigned short endX = gridWidth - 1;
+   const unsigned short endY = gridHeight - 1;
 
 
    /// Create horizontal walls
    // 25% of the grid width is wall
-   for (unsigned int  i = 0; i < gridWidth / 4; ++i)
+   for (unsigned short i = 0; i < gridWidth / 4; ++i)
    {
-
-      // Bottom left
-      m_levelObstacles.push_back ({{rectWidth,                    rectHeight,
-                                    startX + i * rectWidth,       startY}});
-      // Bottom right
-      m_levelObstacles.push_back ({{rectWidth,                    rectHeight,
-                                    endX - (i + 1) * rectWidth,   startY}});
-      // Top left
-      m_levelObstacles.push_back ({{rectWidth,                    rectHeight,
-                                    startX + i * rectWidth,       endY - rectHeight}});
-      // Top right
-      m_levelObstacles.push_back ({{rectWidth,                    rectHeight,
-                                    endX - (i + 1) * rectWidth,   endY - rectHeight}});
+      addObstacle ({i,                          0});     // Bottom left
+      addObstacle ({(unsigned short) (endX - i), 0});    // Bottom right
+      addObstacle ({i,                          endY});  // Top left
+      addObstacle ({(unsigned short) (endX - i), endY}); // Top right
    }
 
 
    /// Create vertical walls
-   // Ensure duplicates aren't created by starting at 1
-   for (unsigned int i = 1; i < gridHeight / 4; ++i)
+   // Avoid duplicates by starting at 1, addObstacle() would reject them anyway
+   for (unsigned short i = 1; i < gridHeight / 4; ++i)
    {
-      // Bottom left
-      m_levelObstacles.push_back ({{rectWidth,           rectHeight,
-                                    startX,              startY + i * rectHeight}});
-      // Bottom right
-      m_levelObstacles.push_back ({{rectWidth,           rectHeight,
-                                    endX - rectWidth,    startY + i * rectHeight}});
-      // Top left
-      m_levelObstacles.push_back ({{rectWidth,           rectHeight,
-                                    startX,              endY - (i + 1) * rectHeight}});
-      // Top right
-      m_levelObstacles.push_back ({{rectWidth,           rectHeight,
-                                    endX - rectWidth,    endY - (i + 1) * rectHeight}});
+      addObstacle ({0,     i});                             // Bottom left
+      addObstacle ({endX,  i});                             // Bottom right
+      addObstacle ({0,     (unsigned short) (endY - i)});   // Top left
+      addObstacle ({endX,  (unsigned short) (endY - i)});   // Top right
    }
 }
 
 
 
 /// Assignment functions
-void ObstacleManager::addObstacle (const Rectangle& rect)
+void ObstacleManager::addObstacle (const Cell& cell)
 {
-   // Although there should never be a duplicate obstacle, addObstacle will check to see if adding would cause
-   // duplication.
-   if (!isObstacleHere (rect))
+   insertObstacle ({cell});
+}
+
+
+/// Used for a whole tick of flakes, the storage grows once rather than once per flake
+void ObstacleManager::addObstacles (const std::vector<Cell>& cells)
+{
+   const std::size_t required = m_levelObstacles.size() + cells.size();
+
+   // Keep growth geometric, reserving the exact amount every tick would reallocate every tick
+   if (required > m_levelObstacles.capacity())
    {
-      m_levelObstacles.push_back ({{rect}});
+      m_levelObstacles.reserve (std::max (required, m_levelObstacles.capacity() * 2));
    }
 
+   for (const auto& cell : cells)
+   {
+      insertObstacle ({cell});
+   }
+}
+
 
+/// Stores the Obstacle and records it in the grid
+void ObstacleManager::insertObstacle (const Obstacle& obstacle)
+{
+   // Although there should never be a duplicate obstacle, the grid is checked to see if adding would cause duplication
+   if (!isObstacleHere (obstacle.getCell()))
+   {
+      m_levelObstacles.push_back (obstacle);
+      m_pGrid->setObstacle (obstacle.getCell(), true);
+   }
 }
 
 
 /// Removes all obstacles, leaves the game with no walls
 void ObstacleManager::clearObstacles()
 {
+   for (const auto& ob : m_levelObstacles)
+   {
+      m_pGrid->setObstacle (ob.getCell(), false);
+   }
+
    m_levelObstacles.clear();
 }
 
@@ -219,12 +203,36 @@ void ObstacleManager::setObstacles (const std::vector<Obstacle>& levelObs)
       // Ensure snake spawn points are available
       if (isSpawnSafe (levelObs))
       {
-         m_levelObstacles.clear();
+         clearObstacles();
 
          for (const auto& ob : levelObs)
          {
-            m_levelObstacles.push_back (ob);
+            insertObstacle (ob);
          }
       }
    }
 }
+
+
+/// Obstacle can't be assigned so the vectors are refilled instead, which still reuses their memory
+void ObstacleManager::save (Snapshot& modify) const
+{
+   modify.m_obstacles.clear();
+
+   for (const auto& ob : m_levelObstacles)
+   {
+      modify.m_obstacles.push_back (ob);
+   }
+}
+
+
+void ObstacleManager::restore (const Snapshot& snapshot)
+{
+   m_levelObstacles.clear();
+   m_levelObstacles.reserve (snapshot.m_obstacles.size());
+
+   for (const auto& ob : snapshot.m_obstacles)
+   {
+      m_levelObstacles.push_back (ob);
+   }
+}
@@ -21,6 +21,10 @@
 #include <setup/ingamesetup.hpp>
 
 
+/// STL
+#include <algorithm> // std::max
+
+
 /// Constructors and destructor
 // For initialisation information see recalculateMembers() and correctAspectRatio()
 InGameSetup::InGameSetup()
@@ -30,6 +34,7 @@ InGameSetup::InGameSetup()
       m_startX (0), m_endX (0), m_startY (0), m_endY (0),
       m_aspectCorrection (true),
       m_gridWidth (20), m_gridHeight (20),
+      m_viewWidth (20), m_viewHeight (20), m_cellsPerRect (1),
       m_rectWidth (0), m_rectHeight (0)
 {
    setResolution (640, 480);
@@ -61,9 +66,9 @@ InGameSetup& InGameSetup::setResolution (const unsigned int width, const unsigne
 
 InGameSetup& InGameSetup::setGrid (const unsigned int width, const unsigned int height)
 {
-   // Pre-condition: Guarantee at least a 8x8 grid and less than 40x40 grid
+   // Pre-condition: Guarantee at least a 8x8 grid and no more than a 8192x8192 grid
    if (width >= 8 && height >= 8 &&
-         width <= 40 && height <= 40)
+         width <= 8192 && height <= 8192)
    {
       m_gridWidth = width;
       m_gridHeight = height;
@@ -105,23 +110,32 @@ void InGameSetup::recalculateMembers()
    // 25% goes to the UI, * 0.15 caused inaccuracies
    m_marginUI = m_workingX / 100.0 * 25 / 2.0;
    m_workingX -= m_workingX / 100.0 * 25;
+   m_workingY = m_resY;
+
+
+   /// Grids with more cells than pixels are drawn as a scaled overview, each Rectangle covers a block of cells
+   m_cellsPerRect = std::max ({ 1u, (m_gridWidth + m_workingX - 1) / m_workingX,
+                                    (m_gridHeight + m_workingY - 1) / m_workingY });
 
+   m_viewWidth = (m_gridWidth + m_cellsPerRect - 1) / m_cellsPerRect;
+   m_viewHeight = (m_gridHeight + m_cellsPerRect - 1) / m_cellsPerRect;
+
+
+   /// Calculate X values
    // Create a margin for even block dimensions, m_workingX -= m_marginX * 2 causes inaccuracies
-   m_marginX = (m_workingX % m_gridWidth) / 2.0;
-   m_workingX -= m_workingX % m_gridWidth;
+   m_marginX = (m_workingX % m_viewWidth) / 2.0;
+   m_workingX -= m_workingX % m_viewWidth;
 
 
    /// Calculate Y values
-   m_workingY = m_resY;
-
    // Create a margin for even block dimensions, m_workingY -= m_marginY * 2 causes inaccuracies
-   m_marginY = (m_workingY % m_gridHeight) / 2.0;
-   m_workingY -= m_workingY % m_gridHeight;
+   m_marginY = (m_workingY % m_viewHeight) / 2.0;
+   m_workingY -= m_workingY % m_viewHeight;
 
 
    /// Create Rectangle dimensions
-   m_rectWidth = m_workingX / m_gridWidth;
-   m_rectHeight = m_workingY / m_gridHeight;
+   m_rectWidth = m_workingX / m_viewWidth;
+   m_rectHeight = m_workingY / m_viewHeight;
 
 
    /// Create rendering values
@@ -140,8 +154,8 @@ void InGameSetup::correctAspectRatio()
    if (m_rectWidth > m_rectHeight)
    {
       // Fix the margin, I was so happy when I came up with this formula :-)
-      m_marginX += (m_rectWidth - m_rectHeight) * m_gridWidth / 2.0;
-      m_workingX -= (m_rectWidth - m_rectHeight) * m_gridWidth;
+      m_marginX += (m_rectWidth - m_rectHeight) * m_viewWidth / 2.0;
+      m_workingX -= (m_rectWidth - m_rectHeight) * m_viewWidth;
    }
 
 
@@ -149,14 +163,14 @@ void InGameSetup::correctAspectRatio()
    else if (m_rectWidth < m_rectHeight)
    {
       // Fix the margin
-      m_marginY += (m_rectHeight - m_rectWidth) * m_gridHeight / 2.0;
-      m_workingY -= (m_rectHeight - m_rectWidth) * m_gridHeight;
+      m_marginY += (m_rectHeight - m_rectWidth) * m_viewHeight / 2.0;
+      m_workingY -= (m_rectHeight - m_rectWidth) * m_viewHeight;
    }
 
 
    /// Update Rectangle dimensions
-   m_rectWidth = m_workingX / m_gridWidth;
-   m_rectHeight = m_workingY / m_gridHeight;
+   m_rectWidth = m_workingX / m_viewWidth;
+   m_rectHeight = m_workingY / m_viewHeight;
 
 
    /// Update rendering values
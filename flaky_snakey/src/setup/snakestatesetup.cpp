@@ -21,6 +21,10 @@
 #include <setup/snakestatesetup.hpp>
 
 
+/// Personal
+#include <misc/snakeutilities.hpp> // getSpawnCapacity
+
+
 /// Constructors and destructor
 SnakeStateSetup::SnakeStateSetup()
    :  InGameSetup(),
@@ -29,7 +33,9 @@ SnakeStateSetup::SnakeStateSetup()
       m_human (1), m_ai (0),
       m_foodMin (1), m_foodMax (5),
       m_scoreFood (25),
-      m_snakeUpdateInterval (100), m_foodRotInterval (5000), m_snakeAI ("generic")
+      m_snakeUpdateInterval (100), m_foodRotInterval (5000), m_seed (0), m_rolloutThreads (0),
+      m_snakeAI ("generic"), m_pReplay (nullptr), m_pSavedGame (nullptr), m_loadGame (false),
+      m_savePath ("flaky_snakey.sav")
 {
    /// Future functionality: allow custom keys for the player
    for (unsigned int i {0}; i < 4; ++i)
@@ -74,9 +80,9 @@ SnakeStateSetup::SnakeStateSetup()
 // Allow daisy chaining of set functions
 SnakeStateSetup& SnakeStateSetup::setGrid (const unsigned int width, const unsigned int height)
 {
-   // Pre-condition: Guarantee at least a 8x8 grid and less than 40x40 grid
+   // Pre-condition: Guarantee at least a 8x8 grid and no more than a 8192x8192 grid
    if (width >= 8 && height >= 8 &&
-         width <= 40 && height <= 40)
+         width <= 8192 && height <= 8192)
    {
       m_gridWidth = width;
       m_gridHeight = height;
@@ -89,6 +95,9 @@ SnakeStateSetup& SnakeStateSetup::setGrid (const unsigned int width, const unsig
 
       // Force recalculation of m_foodRotInterval
       setSnakeInterval (m_snakeUpdateInterval);
+
+      // A smaller grid may no longer have room for every Snake
+      setPlayers (m_human, m_ai);
    }
 
    return *this; // Daisy chaining
@@ -121,6 +130,11 @@ SnakeStateSetup& SnakeStateSetup::setPlayerName (const unsigned int index, const
    // Pre-condition: Index > 3
    if (index < 4)
    {
+      if (index >= m_names.size())
+      {
+         m_names.resize (index + 1);
+      }
+
       m_names[index] = name;
 
       if (name.size() > 10)
@@ -147,13 +161,12 @@ SnakeStateSetup& SnakeStateSetup::setPlayers (const unsigned int humans, const u
       m_human = m_keymaps.size();
    }
 
-   // Post-condition: AI can't be > 4
-   if (m_ai > 4) { m_ai = 4; }
+   // Post-conditions: Humans + AI can't outnumber the spawn points of the grid
+   const unsigned int capacity = utility::getSpawnCapacity (*this);
 
-   // Post-conditions: Humans + AI can't > 4
-   if (m_human + m_ai > 4)
+   if (m_human + m_ai > capacity)
    {
-      m_ai = 4 - m_human;
+      m_ai = capacity > m_human ? capacity - m_human : 0;
    }
 
    // Post-condition: Humans + AI can't == 0
@@ -167,7 +180,9 @@ SnakeStateSetup& SnakeStateSetup::setSnakeAI (const std::string& intelligence)
 {
    if (intelligence == "generic" ||
        intelligence == "dumb" ||
-       intelligence == "smart")
+       intelligence == "smart" ||
+       intelligence == "pathfinding" ||
+       intelligence == "mcts")
    {
       m_snakeAI = intelligence;
    }
@@ -238,3 +253,15 @@ SnakeStateSetup& SnakeStateSetup::setSnakeInterval (const unsigned int msInterva
 
    return *this;
 }
+
+
+/// The grid comes first as the players and food limits are checked against it
+SnakeStateSetup& SnakeStateSetup::setGame (const SnakeStateSetup& game)
+{
+   setGrid (game.getGridWidth(), game.getGridHeight());
+   setPlayers (game.getHumans(), game.getAI()).setSnakeAI (game.getSnakeAI());
+   setFoodLimits (game.getFoodMin(), game.getFoodMax()).setScoring (game.getScoreFood());
+   setSnakeInterval (game.getSnakeUpdateInterval());
+
+   return *this;
+}
@@ -0,0 +1,226 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include <simulation/batchrunner.hpp>
+
+
+/// STL
+#include <algorithm>  // std::sort
+#include <chrono>     // run()
+#include <functional> // std::ref
+#include <iomanip>    // std::setprecision
+#include <limits>     // Draws and unused indices
+#include <memory>     // run()
+#include <thread>     // run()
+
+
+/// Personal
+#include <simulation/replayrecorder.hpp> // playMatch()
+#include <simulation/world.hpp>          // playMatch()
+
+
+/// Constructors and destructor
+BatchRunner::BatchRunner (const SnakeStateSetup& setup, const unsigned int matches, const unsigned int maxTicks,
+                          const unsigned int threads)
+   :  m_setup (setup), m_kMatches (matches), m_kMaxTicks (maxTicks), m_threads (threads),
+      m_replayPath(), m_results (0), m_seconds (0.0)
+{
+   /// 0 asks for one thread per hardware thread
+   if (m_threads == 0)
+   {
+      m_threads = std::thread::hardware_concurrency();
+   }
+
+   // Post-condition: Never more threads than matches, but at least one even if hardware_concurrency() doesn't know
+   if (m_threads > m_kMatches) { m_threads = m_kMatches; }
+
+   if (m_threads == 0) { m_threads = 1; }
+
+   /// Every MCTS match plays ahead at once, so unless told otherwise they share the hardware threads between them
+   if (m_setup.getSnakeAI() == "mcts" && m_setup.getRolloutThreads() == 0)
+   {
+      const unsigned int hardware = std::thread::hardware_concurrency();
+      m_setup.setRolloutThreads (hardware > m_threads ? hardware / m_threads : 1);
+   }
+}
+
+
+
+/// Functionality
+void BatchRunner::run()
+{
+   /// Each worker writes straight into the slot of the match it played
+   m_results.assign (m_kMatches, MatchResult {0, 0, false});
+
+   std::atomic<unsigned int> next {0};
+   std::vector<std::thread> workers (0);
+
+   /// Every worker shares the one writer, each replay is handed over whole
+   std::unique_ptr<BackgroundWriter> replays {};
+
+   if (!m_replayPath.empty())
+   {
+      replays.reset (new BackgroundWriter (m_replayPath));
+   }
+
+   const auto start = std::chrono::steady_clock::now();
+
+   /// The calling thread works too
+   for (unsigned int i {1}; i < m_threads; ++i)
+   {
+      workers.emplace_back (&BatchRunner::work, this, std::ref (next), replays.get());
+   }
+
+   work (next, replays.get());
+
+   for (auto& worker : workers)
+   {
+      worker.join();
+   }
+
+   if (replays)
+   {
+      replays->close();
+   }
+
+   m_seconds = std::chrono::duration<double> (std::chrono::steady_clock::now() - start).count();
+}
+
+
+void BatchRunner::report (std::ostream& output) const
+{
+   // Pre-condition: run() has played something
+   if (m_results.empty())
+   {
+      output << "No matches were played." << std::endl;
+      return;
+   }
+
+   /// Gather the totals
+   const unsigned int draw = std::numeric_limits<unsigned int>::max() - 1;
+   const unsigned int snakes = m_setup.getHumans() + m_setup.getAI();
+
+   std::vector<unsigned int> lengths (0), wins (snakes, 0);
+   unsigned long long totalTicks {0};
+   unsigned int draws {0}, unfinished {0};
+
+   lengths.reserve (m_results.size());
+
+   for (const auto& result : m_results)
+   {
+      lengths.push_back (result.ticks);
+      totalTicks += result.ticks;
+
+      if (!result.finished)
+      {
+         ++unfinished;
+      }
+
+      else if (result.winnerIndex == draw)
+      {
+         ++draws;
+      }
+
+      else if (result.winnerIndex < snakes)
+      {
+         ++wins[result.winnerIndex];
+      }
+   }
+
+   std::sort (lengths.begin(), lengths.end());
+
+   /// Nearest-rank percentile of the sorted match lengths
+   const auto percentile = [&lengths] (const unsigned int percent)
+   {
+      return lengths[(lengths.size() - 1) * percent / 100];
+   };
+
+   const double matches = m_results.size();
+
+   /// Throughput
+   output << std::fixed << std::setprecision (1);
+   output << "Matches:      " << m_results.size() << " on " << m_setup.getGridWidth() << "x"
+          << m_setup.getGridHeight() << " with " << snakes << " " << m_setup.getSnakeAI() << " AI on " << m_threads
+          << (m_threads == 1 ? " thread" : " threads");
+
+   if (m_setup.getSnakeAI() == "mcts")
+   {
+      output << ", each playing ahead on " << m_setup.getRolloutThreads()
+             << (m_setup.getRolloutThreads() == 1 ? " thread" : " threads") << " for "
+             << m_setup.getSnakeUpdateInterval() << "ms ticks";
+   }
+
+   output << std::endl;
+   output << "Ticks:        " << totalTicks << " in " << m_seconds << "s" << std::endl;
+   output << "Ticks/sec:    " << (m_seconds > 0.0 ? totalTicks / m_seconds : 0.0) << std::endl;
+
+   /// Match length distribution
+   output << "Match length: mean " << totalTicks / matches << ", min " << lengths.front() << ", p10 " << percentile (10)
+          << ", p50 " << percentile (50) << ", p90 " << percentile (90) << ", max " << lengths.back() << std::endl;
+
+   /// Win rates
+   for (unsigned int i {0}; i < snakes; ++i)
+   {
+      output << "Snake " << i + 1 << " wins: " << wins[i] << " (" << 100.0 * wins[i] / matches << "%)" << std::endl;
+   }
+
+   output << "Draws:        " << draws << " (" << 100.0 * draws / matches << "%)" << std::endl;
+   output << "Unfinished:   " << unfinished << " (" << 100.0 * unfinished / matches << "%)" << std::endl;
+}
+
+
+/// Plays matches until none are left, next is the number of the next unclaimed match
+void BatchRunner::work (std::atomic<unsigned int>& next, BackgroundWriter* replays)
+{
+   for (unsigned int match {next++}; match < m_kMatches; match = next++)
+   {
+      m_results[match] = playMatch (match, replays);
+   }
+}
+
+
+MatchResult BatchRunner::playMatch (const unsigned int match, BackgroundWriter* replays) const
+{
+   World world {m_setup, m_setup.getSeed() + match};
+
+   if (!replays)
+   {
+      while (!world.isGameOver() && (m_kMaxTicks == 0 || world.getTick() < m_kMaxTicks))
+      {
+         world.step();
+      }
+   }
+
+   else
+   {
+      ReplayRecorder recorder {m_setup, m_setup.getSeed() + match};
+
+      while (!world.isGameOver() && (m_kMaxTicks == 0 || world.getTick() < m_kMaxTicks))
+      {
+         world.step();
+         recorder.record (world);
+      }
+
+      recorder.write (world, *replays);
+   }
+
+   return { world.getTick(), world.getWinnerIndex(), world.isGameOver() };
+}
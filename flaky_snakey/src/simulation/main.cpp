@@ -0,0 +1,400 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+/*
+   flaky_snakey_sim plays many AI matches without a window and reports how they went. It uses exactly the same World as
+   the game so any change to the rules or the AI shows up here too.
+
+   Usage: flaky_snakey_sim [options]
+      --matches N       How many matches to play (default 100)
+      --grid W H        The size of the level (default 40 40)
+      --snakes N        How many AI Snakes take part (default 4)
+      --ai NAME         generic, dumb, smart, pathfinding or mcts (default smart), mcts plays ahead for half of
+                        each update interval so its matches depend on timing
+      --food MIN MAX    The food limits (default 3 8)
+      --seed S          The seed of the first match, match n uses S + n (default 1)
+      --max-ticks N     Stop a match after N ticks, 0 for no limit (default 100000)
+      --threads N       How many matches to play at once, 0 for one per hardware thread (default 0)
+      --interval MS     The update interval each tick stands for, at least 17 (default 100)
+      --rollout-threads N
+                        How many threads each mcts match plays ahead on, 0 shares the hardware threads between the
+                        matches played at once (default 0)
+      --record FILE     Write a replay of every match to FILE
+      --play FILE       Play back every replay in FILE as fast as possible instead of playing new matches
+      --resume FILE     Finish the saved game in FILE instead of playing new matches, can be given more than once
+      --profile         Time every phase of a tick and report the latencies once finished, builds which count
+                        allocations also report those of each tick and fail if the tick keeps allocating
+*/
+
+
+/// STL
+#include <cerrno>    // readNumber()
+#include <chrono>    // playReplays() and resumeGames()
+#include <climits>   // readNumber()
+#include <cstdlib>   // std::strtoul
+#include <cstring>   // std::strcmp
+#include <iomanip>   // playReplays() and resumeGames()
+#include <iostream>  // std::cout
+#include <stdexcept> // Recording can fail
+#include <string>    // The AI, record, play and resume options
+#include <vector>    // playReplays() and resumeGames()
+
+
+/// Personal
+#include <misc/profiler.hpp>           // --profile
+#include <simulation/batchrunner.hpp>  // BatchRunner
+#include <simulation/replayplayer.hpp> // playReplays()
+#include <simulation/savegame.hpp>     // resumeGames()
+
+
+namespace
+{
+   void printUsage()
+   {
+      std::cerr << "Usage: flaky_snakey_sim [--matches N] [--grid W H] [--snakes N]" << std::endl
+                << "                        [--ai generic|dumb|smart|pathfinding|mcts] [--food MIN MAX]"
+                << std::endl
+                << "                        [--seed S] [--max-ticks N] [--threads N] [--interval MS]" << std::endl
+                << "                        [--rollout-threads N] [--record FILE] [--profile]" << std::endl
+                << "       flaky_snakey_sim --play FILE" << std::endl
+                << "       flaky_snakey_sim [--max-ticks N] --resume FILE [--resume FILE ...]" << std::endl;
+   }
+
+
+   /// Only prints anything when --profile was given, a tick which allocates fails the run so it can't go unnoticed
+   int printProfile (const int result)
+   {
+      if (!Profiler::isEnabled())
+      {
+         return result;
+      }
+
+      std::cout << std::endl;
+      Profiler::report (std::cout);
+
+      if (Profiler::isTickAllocating())
+      {
+         std::cerr << "The tick is allocating memory, it should reuse what the last tick used." << std::endl;
+         return 1;
+      }
+
+      return result;
+   }
+
+
+   /// Fills modify with the argument at index, false if it is missing, not a number or too big for an unsigned int
+   bool readNumber (const int argc, char** argv, const int index, unsigned int& modify)
+   {
+      if (index >= argc)
+      {
+         return false;
+      }
+
+      char* end {nullptr};
+      errno = 0;
+      const unsigned long value = std::strtoul (argv[index], &end, 10);
+
+      if (*argv[index] == '\0' || *end != '\0' || errno == ERANGE || value > UINT_MAX)
+      {
+         return false;
+      }
+
+      modify = value;
+      return true;
+   }
+
+
+   /// Plays every replay in the file without drawing anything, a replay which ends early or whose state hash stops
+   /// matching has stopped following the rules it was recorded with
+   int playReplays (const std::string& path)
+   {
+      std::vector<std::shared_ptr<const Replay>> replays;
+      Replay::load (path, replays);
+
+      unsigned long long ticks {0};
+      unsigned int diverged {0};
+      const auto start = std::chrono::steady_clock::now();
+
+      for (const auto& replay : replays)
+      {
+         World world {replay->getSetup(), replay->getSeed()};
+         ReplayPlayer player {replay, world};
+
+         while (!player.isFinished())
+         {
+            player.step();
+         }
+
+         ticks += world.getTick();
+
+         if (player.hasDiverged())
+         {
+            ++diverged;
+         }
+      }
+
+      const double seconds = std::chrono::duration<double> (std::chrono::steady_clock::now() - start).count();
+
+      std::cout << std::fixed << std::setprecision (1);
+      std::cout << "Replays:      " << replays.size() << std::endl
+                << "Ticks:        " << ticks << " in " << seconds << "s" << std::endl
+                << "Ticks/sec:    " << (seconds > 0.0 ? ticks / seconds : 0.0) << std::endl
+                << "Diverged:     " << diverged << std::endl;
+
+      return diverged == 0 ? 0 : 1;
+   }
+
+
+   /// Loads every saved game and plays it on to the end, the time taken to load is reported separately as that is
+   /// what a player waits for
+   int resumeGames (const std::vector<std::string>& paths, const unsigned int maxTicks)
+   {
+      unsigned long long ticks {0};
+      unsigned int unfinished {0};
+      double loadSeconds {0.0}, playSeconds {0.0};
+
+      for (const auto& path : paths)
+      {
+         const auto loadStart = std::chrono::steady_clock::now();
+
+         const SaveGame save {path};
+         World world {save.getSetup(), save.getSeed()};
+         save.restore (world);
+
+         const auto playStart = std::chrono::steady_clock::now();
+         const unsigned long long startTick = world.getTick();
+
+         while (!world.isGameOver() && (maxTicks == 0 || world.getTick() - startTick < maxTicks))
+         {
+            world.step();
+         }
+
+         const auto end = std::chrono::steady_clock::now();
+         loadSeconds += std::chrono::duration<double> (playStart - loadStart).count();
+         playSeconds += std::chrono::duration<double> (end - playStart).count();
+         ticks += world.getTick() - startTick;
+
+         if (!world.isGameOver())
+         {
+            ++unfinished;
+         }
+      }
+
+      std::cout << std::fixed << std::setprecision (1);
+      std::cout << "Saves:        " << paths.size() << std::endl
+                << "Load:         " << loadSeconds * 1000000.0 / paths.size() << "us per save" << std::endl
+                << "Ticks:        " << ticks << " in " << playSeconds << "s" << std::endl
+                << "Ticks/sec:    " << (playSeconds > 0.0 ? ticks / playSeconds : 0.0) << std::endl
+                << "Unfinished:   " << unfinished << std::endl;
+
+      return 0;
+   }
+}
+
+
+int main (int argc, char** argv)
+{
+   unsigned int matches {100}, width {40}, height {40}, snakes {4}, foodMin {3}, foodMax {8}, seed {1};
+   unsigned int maxTicks {100000}, threads {0}, interval {100}, rolloutThreads {0};
+   std::string ai {"smart"}, record {""}, play {""};
+   std::vector<std::string> resume;
+   bool profile {false};
+
+   /// Read the options
+   for (int i {1}; i < argc; ++i)
+   {
+      bool valid {true};
+
+      if (std::strcmp (argv[i], "--matches") == 0)
+      {
+         valid = readNumber (argc, argv, ++i, matches);
+      }
+
+      else if (std::strcmp (argv[i], "--grid") == 0)
+      {
+         valid = readNumber (argc, argv, ++i, width) && readNumber (argc, argv, ++i, height);
+      }
+
+      else if (std::strcmp (argv[i], "--snakes") == 0)
+      {
+         valid = readNumber (argc, argv, ++i, snakes);
+      }
+
+      else if (std::strcmp (argv[i], "--ai") == 0)
+      {
+         valid = ++i < argc;
+         ai = valid ? argv[i] : "";
+      }
+
+      else if (std::strcmp (argv[i], "--food") == 0)
+      {
+         valid = readNumber (argc, argv, ++i, foodMin) && readNumber (argc, argv, ++i, foodMax);
+      }
+
+      else if (std::strcmp (argv[i], "--seed") == 0)
+      {
+         valid = readNumber (argc, argv, ++i, seed);
+      }
+
+      else if (std::strcmp (argv[i], "--max-ticks") == 0)
+      {
+         valid = readNumber (argc, argv, ++i, maxTicks);
+      }
+
+      else if (std::strcmp (argv[i], "--threads") == 0)
+      {
+         valid = readNumber (argc, argv, ++i, threads);
+      }
+
+      else if (std::strcmp (argv[i], "--interval") == 0)
+      {
+         valid = readNumber (argc, argv, ++i, interval);
+      }
+
+      else if (std::strcmp (argv[i], "--rollout-threads") == 0)
+      {
+         valid = readNumber (argc, argv, ++i, rolloutThreads);
+      }
+
+      else if (std::strcmp (argv[i], "--record") == 0)
+      {
+         valid = ++i < argc;
+         record = valid ? argv[i] : "";
+      }
+
+      else if (std::strcmp (argv[i], "--play") == 0)
+      {
+         valid = ++i < argc;
+         play = valid ? argv[i] : "";
+      }
+
+      else if (std::strcmp (argv[i], "--resume") == 0)
+      {
+         valid = ++i < argc;
+
+         if (valid)
+         {
+            resume.push_back (argv[i]);
+         }
+      }
+
+      else if (std::strcmp (argv[i], "--profile") == 0)
+      {
+         profile = true;
+      }
+
+      else
+      {
+         valid = false;
+      }
+
+      if (!valid || snakes == 0)
+      {
+         printUsage();
+         return 1;
+      }
+   }
+
+   Profiler::setEnabled (profile);
+
+   /// A replay carries its own setup so nothing else applies
+   if (!play.empty())
+   {
+      try
+      {
+         return printProfile (playReplays (play));
+      }
+
+      catch (const std::runtime_error& error)
+      {
+         std::cerr << error.what() << std::endl;
+         return 1;
+      }
+   }
+
+   /// As does a saved game
+   if (!resume.empty())
+   {
+      try
+      {
+         return printProfile (resumeGames (resume, maxTicks));
+      }
+
+      catch (const std::runtime_error& error)
+      {
+         std::cerr << error.what() << std::endl;
+         return 1;
+      }
+   }
+
+   /// SnakeStateSetup clamps what it is given, anything it changes is reported rather than silently ignored
+   SnakeStateSetup setup;
+   setup.setGrid (width, height).setPlayers (0, snakes).setSnakeAI (ai).setFoodLimits (foodMin, foodMax).setSeed (seed);
+   setup.setSnakeInterval (interval).setRolloutThreads (rolloutThreads);
+
+   if (setup.getGridWidth() != width || setup.getGridHeight() != height)
+   {
+      std::cerr << "The grid must be between 8x8 and 8192x8192." << std::endl;
+      return 1;
+   }
+
+   if (setup.getSnakeAI() != ai)
+   {
+      std::cerr << "Unknown AI \"" << ai << "\", use generic, dumb, smart, pathfinding or mcts." << std::endl;
+      return 1;
+   }
+
+   if (setup.getSnakeUpdateInterval() != interval)
+   {
+      std::cerr << "The interval must be at least 17ms." << std::endl;
+      return 1;
+   }
+
+   if (setup.getFoodMin() != foodMin || setup.getFoodMax() != foodMax)
+   {
+      std::cerr << "The food limits must be positive with MIN <= MAX." << std::endl;
+      return 1;
+   }
+
+   if (setup.getAI() != snakes)
+   {
+      std::cerr << "Only " << setup.getAI() << " Snakes fit on this grid, playing with that many." << std::endl;
+   }
+
+   /// Play and report
+   BatchRunner runner {setup, matches, maxTicks, threads};
+   runner.setReplayPath (record);
+
+   try
+   {
+      runner.run();
+   }
+
+   catch (const std::runtime_error& error)
+   {
+      std::cerr << error.what() << std::endl;
+      return 1;
+   }
+
+   runner.report (std::cout);
+
+   return printProfile (0);
+}
@@ -0,0 +1,234 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <simulation/replay.hpp>
+
+
+/// STL
+#include <cstdint>   // The file format
+#include <cstring>   // std::memcmp
+#include <fstream>   // load()
+#include <iterator>  // load()
+
+
+/// Personal
+#include <simulation/replayrecorder.hpp> // The file format
+#include <simulation/savegame.hpp>       // Keyframes
+
+
+/// Constructors and destructor
+/// The layout is described by ReplayRecorder. The setup is rebuilt through its setters so a value they would change
+/// means the replay can't be played back as it was recorded
+Replay::Replay (const unsigned char* data, const std::size_t size)
+   :  m_setup(), m_seed (0), m_ticks (0), m_snakes (0), m_moves (0), m_keyframes (0), m_hash (0), m_byteSize (0)
+{
+   std::size_t position {0};
+
+   const auto read = [&] () -> std::uint32_t
+   {
+      // Pre-condition: The header is complete
+      if (size - position < 4)
+      {
+         throw std::runtime_error ("Attempt to read a Replay which has been cut short.");
+      }
+
+      const std::uint32_t value = data[position] | (data[position + 1] << 8) | (data[position + 2] << 16) |
+                                  ((std::uint32_t) data[position + 3] << 24);
+      position += 4;
+
+      return value;
+   };
+
+   // Pre-condition: The data is a replay of this version
+   if (size < 4 || std::memcmp (data, ReplayRecorder::kMagic, 4) != 0)
+   {
+      throw std::runtime_error ("Attempt to read a Replay from data which isn't a replay.");
+   }
+
+   position = 4;
+
+   if (read() != ReplayRecorder::kVersion)
+   {
+      throw std::runtime_error ("Attempt to read a Replay recorded by an unknown version.");
+   }
+
+   const bool runLength = (read() & ReplayRecorder::kRunLength) != 0;
+   m_seed = read();
+
+   std::uint32_t values[11];
+
+   for (auto& value : values)
+   {
+      value = read();
+   }
+
+   m_ticks = read();
+   const std::uint32_t dataSize = read();
+   const std::uint32_t aiLength = read();
+   const std::uint32_t keyframes = read();
+
+   if (size - position < aiLength || size - position - aiLength < dataSize)
+   {
+      throw std::runtime_error ("Attempt to read a Replay which has been cut short.");
+   }
+
+   const std::string ai (data + position, data + position + aiLength);
+   position += aiLength;
+
+   /// Rebuild the setup in the order its setters depend on each other
+   m_setup.setResolution (values[0], values[1]);
+   m_setup.setGrid (values[2], values[3]).setPlayers (values[4], values[5]).setSnakeAI (ai);
+   m_setup.setFoodLimits (values[6], values[7]).setScoring (values[8]).setSnakeInterval (values[9]).setSeed (m_seed);
+
+   if (m_setup.getResX() != values[0] || m_setup.getResY() != values[1] || m_setup.getGridWidth() != values[2] ||
+       m_setup.getGridHeight() != values[3] || m_setup.getHumans() != values[4] || m_setup.getAI() != values[5] ||
+       m_setup.getFoodMin() != values[6] || m_setup.getFoodMax() != values[7] || m_setup.getScoreFood() != values[8] ||
+       m_setup.getSnakeUpdateInterval() != values[9] || m_setup.getFoodRotInterval() != values[10] ||
+       m_setup.getSnakeAI() != ai)
+   {
+      throw std::runtime_error ("Attempt to read a Replay whose setup can't be recreated.");
+   }
+
+   /// Decode the stream, undoing the run-length encoding and the exclusive or with the previous move
+   m_snakes = m_setup.getHumans() + m_setup.getAI();
+   const std::size_t moves = (std::size_t) m_ticks * m_snakes;
+   m_moves.assign ((moves + 3) / 4, 0);
+
+   std::vector<unsigned char> previous (m_snakes, 0);
+   const std::size_t end = position + dataSize;
+   std::size_t move {0};
+
+   const auto decode = [&] (const unsigned char byte)
+   {
+      for (unsigned int shift {0}; shift < 8 && move < moves; shift += 2, ++move)
+      {
+         auto& code = previous[move % m_snakes];
+         code ^= (byte >> shift) & 3;
+         m_moves[move / 4] |= code << ((move % 4) * 2);
+      }
+   };
+
+   while (position < end && move < moves)
+   {
+      const unsigned char byte = data[position++];
+
+      if (runLength && byte == 0)
+      {
+         // Pre-condition: Every zero is followed by a count
+         if (position == end)
+         {
+            throw std::runtime_error ("Attempt to read a Replay with a broken run of moves.");
+         }
+
+         for (unsigned int i {0}; i <= data[position]; ++i)
+         {
+            decode (0);
+         }
+
+         ++position;
+      }
+
+      else
+      {
+         decode (byte);
+      }
+   }
+
+   // Post-condition: Every tick has been decoded
+   if (move < moves)
+   {
+      throw std::runtime_error ("Attempt to read a Replay with moves missing.");
+   }
+
+   /// Each save is copied out so it lies on its own aligned memory, reading it checks it's a save of a recorded tick
+   position = end;
+
+   for (std::uint32_t i {0}; i < keyframes; ++i)
+   {
+      const unsigned int tick = read();
+      const std::uint32_t hash = read();
+      const std::uint32_t saveSize = read();
+
+      if (size - position < saveSize)
+      {
+         throw std::runtime_error ("Attempt to read a Replay which has been cut short.");
+      }
+
+      m_keyframes.push_back ({ tick, hash, std::vector<unsigned char> (data + position, data + position + saveSize) });
+      position += saveSize;
+
+      const SaveGame save {m_keyframes.back().save.data(), saveSize};
+
+      if (tick == 0 || tick > m_ticks || save.getTick() != tick || save.getSeed() != m_seed ||
+          (i != 0 && tick <= m_keyframes[i - 1].tick))
+      {
+         throw std::runtime_error ("Attempt to read a Replay with a keyframe of a tick which wasn't recorded.");
+      }
+   }
+
+   m_hash = read();
+   m_byteSize = position;
+}
+
+
+
+/// Functionality
+void Replay::load (const std::string& path, std::vector<std::shared_ptr<const Replay>>& modify)
+{
+   std::ifstream file (path, std::ios::binary);
+
+   // Pre-condition: The file can be read
+   if (!file)
+   {
+      throw std::runtime_error ("Unable to open the replay file \"" + path + "\".");
+   }
+
+   const std::vector<unsigned char> data ((std::istreambuf_iterator<char> (file)), std::istreambuf_iterator<char>());
+   std::size_t position {0};
+
+   while (position < data.size())
+   {
+      auto replay = std::make_shared<const Replay> (data.data() + position, data.size() - position);
+      position += replay->getByteSize();
+
+      modify.push_back (std::move (replay));
+   }
+}
+
+
+
+/// Getters
+void Replay::getMoves (const unsigned int tick, std::vector<Movement>& modify) const
+{
+   // Pre-condition: The tick was recorded
+   if (tick >= m_ticks)
+   {
+      throw std::runtime_error ("Attempt to read the moves of a tick which wasn't recorded in the Replay.");
+   }
+
+   modify.resize (m_snakes);
+   std::size_t move = (std::size_t) tick * m_snakes;
+
+   for (auto& movement : modify)
+   {
+      movement = (Movement) (((m_moves[move / 4] >> ((move % 4) * 2)) & 3) + 1);
+      ++move;
+   }
+}
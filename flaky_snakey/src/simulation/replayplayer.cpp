@@ -0,0 +1,133 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <simulation/replayplayer.hpp>
+
+
+/// STL
+#include <algorithm> // std::upper_bound
+
+
+/// Personal
+#include <simulation/savegame.hpp> // seek()
+
+
+/// Constructors and destructor
+ReplayPlayer::ReplayPlayer (const std::shared_ptr<const Replay>& replay, World& world)
+   :  m_pReplay (replay), m_world (world), m_keyframes (0), m_moves (0), m_diverged (false)
+{
+   // Pre-condition: The World is where the replay begins
+   if (!m_pReplay || m_world.getTick() != 0 || m_world.getSeed() != m_pReplay->getSeed() ||
+       m_world.getSnakeManager()->getSnakeAmount() != m_pReplay->getSnakeAmount())
+   {
+      throw std::runtime_error ("ReplayPlayer was given a World which the Replay doesn't begin from.");
+   }
+
+   m_keyframes.resize (m_pReplay->getKeyframes().size() + 1);
+   m_keyframes.front().reset (new World::Snapshot());
+   m_world.save (*m_keyframes.front());
+}
+
+
+
+/// Functionality
+/// A keyframe reached by playing is kept straight away, restoring it later is then as cheap as restoring the start
+void ReplayPlayer::step()
+{
+   if (isFinished())
+   {
+      return;
+   }
+
+   m_pReplay->getMoves (m_world.getTick(), m_moves);
+   m_world.step (m_moves);
+
+   const unsigned int tick = m_world.getTick();
+   const unsigned int keyframe = countKeyframes (tick);
+
+   if (keyframe != 0 && m_pReplay->getKeyframes()[keyframe - 1].tick == tick)
+   {
+      m_diverged |= m_world.getStateHash() != m_pReplay->getKeyframes()[keyframe - 1].hash;
+
+      if (!m_keyframes[keyframe])
+      {
+         m_keyframes[keyframe].reset (new World::Snapshot());
+         m_world.save (*m_keyframes[keyframe]);
+      }
+   }
+
+   if (tick == m_pReplay->getTicks())
+   {
+      m_diverged |= m_world.getStateHash() != m_pReplay->getStateHash();
+   }
+
+   else
+   {
+      m_diverged |= m_world.isGameOver();
+   }
+}
+
+
+/// Restoring is only needed when going backwards or when the nearest keyframe is further ahead than the World
+void ReplayPlayer::seek (const unsigned int tick)
+{
+   const unsigned int target = tick < m_pReplay->getTicks() ? tick : m_pReplay->getTicks();
+   const unsigned int keyframe = countKeyframes (target);
+   const unsigned int keyframeTick = keyframe == 0 ? 0 : m_pReplay->getKeyframes()[keyframe - 1].tick;
+
+   if (m_world.getTick() > target || m_world.getTick() < keyframeTick)
+   {
+      auto& snapshot = m_keyframes[keyframe];
+
+      if (snapshot)
+      {
+         m_world.restore (*snapshot);
+      }
+
+      else
+      {
+         const auto& data = m_pReplay->getKeyframes()[keyframe - 1].save;
+         const SaveGame save {data.data(), data.size()};
+         save.restore (m_world);
+
+         snapshot.reset (new World::Snapshot());
+         m_world.save (*snapshot);
+      }
+   }
+
+   while (m_world.getTick() < target && !isFinished())
+   {
+      step();
+   }
+}
+
+
+
+/// Getters
+unsigned int ReplayPlayer::countKeyframes (const unsigned int tick) const
+{
+   const auto& keyframes = m_pReplay->getKeyframes();
+
+   return std::upper_bound (keyframes.begin(), keyframes.end(), tick,
+                            [] (const unsigned int value, const Replay::Keyframe& keyframe)
+                            {
+                               return value < keyframe.tick;
+                            }) - keyframes.begin();
+}
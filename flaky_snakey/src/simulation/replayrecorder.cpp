@@ -0,0 +1,215 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <simulation/replayrecorder.hpp>
+
+
+/// STL
+#include <algorithm> // std::max
+
+
+/// Personal
+#include <simulation/savegame.hpp> // record()
+
+
+/// Static members are passed by reference so they need defining
+const char ReplayRecorder::kMagic[4] { 'F', 'S', 'R', 'P' };
+const std::uint32_t ReplayRecorder::kVersion;
+const std::uint32_t ReplayRecorder::kRunLength;
+const unsigned int ReplayRecorder::kKeyframeInterval;
+const unsigned int ReplayRecorder::kKeyframeBytes;
+
+
+
+/// Constructors and destructor
+ReplayRecorder::ReplayRecorder (const SnakeStateSetup& setup, const unsigned int seed, const bool runLength)
+   :  m_kSetup (setup), m_kSeed (seed), m_kRunLength (runLength), m_previous (setup.getHumans() + setup.getAI(), 0),
+      m_data (0), m_keyframes (0), m_save (0), m_keyframeCount (0), m_nextKeyframe (kKeyframeInterval),
+      m_byte (0), m_bits (0), m_zeros (0), m_ticks (0)
+{
+}
+
+
+
+/// Functionality
+/// Every Snake that was alive at the start of the tick moved, whether or not it survived, so its last move is the move
+/// of this tick. The rest repeat their last move which records as a zero
+void ReplayRecorder::record (const World& world)
+{
+   const SnakeManager& snakes = *world.getSnakeManager();
+
+   // Pre-condition: The Snakes are those of the recorded World
+   if (snakes.getSnakeAmount() != m_previous.size())
+   {
+      throw std::runtime_error ("ReplayRecorder::record() was given a different amount of snakes to the setup.");
+   }
+
+   for (unsigned int i {0}; i < m_previous.size(); ++i)
+   {
+      const unsigned char code = (unsigned char) snakes.getSnakeLastMove (i) - 1;
+
+      addMove ((code ^ m_previous[i]) & 3);
+      m_previous[i] = code;
+   }
+
+   ++m_ticks;
+
+   /// The keyframe is laid out as it will be written so saving only has to copy it
+   if (m_ticks == m_nextKeyframe)
+   {
+      SaveGame::write (m_kSetup, world, m_save);
+
+      addNumber (m_keyframes, m_ticks);
+      addNumber (m_keyframes, world.getStateHash());
+      addNumber (m_keyframes, (std::uint32_t) m_save.size());
+      m_keyframes.insert (m_keyframes.end(), m_save.begin(), m_save.end());
+      ++m_keyframeCount;
+
+      /// Writing a save costs about the same per byte, spacing them by size keeps the share of each tick fixed
+      m_nextKeyframe = m_ticks + std::max (kKeyframeInterval, (unsigned int) (m_save.size() / kKeyframeBytes));
+   }
+}
+
+
+void ReplayRecorder::save (const World& world, std::vector<unsigned char>& modify) const
+{
+   // Pre-condition: Every tick of the World has been recorded
+   if (world.getTick() != m_ticks)
+   {
+      throw std::runtime_error ("ReplayRecorder::save() was given a World on a tick which wasn't the last recorded.");
+   }
+
+   /// The held back zeros and the partly packed byte finish the stream, a partly packed zero joins the run
+   std::vector<unsigned char> tail (0);
+
+   if (m_kRunLength)
+   {
+      addZeros (tail, m_bits != 0 && m_byte == 0 ? m_zeros + 1 : m_zeros);
+   }
+
+   if (m_bits != 0 && (m_byte != 0 || !m_kRunLength))
+   {
+      tail.push_back (m_byte);
+   }
+
+   /// Header
+   const std::string& ai = m_kSetup.getSnakeAI();
+
+   modify.clear();
+   modify.reserve (4 + 18 * 4 + ai.size() + m_data.size() + tail.size() + m_keyframes.size() + 4);
+   modify.insert (modify.end(), kMagic, kMagic + 4);
+
+   for (const std::uint32_t value : { kVersion, m_kRunLength ? kRunLength : 0u, (std::uint32_t) m_kSeed,
+                                      (std::uint32_t) m_kSetup.getResX(), (std::uint32_t) m_kSetup.getResY(),
+                                      (std::uint32_t) m_kSetup.getGridWidth(), (std::uint32_t) m_kSetup.getGridHeight(),
+                                      (std::uint32_t) m_kSetup.getHumans(), (std::uint32_t) m_kSetup.getAI(),
+                                      (std::uint32_t) m_kSetup.getFoodMin(), (std::uint32_t) m_kSetup.getFoodMax(),
+                                      (std::uint32_t) m_kSetup.getScoreFood(),
+                                      (std::uint32_t) m_kSetup.getSnakeUpdateInterval(),
+                                      (std::uint32_t) m_kSetup.getFoodRotInterval(), (std::uint32_t) m_ticks,
+                                      (std::uint32_t) (m_data.size() + tail.size()), (std::uint32_t) ai.size(),
+                                      (std::uint32_t) m_keyframeCount })
+   {
+      addNumber (modify, value);
+   }
+
+   modify.insert (modify.end(), ai.begin(), ai.end());
+
+   /// Data
+   modify.insert (modify.end(), m_data.begin(), m_data.end());
+   modify.insert (modify.end(), tail.begin(), tail.end());
+
+   /// Keyframes
+   modify.insert (modify.end(), m_keyframes.begin(), m_keyframes.end());
+   addNumber (modify, world.getStateHash());
+}
+
+
+void ReplayRecorder::write (const World& world, BackgroundWriter& writer) const
+{
+   std::vector<unsigned char> replay (0);
+   save (world, replay);
+
+   writer.write (replay.data(), replay.size());
+}
+
+
+/// Packs two bits into m_byte, storing it once it's full
+void ReplayRecorder::addMove (const unsigned int bits)
+{
+   m_byte |= bits << m_bits;
+   m_bits += 2;
+
+   if (m_bits == 8)
+   {
+      addByte (m_byte);
+      m_byte = 0;
+      m_bits = 0;
+   }
+}
+
+
+/// Zeros are only stored once the run ends or reaches the longest run a count can hold
+void ReplayRecorder::addByte (const unsigned char byte)
+{
+   if (!m_kRunLength)
+   {
+      m_data.push_back (byte);
+   }
+
+   else if (byte == 0)
+   {
+      if (++m_zeros == 256)
+      {
+         addZeros (m_data, m_zeros);
+         m_zeros = 0;
+      }
+   }
+
+   else
+   {
+      addZeros (m_data, m_zeros);
+      m_zeros = 0;
+      m_data.push_back (byte);
+   }
+}
+
+
+/// Appends a run of zero bytes to modify as a zero and a count for every 256 of them
+void ReplayRecorder::addZeros (std::vector<unsigned char>& modify, unsigned int zeros)
+{
+   while (zeros != 0)
+   {
+      const unsigned int run = zeros < 256 ? zeros : 256;
+
+      modify.push_back (0);
+      modify.push_back ((unsigned char) (run - 1));
+      zeros -= run;
+   }
+}
+
+
+void ReplayRecorder::addNumber (std::vector<unsigned char>& modify, const std::uint32_t value)
+{
+   for (unsigned int shift {0}; shift < 32; shift += 8)
+   {
+      modify.push_back ((unsigned char) (value >> shift));
+   }
+}
@@ -0,0 +1,146 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <simulation/rolloutpool.hpp>
+
+
+/// Constructors and destructor
+/// Every World is made from the setup with the generic AI so a World playing ahead never makes a RolloutPool itself
+RolloutPool::RolloutPool (const SnakeStateSetup& setup, const unsigned int threads)
+   :  m_kBudget (setup.getSnakeUpdateInterval() * kBudgetPercent * 10), m_worlds(), m_idle (0), m_root(),
+      m_rootTick (0), m_tickDeadline(), m_pRollout (nullptr), m_deadline(), m_mutex(), m_start(), m_done(),
+      m_generation (0), m_busy (0), m_closing (false), m_threads (0)
+{
+   /// 0 asks for one thread per hardware thread, but at least one even if hardware_concurrency() doesn't know
+   unsigned int count {threads == 0 ? std::thread::hardware_concurrency() : threads};
+
+   if (count == 0) { count = 1; }
+
+   SnakeStateSetup ahead {setup};
+   ahead.setSnakeAI ("generic");
+
+   m_worlds.reserve (count);
+   m_idle.resize (count);
+
+   for (unsigned int i {0}; i < count; ++i)
+   {
+      m_worlds.emplace_back (ahead, i);
+      m_worlds.back().setAllocationsRecorded (false);
+      m_worlds.back().save (m_idle[i]);
+   }
+
+   m_threads.reserve (count);
+
+   for (unsigned int i {0}; i < count; ++i)
+   {
+      m_threads.emplace_back (&RolloutPool::work, this, i);
+   }
+}
+
+
+RolloutPool::~RolloutPool()
+{
+   {
+      std::lock_guard<std::mutex> lock {m_mutex};
+
+      m_closing = true;
+      m_start.notify_all();
+   }
+
+   for (auto& thread : m_threads)
+   {
+      thread.join();
+   }
+}
+
+
+
+/// Functionality
+void RolloutPool::run (const Rollout& rollout, const std::chrono::steady_clock::time_point deadline)
+{
+   std::unique_lock<std::mutex> lock {m_mutex};
+
+   m_pRollout = &rollout;
+   m_deadline = deadline;
+   m_busy = m_threads.size();
+   ++m_generation;
+
+   m_start.notify_all();
+   m_done.wait (lock, [this] () { return m_busy == 0; });
+
+   m_pRollout = nullptr;
+}
+
+
+/// A thread may only start once the first run has, so every thread starts from generation 0 rather than the current
+void RolloutPool::work (const unsigned int worker)
+{
+   std::unique_lock<std::mutex> lock {m_mutex};
+   unsigned int generation {0};
+
+   while (true)
+   {
+      m_start.wait (lock, [this, generation] () { return m_generation != generation || m_closing; });
+
+      if (m_closing)
+      {
+         break;
+      }
+
+      generation = m_generation;
+      lock.unlock();
+
+      play (worker);
+
+      lock.lock();
+
+      if (--m_busy == 0)
+      {
+         m_done.notify_one();
+      }
+   }
+}
+
+
+/// m_pRollout and m_deadline were set before the thread was woken and don't change until every thread has finished.
+/// Food is made by the FoodManager of the World that spawned it and must be let go of on that World's thread, so the
+/// World lets go of the root before it idles; the root still holds all of its Food and the game's own thread is
+/// the only one which ever replaces the root
+void RolloutPool::play (const unsigned int worker)
+{
+   auto& world = m_worlds[worker];
+
+   do
+   {
+      (*m_pRollout) (world, worker);
+   }
+   while (std::chrono::steady_clock::now() < m_deadline);
+
+   world.restore (m_idle[worker]);
+}
+
+
+
+/// Assignment functions
+void RolloutPool::setRoot (const World& world)
+{
+   world.save (m_root);
+   m_rootTick = world.getTick();
+   m_tickDeadline = std::chrono::steady_clock::now() + m_kBudget;
+}
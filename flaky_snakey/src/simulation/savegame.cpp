@@ -0,0 +1,801 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <simulation/savegame.hpp>
+
+
+/// STL
+#include <algorithm> // std::max
+#include <cstring>   // std::memcmp and std::memcpy
+#include <fstream>   // write() and the constructor without mmap
+#include <iterator>  // The constructor without mmap
+
+
+/// System
+#ifndef _WIN32
+#include <fcntl.h>     // open()
+#include <sys/mman.h>  // mmap()
+#include <sys/stat.h>  // fstat()
+#include <unistd.h>    // close()
+#endif
+
+
+/// Static members are passed by reference so they need defining
+const char SaveGame::kMagic[4] = { 'F', 'S', 'S', 'V' };
+const std::uint32_t SaveGame::kVersion;
+const std::uint32_t SaveGame::kByteOrder;
+const unsigned int SaveGame::kAILength;
+const std::uint32_t SaveGame::kNeverRots;
+const std::uint8_t SaveGame::kJump;
+
+
+/// The layout must not depend on the compiler
+static_assert (sizeof (SaveGame::Header) == 200, "SaveGame::Header must have no padding.");
+static_assert (sizeof (SaveGame::SnakeRecord) == 28, "SaveGame::SnakeRecord must have no padding.");
+static_assert (sizeof (SaveGame::CellRecord) == 4, "SaveGame::CellRecord must have no padding.");
+static_assert (sizeof (SaveGame::DeadRecord) == 8, "SaveGame::DeadRecord must have no padding.");
+static_assert (sizeof (SaveGame::FoodRecord) == 16, "SaveGame::FoodRecord must have no padding.");
+static_assert (sizeof (SaveGame::ObstacleRecord) == 8, "SaveGame::ObstacleRecord must have no padding.");
+
+
+
+/// Constructors and destructor
+SaveGame::SaveGame (const unsigned char* data, const std::size_t size)
+   :  m_pData (data), m_size (size), m_pHeader (nullptr), m_pMapping (nullptr), m_buffer (0)
+{
+   validate();
+}
+
+
+SaveGame::SaveGame (const std::string& path)
+   :  m_pData (nullptr), m_size (0), m_pHeader (nullptr), m_pMapping (nullptr), m_buffer (0)
+{
+   #ifdef _WIN32
+
+   std::ifstream file (path, std::ios::binary);
+
+   // Pre-condition: The file can be read
+   if (!file)
+   {
+      throw std::runtime_error ("Unable to open the save file \"" + path + "\".");
+   }
+
+   m_buffer.assign (std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char>());
+   m_pData = m_buffer.data();
+   m_size = m_buffer.size();
+
+   #else
+
+   const int file = open (path.c_str(), O_RDONLY);
+   struct stat status;
+
+   // Pre-condition: The file can be read
+   if (file < 0 || fstat (file, &status) != 0 || status.st_size <= 0)
+   {
+      if (file >= 0)
+      {
+         close (file);
+      }
+
+      throw std::runtime_error ("Unable to open the save file \"" + path + "\".");
+   }
+
+   /// The mapping stays valid once the file is closed
+   void* const mapping = mmap (nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+   close (file);
+
+   if (mapping == MAP_FAILED)
+   {
+      throw std::runtime_error ("Unable to map the save file \"" + path + "\".");
+   }
+
+   m_pMapping = mapping;
+   m_pData = static_cast<const unsigned char*> (mapping);
+   m_size = status.st_size;
+
+   #endif
+
+   /// The destructor won't run if the constructor throws
+   try
+   {
+      validate();
+   }
+
+   catch (...)
+   {
+      unmap();
+      throw;
+   }
+}
+
+
+SaveGame::~SaveGame()
+{
+   unmap();
+}
+
+
+
+/// Functionality
+/// Everything is taken from a World::Snapshot so the save holds exactly what restoring a Snapshot would
+void SaveGame::write (const SnakeStateSetup& setup, const World& world, std::vector<unsigned char>& modify)
+{
+   // Pre-condition: The AI name fits in the header
+   if (setup.getSnakeAI().size() >= kAILength)
+   {
+      throw std::runtime_error ("Attempt to save a game whose AI name is too long.");
+   }
+
+   World::Snapshot snapshot;
+   world.save (snapshot);
+
+   const auto& grid = snapshot.m_grid;
+   const auto& food = snapshot.m_food;
+   const auto& obstacles = snapshot.m_obstacles.m_obstacles;
+   const auto& snakes = snapshot.m_snakes;
+
+   // Pre-condition: The setup is the one the World was created with
+   if (snakes.m_snakes.size() != setup.getHumans() + setup.getAI())
+   {
+      throw std::runtime_error ("Attempt to save a game with a setup it wasn't created with.");
+   }
+
+   /// Fill in the header and work out where each section goes
+   Header header;
+   std::memset (&header, 0, sizeof (header));
+   std::memcpy (header.magic, kMagic, sizeof (kMagic));
+   header.version = kVersion;
+   header.byteOrder = kByteOrder;
+
+   header.resX = setup.getResX();
+   header.resY = setup.getResY();
+   header.gridWidth = setup.getGridWidth();
+   header.gridHeight = setup.getGridHeight();
+   header.humans = setup.getHumans();
+   header.ai = setup.getAI();
+   header.foodMin = setup.getFoodMin();
+   header.foodMax = setup.getFoodMax();
+   header.scoreFood = setup.getScoreFood();
+   header.snakeInterval = setup.getSnakeUpdateInterval();
+   header.rotInterval = setup.getFoodRotInterval();
+   std::memcpy (header.snakeAI, setup.getSnakeAI().c_str(), setup.getSnakeAI().size());
+
+   header.seed = world.getSeed();
+   header.tick = snapshot.m_tick;
+   header.spawnAvailable = snapshot.m_spawnAvailable;
+   header.spawnRequired = food.m_spawnRequired;
+   header.freeCells = grid.m_freeCells;
+   std::memcpy (header.random, snapshot.m_random.m_state, sizeof (header.random));
+   std::memcpy (header.aiRandom, snapshot.m_aiRandom.m_state, sizeof (header.aiRandom));
+
+   /// Every head, jump and flake needs a cell, every other part a move
+   std::size_t parts {0}, moves {0};
+
+   for (const auto& snake : snakes.m_snakes)
+   {
+      parts += 1 + snake.m_flakes.size();
+      moves += snake.m_body.getSize() - 1;
+
+      for (unsigned int j {1}; j < snake.m_body.getSize(); ++j)
+      {
+         parts += getMove (header, snake.m_body[j - 1], snake.m_body[j]) == kJump ? 1 : 0;
+      }
+   }
+
+   std::size_t size {sizeof (Header)};
+
+   /// Each section starts 4-byte aligned, only the moves can leave a gap before the next
+   const auto place = [&size] (Section& section, const std::size_t count, const std::size_t recordSize)
+   {
+      section.offset = size;
+      section.count = count;
+      size += (count * recordSize + 3) & ~(std::size_t) 3;
+   };
+
+   place (header.snakes, snakes.m_snakes.size(), sizeof (SnakeRecord));
+   place (header.parts, parts, sizeof (CellRecord));
+   place (header.moves, moves, sizeof (std::uint8_t));
+   place (header.living, snakes.m_living.size(), sizeof (std::uint32_t));
+   place (header.deadIndex, snakes.m_deadIndex.size(), sizeof (DeadRecord));
+   place (header.food, food.m_foodP.size(), sizeof (FoodRecord));
+   place (header.foodSlots, food.m_slots.size(), sizeof (std::uint32_t));
+   place (header.freeHandles, food.m_freeHandles.size(), sizeof (std::uint32_t));
+   place (header.obstacles, obstacles.size(), sizeof (ObstacleRecord));
+
+   // Pre-condition: Every offset fits in the header
+   if (size > 0xFFFFFFFF)
+   {
+      throw std::runtime_error ("Attempt to save a game which is too large for the save format.");
+   }
+
+   header.size = size;
+
+   /// The records are copied in rather than cast so the buffer needs no particular alignment
+   modify.assign (size, 0);
+   unsigned char* const data = modify.data();
+   std::memcpy (data, &header, sizeof (header));
+
+   const auto put = [data] (const Section& section, const unsigned int index, const void* record,
+                            const std::size_t recordSize)
+   {
+      std::memcpy (data + section.offset + index * recordSize, record, recordSize);
+   };
+
+   /// Snakes, their parts and the collision indices
+   unsigned int part {0}, move {0};
+
+   for (unsigned int i {0}; i < snakes.m_snakes.size(); ++i)
+   {
+      const auto& snake = snakes.m_snakes[i];
+
+      SnakeRecord record;
+      record.firstPart = part;
+      record.firstMove = move;
+      record.size = snake.m_body.getSize();
+      record.flakes = snake.m_flakes.size();
+      record.score = snake.m_score;
+      record.lastEndX = snake.m_lastEnd.x;
+      record.lastEndY = snake.m_lastEnd.y;
+      record.alive = snake.m_alive;
+      record.passThrough = snake.m_passThrough;
+      record.canRollBack = snake.m_canRollBack;
+      record.lastMove = (std::uint8_t) snake.m_lastMove;
+      put (header.snakes, i, &record, sizeof (record));
+
+      const CellRecord head { snake.m_body[0].x, snake.m_body[0].y };
+      put (header.parts, part++, &head, sizeof (head));
+
+      for (unsigned int j {1}; j < snake.m_body.getSize(); ++j)
+      {
+         const std::uint8_t code = getMove (header, snake.m_body[j - 1], snake.m_body[j]);
+         data[header.moves.offset + move++] = code;
+
+         if (code == kJump)
+         {
+            const CellRecord cell { snake.m_body[j].x, snake.m_body[j].y };
+            put (header.parts, part++, &cell, sizeof (cell));
+         }
+      }
+
+      for (const auto& flake : snake.m_flakes)
+      {
+         const CellRecord cell { flake.x, flake.y };
+         put (header.parts, part++, &cell, sizeof (cell));
+      }
+   }
+
+   for (unsigned int i {0}; i < snakes.m_living.size(); ++i)
+   {
+      const std::uint32_t index = snakes.m_living[i];
+      put (header.living, i, &index, sizeof (index));
+   }
+
+   for (unsigned int i {0}; i < snakes.m_deadIndex.size(); ++i)
+   {
+      const DeadRecord record { snakes.m_deadIndex[i].first, snakes.m_deadIndex[i].second };
+      put (header.deadIndex, i, &record, sizeof (record));
+   }
+
+   /// Food and its handles, rot deadlines are stored relative to now as the wheel itself isn't saved
+   for (unsigned int i {0}; i < food.m_foodP.size(); ++i)
+   {
+      const unsigned int handle = food.m_handles[i];
+
+      FoodRecord record;
+      record.x = food.m_foodP[i]->getCell().x;
+      record.y = food.m_foodP[i]->getCell().y;
+      record.effect = food.m_foodP[i]->getFoodEffect();
+      record.handle = handle;
+      record.rotTicks = food.m_rotWheel.isScheduled (handle) ?
+                        food.m_rotWheel.getDeadline (handle) - food.m_rotWheel.getTick() : kNeverRots;
+      put (header.food, i, &record, sizeof (record));
+   }
+
+   for (unsigned int i {0}; i < food.m_slots.size(); ++i)
+   {
+      const std::uint32_t slot = food.m_slots[i];
+      put (header.foodSlots, i, &slot, sizeof (slot));
+   }
+
+   for (unsigned int i {0}; i < food.m_freeHandles.size(); ++i)
+   {
+      const std::uint32_t handle = food.m_freeHandles[i];
+      put (header.freeHandles, i, &handle, sizeof (handle));
+   }
+
+   /// Obstacles
+   for (unsigned int i {0}; i < obstacles.size(); ++i)
+   {
+      const auto& colour = obstacles[i].getColour();
+      const ObstacleRecord record { obstacles[i].getCell().x, obstacles[i].getCell().y,
+                                    colour.getR(), colour.getG(), colour.getB(), colour.getA() };
+      put (header.obstacles, i, &record, sizeof (record));
+   }
+}
+
+
+void SaveGame::write (const SnakeStateSetup& setup, const World& world, const std::string& path)
+{
+   std::vector<unsigned char> data;
+   write (setup, world, data);
+
+   std::ofstream file (path, std::ios::binary | std::ios::trunc);
+   file.write (reinterpret_cast<const char*> (data.data()), data.size());
+
+   // Post-condition: Everything was written
+   if (!file)
+   {
+      throw std::runtime_error ("Unable to write the save file \"" + path + "\".");
+   }
+}
+
+
+/// The records are turned back into a World::Snapshot. Everything is checked before it's used, a damaged save is
+/// refused rather than restored into a game which would later fail
+void SaveGame::restore (World& world) const
+{
+   const Header& header = *m_pHeader;
+   const auto& grid = *world.getGrid();
+
+   // Pre-condition: The World was created from this save's setup
+   if (header.seed != world.getSeed() || header.snakes.count != world.getSnakeManager()->getSnakeAmount() ||
+       header.gridWidth != grid.m_kSetup.getGridWidth() || header.gridHeight != grid.m_kSetup.getGridHeight())
+   {
+      throw std::runtime_error ("Attempt to restore a save into a World created from a different setup.");
+   }
+
+   /// A random engine with no state only ever returns zero
+   if (!(header.random[0] | header.random[1] | header.random[2] | header.random[3]) ||
+       !(header.aiRandom[0] | header.aiRandom[1] | header.aiRandom[2] | header.aiRandom[3]))
+   {
+      refuse();
+   }
+
+   World::Snapshot snapshot;
+   restoreSnakes (snapshot.m_snakes);
+   restoreFood (*world.getFoodManager(), snapshot.m_food);
+   restoreObstacles (snapshot.m_obstacles);
+   restoreGrid (grid, snapshot);
+
+   std::memcpy (snapshot.m_random.m_state, header.random, sizeof (header.random));
+   std::memcpy (snapshot.m_aiRandom.m_state, header.aiRandom, sizeof (header.aiRandom));
+   snapshot.m_tick = header.tick;
+   snapshot.m_spawnAvailable = header.spawnAvailable != 0;
+
+   world.restore (snapshot);
+   world.getSnakeManager()->updateInterface();
+}
+
+
+void SaveGame::restoreSnakes (SnakeManager::Snapshot& modify) const
+{
+   const Header& header = *m_pHeader;
+   const auto parts = getParts();
+   const auto moves = getMoves();
+   const auto snakes = getSnakes();
+
+   modify.m_snakes.resize (header.snakes.count);
+
+   for (unsigned int i {0}; i < header.snakes.count; ++i)
+   {
+      const auto& record = snakes[i];
+      auto& snake = modify.m_snakes[i];
+
+      if (record.size == 0 || record.firstMove > header.moves.count ||
+          header.moves.count - record.firstMove < record.size - 1 ||
+          record.lastMove > (std::uint8_t) Movement::Down || !isInside (record.lastEndX, record.lastEndY))
+      {
+         refuse();
+      }
+
+      /// Takes the next cell of this Snake from the parts section
+      std::uint64_t part {record.firstPart};
+
+      const auto nextCell = [&] () -> Cell
+      {
+         if (part >= header.parts.count || !isInside (parts[part].x, parts[part].y))
+         {
+            refuse();
+         }
+
+         const Cell cell { parts[part].x, parts[part].y };
+         ++part;
+         return cell;
+      };
+
+      Cell cell = nextCell();
+      snake.m_body.pushTail (cell);
+
+      for (unsigned int j {1}; j < record.size; ++j)
+      {
+         const std::uint8_t code = moves[record.firstMove + j - 1];
+
+         if (code > kJump)
+         {
+            refuse();
+         }
+
+         if (code == kJump)
+         {
+            cell = nextCell();
+         }
+
+         else
+         {
+            applyMove (cell, code);
+         }
+
+         snake.m_body.pushTail (cell);
+      }
+
+      for (unsigned int j {0}; j < record.flakes; ++j)
+      {
+         snake.m_flakes.push_back (nextCell());
+      }
+
+      snake.m_lastEnd = { record.lastEndX, record.lastEndY };
+      snake.m_canRollBack = record.canRollBack != 0;
+      snake.m_alive = record.alive != 0;
+      snake.m_passThrough = record.passThrough != 0;
+      snake.m_score = record.score;
+      snake.m_lastMove = (Movement) record.lastMove;
+   }
+
+   /// Every living Snake is listed once in ascending order
+   const auto living = getSection<std::uint32_t> (header.living);
+   unsigned int alive {0};
+
+   for (unsigned int i {0}; i < header.snakes.count; ++i)
+   {
+      alive += modify.m_snakes[i].m_alive ? 1 : 0;
+   }
+
+   if (alive != header.living.count)
+   {
+      refuse();
+   }
+
+   for (unsigned int i {0}; i < header.living.count; ++i)
+   {
+      if (living[i] >= header.snakes.count || !modify.m_snakes[living[i]].m_alive ||
+          (i > 0 && living[i] <= living[i - 1]))
+      {
+         refuse();
+      }
+
+      modify.m_living.push_back (living[i]);
+   }
+
+   /// Dead heads are searched by key so they must be sorted
+   const auto dead = getSection<DeadRecord> (header.deadIndex);
+
+   for (unsigned int i {0}; i < header.deadIndex.count; ++i)
+   {
+      if (dead[i].snake >= header.snakes.count || (i > 0 && dead[i].key < dead[i - 1].key))
+      {
+         refuse();
+      }
+
+      modify.m_deadIndex.emplace_back (dead[i].key, dead[i].snake);
+   }
+
+   modify.m_livingSnakes = modify.m_living.size();
+}
+
+
+/// Each handle either refers to a single Food or is free, never both. No Food can have a larger effect than the
+/// FoodManager gives. The effect range given to the Food is a single value so no random numbers are drawn
+void SaveGame::restoreFood (const FoodManager& foodManager, FoodManager::Snapshot& modify) const
+{
+   const Header& header = *m_pHeader;
+   const auto food = getFood();
+   const auto slots = getSection<std::uint32_t> (header.foodSlots);
+   const auto freeHandles = getSection<std::uint32_t> (header.freeHandles);
+   Random unused;
+
+   /// Food is given an effect of at least one even on a level so small the maximum rounds down to nothing
+   const unsigned int effectMax = std::max (foodManager.getFoodEffectMax(), 1u);
+
+   if (header.food.count + header.freeHandles.count != header.foodSlots.count)
+   {
+      refuse();
+   }
+
+   for (unsigned int i {0}; i < header.food.count; ++i)
+   {
+      const auto& record = food[i];
+      const unsigned int effect = record.effect > 0 ? record.effect : -(std::int64_t) record.effect;
+
+      if (!isInside (record.x, record.y) || effect == 0 || effect > effectMax ||
+          record.handle >= header.foodSlots.count || slots[record.handle] != i)
+      {
+         refuse();
+      }
+
+      std::shared_ptr<Food> piece;
+
+      if (record.effect > 0)
+      {
+         piece = std::make_shared<FatFood> (Cell { record.x, record.y });
+      }
+
+      else
+      {
+         piece = std::make_shared<ThinFood> (Cell { record.x, record.y });
+      }
+
+      piece->setFoodEffect (effect, effect, unused);
+
+      /// The wheel starts again from tick 0, only how long is left matters
+      if (record.rotTicks != kNeverRots)
+      {
+         modify.m_rotWheel.schedule (record.handle, record.rotTicks);
+      }
+
+      modify.m_foodP.push_back (std::move (piece));
+      modify.m_handles.push_back (record.handle);
+   }
+
+   modify.m_slots.assign (slots, slots + header.foodSlots.count);
+
+   for (unsigned int i {0}; i < header.freeHandles.count; ++i)
+   {
+      /// A free handle is marked used once it has been seen so it can't be listed twice
+      if (freeHandles[i] >= header.foodSlots.count || modify.m_slots[freeHandles[i]] != FoodIndex::kNoFood)
+      {
+         refuse();
+      }
+
+      modify.m_slots[freeHandles[i]] = 0;
+      modify.m_freeHandles.push_back (freeHandles[i]);
+   }
+
+   for (const auto handle : modify.m_freeHandles)
+   {
+      modify.m_slots[handle] = FoodIndex::kNoFood;
+   }
+
+   modify.m_spawnRequired = header.spawnRequired != 0;
+}
+
+
+void SaveGame::restoreObstacles (ObstacleManager::Snapshot& modify) const
+{
+   const auto obstacles = getObstacles();
+
+   for (unsigned int i {0}; i < m_pHeader->obstacles.count; ++i)
+   {
+      const auto& record = obstacles[i];
+
+      if (!isInside (record.x, record.y))
+      {
+         refuse();
+      }
+
+      modify.m_obstacles.push_back ({ Cell { record.x, record.y },
+                                      prg::Colour (record.red, record.green, record.blue, record.alpha) });
+   }
+}
+
+
+/// The grid is rebuilt from the records rather than stored, free cells are numbered by where they are so it is the same
+/// grid the World had. Food or Obstacles sharing a cell would be lost and the free cells must add up to those saved
+void SaveGame::restoreGrid (const OccupancyGrid& grid, World::Snapshot& modify) const
+{
+   OccupancyGrid rebuilt {grid.m_kSetup};
+
+   for (const auto& snake : modify.m_snakes.m_snakes)
+   {
+      for (unsigned int i {0}; i < snake.m_body.getSize(); ++i)
+      {
+         rebuilt.addSnakePart (snake.m_body[i]);
+      }
+   }
+
+   for (const auto& food : modify.m_food.m_foodP)
+   {
+      if (rebuilt.isFoodHere (food->getCell()))
+      {
+         refuse();
+      }
+
+      rebuilt.setFood (food->getCell(), true);
+   }
+
+   for (const auto& obstacle : modify.m_obstacles.m_obstacles)
+   {
+      if (rebuilt.isObstacleHere (obstacle.getCell()))
+      {
+         refuse();
+      }
+
+      rebuilt.setObstacle (obstacle.getCell(), true);
+   }
+
+   if (rebuilt.getFreeCells() != m_pHeader->freeCells)
+   {
+      refuse();
+   }
+
+   rebuilt.save (modify.m_grid);
+}
+
+
+
+/// Each section is checked against the size of the save once, the records can then be read without further checks
+void SaveGame::validate() const
+{
+   // Pre-condition: The records can be read where they lie
+   if (reinterpret_cast<std::uintptr_t> (m_pData) % alignof (Header) != 0)
+   {
+      throw std::runtime_error ("Attempt to read a save from unaligned memory.");
+   }
+
+   // Pre-condition: The data is a save of this version
+   if (m_size < sizeof (Header) || std::memcmp (m_pData, kMagic, sizeof (kMagic)) != 0)
+   {
+      throw std::runtime_error ("Attempt to read a save from data which isn't a save.");
+   }
+
+   const auto& header = *reinterpret_cast<const Header*> (m_pData);
+
+   if (header.version != kVersion)
+   {
+      throw std::runtime_error ("Attempt to read a save made by an unknown version.");
+   }
+
+   if (header.byteOrder != kByteOrder)
+   {
+      throw std::runtime_error ("Attempt to read a save made on a machine with a different byte order.");
+   }
+
+   if (header.size > m_size || std::memchr (header.snakeAI, 0, kAILength) == nullptr)
+   {
+      throw std::runtime_error ("Attempt to read a save which is incomplete.");
+   }
+
+   const auto check = [&header] (const Section& section, const std::size_t recordSize)
+   {
+      if (section.offset < sizeof (Header) || section.offset % 4 != 0 ||
+          section.offset + (std::uint64_t) section.count * recordSize > header.size)
+      {
+         throw std::runtime_error ("Attempt to read a save which is incomplete.");
+      }
+   };
+
+   check (header.snakes, sizeof (SnakeRecord));
+   check (header.parts, sizeof (CellRecord));
+   check (header.moves, sizeof (std::uint8_t));
+   check (header.living, sizeof (std::uint32_t));
+   check (header.deadIndex, sizeof (DeadRecord));
+   check (header.food, sizeof (FoodRecord));
+   check (header.foodSlots, sizeof (std::uint32_t));
+   check (header.freeHandles, sizeof (std::uint32_t));
+   check (header.obstacles, sizeof (ObstacleRecord));
+
+   const_cast<SaveGame*> (this)->m_pHeader = &header;
+}
+
+
+void SaveGame::refuse()
+{
+   throw std::runtime_error ("Attempt to restore a damaged save.");
+}
+
+
+std::uint8_t SaveGame::getMove (const Header& header, const Cell& from, const Cell& to)
+{
+   /// A step across the edge of the level is the whole width or height the other way
+   const int width = header.gridWidth;
+   const int height = header.gridHeight;
+   const int moveX = to.x - from.x;
+   const int moveY = to.y - from.y;
+
+   if (moveY == 0)
+   {
+      return moveX == 0 ? (std::uint8_t) Movement::Null :
+             moveX == 1 || moveX == 1 - width ? (std::uint8_t) Movement::Right :
+             moveX == -1 || moveX == width - 1 ? (std::uint8_t) Movement::Left : kJump;
+   }
+
+   if (moveX == 0)
+   {
+      return moveY == 1 || moveY == 1 - height ? (std::uint8_t) Movement::Up :
+             moveY == -1 || moveY == height - 1 ? (std::uint8_t) Movement::Down : kJump;
+   }
+
+   return kJump;
+}
+
+
+void SaveGame::applyMove (Cell& modify, const std::uint8_t move) const
+{
+   const unsigned int width = m_pHeader->gridWidth;
+   const unsigned int height = m_pHeader->gridHeight;
+
+   switch ((Movement) move)
+   {
+      case Movement::Up:
+         modify.y = modify.y + 1u == height ? 0 : modify.y + 1;
+         break;
+
+      case Movement::Left:
+         modify.x = modify.x == 0 ? width - 1 : modify.x - 1;
+         break;
+
+      case Movement::Right:
+         modify.x = modify.x + 1u == width ? 0 : modify.x + 1;
+         break;
+
+      case Movement::Down:
+         modify.y = modify.y == 0 ? height - 1 : modify.y - 1;
+         break;
+
+      default: // Null stays where it is
+         break;
+   }
+}
+
+
+void SaveGame::unmap()
+{
+   #ifndef _WIN32
+
+   if (m_pMapping)
+   {
+      munmap (m_pMapping, m_size);
+      m_pMapping = nullptr;
+   }
+
+   #endif
+}
+
+
+
+/// Getters
+bool SaveGame::isInside (const unsigned int x, const unsigned int y) const
+{
+   return x < m_pHeader->gridWidth && y < m_pHeader->gridHeight;
+}
+
+
+/// The setup is rebuilt through its setters, a value they would change means the save can't be restored as it was
+SnakeStateSetup SaveGame::getSetup() const
+{
+   const Header& header = *m_pHeader;
+   const std::string ai (header.snakeAI);
+
+   SnakeStateSetup setup;
+   setup.setResolution (header.resX, header.resY);
+   setup.setGrid (header.gridWidth, header.gridHeight).setPlayers (header.humans, header.ai).setSnakeAI (ai);
+   setup.setFoodLimits (header.foodMin, header.foodMax).setScoring (header.scoreFood);
+   setup.setSnakeInterval (header.snakeInterval).setSeed (header.seed);
+
+   if (setup.getGridWidth() != header.gridWidth || setup.getGridHeight() != header.gridHeight ||
+       setup.getHumans() != header.humans || setup.getAI() != header.ai || setup.getSnakeAI() != ai ||
+       setup.getFoodMin() != header.foodMin || setup.getFoodMax() != header.foodMax ||
+       setup.getScoreFood() != header.scoreFood || setup.getSnakeUpdateInterval() != header.snakeInterval ||
+       setup.getFoodRotInterval() != header.rotInterval)
+   {
+      throw std::runtime_error ("Attempt to read a save whose setup can't be recreated.");
+   }
+
+   return setup;
+}
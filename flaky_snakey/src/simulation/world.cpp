@@ -0,0 +1,334 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include <simulation/world.hpp>
+
+
+/// STL
+#include <algorithm> // std::lower_bound
+
+
+/// Personal
+#include <misc/allocationcounter.hpp>
+#include <misc/profiler.hpp>
+#include <simulation/rolloutpool.hpp>
+
+
+/// Constructors and destructor
+World::World (const SnakeStateSetup& setup, const unsigned int seed, const std::shared_ptr<SnakeInterface>& ui)
+   :  m_kSeed (seed), m_scoreFood (setup.getScoreFood()), m_pRandom (std::make_shared<Random> (seed)),
+      m_pAIRandom (std::make_shared<Random> (seed, 1)), m_pGrid (nullptr),
+      m_pFoodManager (nullptr), m_pObstacleManager (nullptr), m_pSnakeManager (nullptr),
+      m_pFoodField (nullptr), m_pFatFoodField (nullptr), m_pDangerMap (nullptr), m_pRollouts (nullptr), m_flakes (0),
+      m_tick (0), m_allocationsRecorded (true), m_spawnAvailable (true)
+{
+   /// Create InGameSetup
+   InGameSetup inGame;
+   inGame.setResolution (setup.getResX(), setup.getResY());
+   inGame.setGrid (setup.getGridWidth(), setup.getGridHeight());
+
+   /// Prepare the OccupancyGrid shared by every manager
+   m_pGrid = std::make_shared<OccupancyGrid> (inGame);
+
+   /// Every Snake needs its own spawn point, ObstacleManager must keep them clear
+   std::vector<SnakeSpawn> spawns;
+   utility::generateSpawns (inGame, setup.getHumans() + setup.getAI(), spawns);
+
+   /// ThinFood rots after the same number of ticks that the rot interval spans in real time
+   const unsigned int rotTicks = setup.getFoodRotInterval() / setup.getSnakeUpdateInterval();
+
+   /// Prepare the managers
+   m_pFoodManager = std::make_shared<FoodManager> (inGame, m_pGrid, m_pRandom, rotTicks, setup.getFoodMin(),
+                                                   setup.getFoodMax());
+   m_pObstacleManager = std::make_shared<ObstacleManager> (inGame, m_pGrid, spawns);
+   m_pSnakeManager = std::make_shared<SnakeManager> (inGame, m_pGrid, setup.getHumans(), setup.getAI(),
+                                                     setup.getSnakeAI());
+
+   m_pSnakeManager->initialiseSnakes (spawns, setup.m_names, ui);
+   m_pSnakeManager->initialisePlayers (setup.m_keymaps);
+   /// The fields and the map are only searched when an AI Snake needs them
+   m_pFoodField = std::make_shared<DistanceField> (inGame, m_pGrid, m_pFoodManager, false);
+   m_pFatFoodField = std::make_shared<DistanceField> (inGame, m_pGrid, m_pFoodManager, true);
+   m_pDangerMap = std::make_shared<DangerMap> (inGame, m_pSnakeManager);
+
+   /// Only MCTS AI plays ahead, its threads are idle until it does
+   if (setup.getSnakeAI() == "mcts")
+   {
+      m_pRollouts = std::make_shared<RolloutPool> (setup, setup.getRolloutThreads());
+   }
+
+   m_pSnakeManager->initialiseAI (m_pSnakeManager, m_pFoodManager, m_pObstacleManager, m_pAIRandom, m_pFoodField,
+                                  m_pFatFoodField, m_pDangerMap, m_pRollouts);
+}
+
+
+
+/// Functionality
+void World::resume()
+{
+   m_pSnakeManager->resume();
+}
+
+
+void World::pause()
+{
+   m_pSnakeManager->pause();
+}
+
+
+/// Each tick moves the Snakes, ages and spawns Food, then resolves everything the move caused. The rollouts start from
+/// the World before any Snake has moved
+void World::step()
+{
+   if (m_pSnakeManager->isGameOver())
+   {
+      return;
+   }
+
+   const std::uint64_t allocations = AllocationCounter::getCount();
+
+   if (m_pRollouts)
+   {
+      m_pRollouts->setRoot (*this);
+   }
+
+   ++m_tick;
+
+   invalidateSearches();
+
+   m_pSnakeManager->moveSnakes();
+   resolveTick();
+   recordAllocations (allocations);
+}
+
+
+void World::step (const std::vector<Movement>& moves)
+{
+   if (m_pSnakeManager->isGameOver())
+   {
+      return;
+   }
+
+   const std::uint64_t allocations = AllocationCounter::getCount();
+   ++m_tick;
+
+   invalidateSearches();
+
+   m_pSnakeManager->moveSnakes (moves);
+   resolveTick();
+   recordAllocations (allocations);
+}
+
+
+/// Food ages and spawns after the Snakes have moved, then everything the move caused is resolved
+void World::resolveTick()
+{
+   m_pFoodManager->update();
+   spawnFood();
+
+   m_pSnakeManager->update();
+   updateCollisions();
+   processFlakes();
+}
+
+
+void World::save (Snapshot& modify) const
+{
+   m_pGrid->save (modify.m_grid);
+   m_pFoodManager->save (modify.m_food);
+   m_pObstacleManager->save (modify.m_obstacles);
+   m_pSnakeManager->save (modify.m_snakes);
+
+   modify.m_random = *m_pRandom;
+   modify.m_aiRandom = *m_pAIRandom;
+   modify.m_tick = m_tick;
+   modify.m_spawnAvailable = m_spawnAvailable;
+}
+
+
+/// Every manager shares the one grid and the Random engines so they're restored in place, the pointers held by the
+/// managers and controllers stay valid
+void World::restore (const Snapshot& snapshot)
+{
+   m_pGrid->restore (snapshot.m_grid);
+   m_pFoodManager->restore (snapshot.m_food);
+   m_pObstacleManager->restore (snapshot.m_obstacles);
+   m_pSnakeManager->restore (snapshot.m_snakes);
+
+   *m_pRandom = snapshot.m_random;
+   *m_pAIRandom = snapshot.m_aiRandom;
+   m_tick = snapshot.m_tick;
+   m_spawnAvailable = snapshot.m_spawnAvailable;
+
+   invalidateSearches();
+}
+
+
+/// Humans come before the AI Snakes so the living AI Snakes are those after the last living human
+void World::invalidateSearches()
+{
+   const auto& living = m_pSnakeManager->getLivingSnakes();
+   const auto firstAI = std::lower_bound (living.begin(), living.end(), m_pSnakeManager->getHumans());
+   const unsigned int askers = living.end() - firstAI;
+
+   m_pFoodField->invalidate (askers);
+   m_pFatFoodField->invalidate (askers);
+   m_pDangerMap->invalidate();
+}
+
+
+void World::spawnFood()
+{
+   const Profiler::Scope scope {Profiler::Phase::SpawnSearch};
+
+   if (m_pFoodManager->isSpawnRequired() && m_spawnAvailable)
+   {
+      Cell spawn;
+      if (!findSpawnPoint (spawn))
+      {
+         m_spawnAvailable = false;
+      }
+
+      else
+      {
+         m_pFoodManager->addFood (spawn);
+      }
+   }
+}
+
+
+/// Check cross-Manager collisions, only Snakes alive after SnakeManager::update() can have moved into anything
+void World::updateCollisions()
+{
+   const Profiler::Scope scope {Profiler::Phase::Collisions};
+
+   for (const auto i : m_pSnakeManager->getLivingSnakes())
+   {
+      if (m_pSnakeManager->isSnakeAlive (i))
+      {
+         /// Check Obstacle collision
+         const auto head = m_pSnakeManager->getSnakeHead (i);
+
+         if (m_pObstacleManager->isObstacleHere (head))
+         {
+            m_pSnakeManager->killSnake (i);
+         }
+
+         /// Only search for the Food object when the grid says there is one to eat
+         else if (m_pGrid->isFoodHere (head))
+         {
+            const unsigned int food = m_pFoodManager->getFoodHandle (head);
+
+            /// Get food effect
+            m_pSnakeManager->alterSnakeSize (i, m_pFoodManager->getFoodEffect (food));
+            m_pSnakeManager->incrementScore (i, m_scoreFood);
+            m_pFoodManager->removeFood (food);
+         }
+      } // Do nothing if Snake is dead
+   }
+}
+
+
+/// Extract flakes and convert into Obstacle objects, m_flakes keeps its capacity between ticks
+void World::processFlakes()
+{
+   const Profiler::Scope scope {Profiler::Phase::Flakes};
+
+   m_flakes.clear();
+   m_pSnakeManager->extractFlakes (m_flakes);
+
+   if (!m_flakes.empty())
+   {
+      m_pObstacleManager->addObstacles (m_flakes);
+   }
+}
+
+
+/// Picks a uniformly random free cell for FoodManager, returns false if the board is full
+bool World::findSpawnPoint (Cell& modify) const
+{
+   const unsigned int freeCells = m_pGrid->getFreeCells();
+
+   if (freeCells == 0)
+   {
+      return false;
+   }
+
+   modify = m_pGrid->getFreeCell (m_pRandom->next (freeCells));
+
+   return true;
+}
+
+
+void World::recordAllocations (const std::uint64_t allocations) const
+{
+   if (m_allocationsRecorded && m_tick > kWarmUpTicks && AllocationCounter::isAvailable())
+   {
+      Profiler::recordAllocations (AllocationCounter::getCount() - allocations);
+   }
+}
+
+
+
+/// Assignment functions
+void World::reseed (const unsigned int seed)
+{
+   m_pRandom->seed (seed);
+}
+
+
+
+/// Getters
+/// The hash is 32-bit FNV-1a. The random engine of the AI is left out because it only decides moves, which a replay
+/// records, so playback never draws from it
+std::uint32_t World::getStateHash() const
+{
+   std::uint32_t hash {2166136261u};
+
+   const auto add = [&hash] (const std::uint32_t value)
+   {
+      for (unsigned int shift {0}; shift < 32; shift += 8)
+      {
+         hash = (hash ^ ((value >> shift) & 0xFF)) * 16777619u;
+      }
+   };
+
+   add (m_tick);
+   add (m_spawnAvailable ? 1 : 0);
+
+   for (const auto state : m_pRandom->m_state)
+   {
+      add (state);
+   }
+
+   for (unsigned int i {0}; i < m_pSnakeManager->getSnakeAmount(); ++i)
+   {
+      add (m_pSnakeManager->isSnakeAlive (i) ? 1 : 0);
+      add (m_pSnakeManager->getSnakeScore (i));
+   }
+
+   /// The grid says where every Snake part, Food and Obstacle is
+   const std::uint64_t grid = m_pGrid->getHash();
+   add (grid);
+   add (grid >> 32);
+
+   return hash;
+}
@@ -0,0 +1,95 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include <snakes/dangermap.hpp>
+#include <misc/profiler.hpp>
+#include <snakes/snakemanager.hpp>
+
+
+/// Constructors and destructor
+DangerMap::DangerMap (const InGameSetup& setup, const std::shared_ptr<const SnakeManager>& snakeManager)
+   :  m_pkSnakeManager (snakeManager), m_search (setup), m_valid (false)
+{
+   // Pre-condition: The map needs the Snakes it records
+   if (!snakeManager)
+   {
+      throw std::runtime_error ("Attempt to create DangerMap without a SnakeManager.");
+   }
+
+   /// The map is recorded wherever the Snakes go but never searched outwards, so it needs no frontier
+   m_search.reserve (0);
+}
+
+
+
+/// Functionality
+/// Each Snake is walked from its tail towards its head until the parts need more than kHorizon moves to clear. A part
+/// leaves on its Snake's move rather than before it, so a Snake which has already moved this tick holds every part for
+/// one more move. A tail which leaves this tick isn't recorded, another head may already have taken its place by the
+/// time the map is read. Growth stacks parts in one cell, the cell clears with the last of them
+void DangerMap::refresh (const unsigned int deciding)
+{
+   const auto& snakeManager = m_pkSnakeManager.lock();
+
+   if (m_valid || !snakeManager)
+   {
+      return;
+   }
+
+   const Profiler::Scope scope {Profiler::Phase::DangerMap};
+
+   m_valid = true;
+   m_search.beginSearch();
+
+   for (const auto i : snakeManager->getLivingSnakes())
+   {
+      const auto& body = snakeManager->getSnakeBody (i);
+      const unsigned int moved = i < deciding ? 1 : 0;
+
+      for (unsigned int fromTail {0}; fromTail < body.getSize(); ++fromTail)
+      {
+         const unsigned int firstSafeMove = fromTail + 1 + moved;
+         const unsigned int index = m_search.getIndex (body[body.getSize() - 1 - fromTail]);
+
+         /// Parts stacked with the first one beyond the horizon can't be trusted to clear either
+         if (firstSafeMove > kHorizon)
+         {
+            if (m_search.isVisited (index))
+            {
+               m_search.visit (index, Movement::Null, kNever);
+            }
+
+            break;
+         }
+
+         if (m_search.isVisited (index))
+         {
+            const unsigned int recorded = m_search.getDistance (index);
+            m_search.visit (index, Movement::Null, recorded > firstSafeMove ? recorded : firstSafeMove);
+         }
+
+         else if (firstSafeMove != 1)
+         {
+            m_search.visit (index, Movement::Null, firstSafeMove);
+         }
+      }
+   }
+}
@@ -23,177 +23,45 @@
 
 
 /// Constructors and destructor
-Snake::Snake (const InGameSetup& setup, const unsigned int playerNumber, const std::string& name)
-   :  m_partsP (0), m_flakesP (0), m_lastEnd (nullptr), m_pController (),
-      m_kSetup (setup), m_kPlayerNumber (playerNumber), m_name (name), m_colour (0, 0, 0),
-      m_alive (true), m_passThrough (false) , m_score (0), m_lastMove (Movement::Null)
+Snake::Snake (const InGameSetup& setup, const std::shared_ptr<OccupancyGrid>& grid, const unsigned int playerNumber,
+              const SnakeSpawn& spawn, const std::string& name)
+   :  m_body(), m_flakes (0), m_lastEnd(), m_canRollBack (false), m_pController (), m_pGrid (grid),
+      m_kSetup (setup), m_kPlayerNumber (playerNumber), m_name (name), m_colour (spawn.colour),
+      m_alive (true), m_passThrough (false) , m_score (0), m_lastMove (spawn.direction)
 {
-   /// Generate starting values for Snake, handle playerNumber 0-3
-   switch (m_kPlayerNumber)
+   // Pre-condition: Snake must be able to record itself
+   if (!m_pGrid)
    {
-      case 0: // Red
-         if (m_name == "")
-         {
-            m_name = "Player 1";
-         }
-
-         m_colour.setR (255).setG (0).setB (0);
-         m_lastMove = Movement::Right;
-         generateSpawn();
-         break;
-
-      case 1: // Green
-         if (m_name == "")
-         {
-            m_name = "Player 2";
-         }
-
-         m_colour.setR (0).setG (255).setB (0);
-         m_lastMove = Movement::Down;
-         generateSpawn();
-         break;
-
-      case 2: // Blue
-         if (m_name == "")
-         {
-            m_name = "Player 3";
-         }
-
-         m_colour.setR (0).setG (0).setB (255);
-         m_lastMove = Movement::Up;
-         generateSpawn();
-         break;
-
-      case 3: // Yellow
-         if (m_name == "")
-         {
-            m_name = "Player 4";
-         }
-
-         m_colour.setR (255).setG (255).setB (0);
-         m_lastMove = Movement::Left;
-         generateSpawn();
-         break;
-
-      default:
-         throw std::runtime_error ("Attempt to assign an invalid player number to Snake().");
-         break;
+      throw std::runtime_error ("Attempt to create a Snake without an OccupancyGrid.");
    }
-}
-
 
-
-/// Core requirements
-/// Generate spawn point based on m_playerNumber
-void Snake::generateSpawn()
-{
-   switch (m_kPlayerNumber)
+   // Pre-condition: Snake must be facing a direction
+   if (m_lastMove == Movement::Null)
    {
-      case 0:
-      {
-         m_partsP.push_front
-         (std::unique_ptr<Rectangle>
-            (
-               new Rectangle // Player 1 = (2, end-2)
-               (
-                  m_kSetup.getRectWidth(), m_kSetup.getRectHeight(),
-                  m_kSetup.getStartX() + 2 * m_kSetup.getRectWidth(),
-                  m_kSetup.getEndY() - 3 * m_kSetup.getRectHeight()
-               )
-            )
-         );
-
-         break;
-      }
-
-      case 1:
-      {
-         m_partsP.push_front
-         (std::unique_ptr<Rectangle>
-            (
-               new Rectangle // Player 2 = (end-2, end-2)
-               (
-                  m_kSetup.getRectWidth(), m_kSetup.getRectHeight(),
-                  m_kSetup.getEndX() - 3 * m_kSetup.getRectWidth(),
-                  m_kSetup.getEndY() - 3 * m_kSetup.getRectHeight()
-               )
-            )
-         );
-
-         break;
-      }
-
-      case 2:
-      {
-         m_partsP.push_front
-         (std::unique_ptr<Rectangle>
-            (new Rectangle // Player 3 = (2, 2)
-               (
-                  m_kSetup.getRectWidth(), m_kSetup.getRectHeight(),
-                  m_kSetup.getStartX() + 2 * m_kSetup.getRectWidth(),
-                  m_kSetup.getStartY() + 2 * m_kSetup.getRectHeight()
-               )
-            )
-         );
-
-         break;
-      }
-
-      case 3:
-      {
-         m_partsP.push_front
-         (std::unique_ptr<Rectangle>
-            (new Rectangle   // Player 4 = (end-2, 2)
-               (
-                  m_kSetup.getRectWidth(), m_kSetup.getRectHeight(),
-                  m_kSetup.getEndX() - 3 * m_kSetup.getRectWidth(),
-                  m_kSetup.getStartY() + 2 * m_kSetup.getRectHeight()
-               )
-            )
-         );
-
-         break;
-      }
-
-      default:
-         throw std::runtime_error ("Default triggered in Snake::generateSpawn(), this should never happen.");
+      throw std::runtime_error ("Attempt to spawn a Snake without a direction.");
    }
-}
-
-
 
-/// Testing functions
-bool Snake::intersects (const Rectangle& rect) const
-{
-   for (const auto& part : m_partsP)
+   /// Generate starting values for Snake
+   if (m_name == "")
    {
-      if (rect.intersects (*part))
-      {
-         return true;
-      }
+      m_name = "Player " + utility::intToString (m_kPlayerNumber + 1);
    }
 
-   return false;
+   m_body.pushHead (spawn.cell);
+   m_pGrid->addSnakePart (spawn.cell);
 }
 
 
+
+/// Testing functions
 /// Only tests the body of the Snake, useful for SnakeManager
-bool Snake::intersectsBody (const Rectangle& rect) const
+bool Snake::intersectsBody (const Cell& cell) const
 {
-   bool first = true;
-
-   for (const auto& part : m_partsP)
+   for (unsigned int i {1}; i < m_body.getSize(); ++i)
    {
-      if (!first)
-      {
-         if (rect.intersects (*part))
-         {
-            return true;
-         }
-      }
-      else
+      if (m_body[i] == cell)
       {
-         first = false;
+         return true;
       }
    }
 
@@ -267,18 +135,22 @@ bool Snake::isValidMove (Movement move) const
 void Snake::draw (prg::Canvas& canvas)
 {
    /// Calls each relevant draw() function
-   bool first = true;
+   if (!m_body.isEmpty())
+   {
+      drawHead (canvas, utility::toRectangle (m_kSetup, m_body.getHead()));
+   }
 
-   for (const auto& part : m_partsP)
+   /// Neighbouring parts share a Rectangle on an overview of a huge grid, only draw each one once
+   Rectangle previous { 0, 0 };
+
+   for (unsigned int i {1}; i < m_body.getSize(); ++i)
    {
-      if (!first)
-      {
-         drawBody (canvas, *part); // Dereference the unique pointer
-      }
-      else
+      const Rectangle body = utility::toRectangle (m_kSetup, m_body[i]);
+
+      if (i == 1 || body != previous)
       {
-         drawHead (canvas, *part);
-         first = false;
+         drawBody (canvas, body);
+         previous = body;
       }
    }
 }
@@ -426,45 +298,44 @@ void Snake::moveSnake()
    if (m_alive)
    {
       /// Check if a controller can be used to get the next move
-      Movement currentMove;
       auto controller = m_pController.lock();
 
-      if (controller)
-      {
-         currentMove = controller->getMove();
+      moveSnake (controller ? controller->getMove() : m_lastMove);
+   }
+}
 
-         if (!isValidMove (currentMove))
-         {
-            currentMove = m_lastMove;
-         }
-      }
 
-      else
+/// Moves without asking the Controller, an invalid move continues in the same direction as the last one
+void Snake::moveSnake (Movement currentMove)
+{
+   // Pre-condition: Snake is alive
+   if (m_alive)
+   {
+      if (!isValidMove (currentMove))
       {
          currentMove = m_lastMove;
       }
 
       /// Create new front, ready for moving to its new position
-      std::unique_ptr<Rectangle> toPush (new Rectangle (m_kSetup.getRectWidth(), m_kSetup.getRectHeight(),
-                                         m_partsP.front()->getX(), m_partsP.front()->getY()));
+      Cell toPush = m_body.getHead();
 
       /// Ensure boundary checking so the Snake will appear at the other side
       switch (currentMove)
       {
          case Movement::Up:
-            utility::moveCell (m_kSetup, *toPush, 0, 1);
+            utility::moveCell (m_kSetup, toPush, 0, 1);
             break;
 
          case Movement::Left:
-            utility::moveCell (m_kSetup, *toPush, -1, 0);
+            utility::moveCell (m_kSetup, toPush, -1, 0);
             break;
 
          case Movement::Right:
-            utility::moveCell (m_kSetup, *toPush, 1, 0);
+            utility::moveCell (m_kSetup, toPush, 1, 0);
             break;
 
          case Movement::Down:
-            utility::moveCell (m_kSetup, *toPush, 0, -1);
+            utility::moveCell (m_kSetup, toPush, 0, -1);
             break;
 
          default: // Should never happen
@@ -472,9 +343,11 @@ void Snake::moveSnake()
       }
 
       /// Simulate movement and maintain last position to facilitate rolling back
-      m_partsP.push_front (std::move (toPush));
-      m_lastEnd = std::move (m_partsP.back());
-      m_partsP.pop_back();
+      m_pGrid->addSnakePart (toPush);
+      m_body.pushHead (toPush);
+      m_lastEnd = m_body.popTail();
+      m_canRollBack = true;
+      m_pGrid->removeSnakePart (m_lastEnd);
 
       m_lastMove = currentMove;
       m_passThrough = false;
@@ -485,25 +358,13 @@ void Snake::moveSnake()
 /// Check if the head collides with the body
 void Snake::checkSelfCollision()
 {
-   // Make sure the head doesn't collide with itself
-   bool first = true;
-   const Rectangle& head = *m_partsP.front();
+   // Make sure the head doesn't collide with itself, the grid rules it out unless another part shares the cell
+   const auto& head = m_body.getHead();
 
-   for (const auto& body : m_partsP)
+   if (m_pGrid->getSnakeParts (head) > 1 && intersectsBody (head))
    {
-      if (!first)
-      {
-         if (head.intersects (*body))
-         {
-            /// Need to roll back movement so call killSnake()
-            killSnake();
-            break;
-         }
-      }
-      else
-      {
-         first = false;
-      }
+      /// Need to roll back movement so call killSnake()
+      killSnake();
    }
 }
 
@@ -531,7 +392,7 @@ void Snake::alterSnakeSize (const int foodEffect)
 void Snake::growSnake (const int foodEffect)
 {
    /// Avoid collision bugs by spawning it one cell behind the head
-   auto head = *m_partsP.front();
+   auto head = m_body.getHead();
 
    switch (m_lastMove)
    {
@@ -559,47 +420,45 @@ void Snake::growSnake (const int foodEffect)
    {
       // Insert as the second element to avoid rolling back and flaking bugs, this also creates the illusion
       // of the eaten food getting digested and so the tail grows once it reaches where the food was
-      if (m_partsP.size() > 2)
+      if (m_body.getSize() > 2)
       {
-         auto it = m_partsP.begin();
-         it++;
-         m_partsP.insert (it, std::unique_ptr<Rectangle> (new Rectangle (head)));
+         const Cell front = m_body.popHead();
+         m_body.pushHead (head);
+         m_body.pushHead (front);
       }
       else
       {
-         m_partsP.push_back (std::unique_ptr<Rectangle> (new Rectangle (head)));
+         m_body.pushTail (head);
       }
+
+      m_pGrid->addSnakePart (head);
    }
 }
 
 
-/// Flakes the snake by foodEffect, returns m_partsP.size() >= foodEffect
+/// Flakes the snake by foodEffect, returns m_body.getSize() > foodEffect
 bool Snake::flakeSnake (const int foodEffect)
 {
-   if ( (unsigned int) foodEffect >= m_partsP.size())
+   if ( (unsigned int) foodEffect >= m_body.getSize())
    {
       return false;
    }
 
    for (int i {0}; i < foodEffect; ++i)
    {
-      m_flakesP.push_back (std::move (m_partsP.back()));
-      m_partsP.pop_back();
+      m_flakes.push_back (m_body.popTail());
+      m_pGrid->removeSnakePart (m_flakes.back());
    }
 
    return true;
 }
 
 
-/// std::move() each Rectangle from m_flakesP to modify
-void Snake::extractFlakes (std::vector<std::unique_ptr<Rectangle>>& modify)
+/// Appends each cell from m_flakes to modify
+void Snake::extractFlakes (std::vector<Cell>& modify)
 {
-   for (auto& flake : m_flakesP)
-   {
-      modify.push_back (std::move (flake));
-   }
-
-   m_flakesP.clear();
+   modify.insert (modify.end(), m_flakes.begin(), m_flakes.end());
+   m_flakes.clear();
 }
 
 
@@ -649,24 +508,74 @@ void Snake::decrementScore (const unsigned int toSubtract)
 void Snake::killSnake()
 {
    // Pre-condition: Can roll back
-   if (m_lastEnd)
+   if (m_canRollBack)
    {
-      m_partsP.pop_front();
-      m_partsP.push_back (std::move (m_lastEnd));
+      m_pGrid->removeSnakePart (m_body.popHead());
+
+      m_pGrid->addSnakePart (m_lastEnd);
+      m_body.pushTail (m_lastEnd);
+      m_canRollBack = false;
    }
 
    m_alive = false;
 }
 
 
+/// The roll back state is saved too so a restored Snake resolves the collisions of its last move exactly as it would
+/// have the first time
+void Snake::save (Snapshot& modify) const
+{
+   modify.m_body = m_body;
+   modify.m_flakes = m_flakes;
+   modify.m_lastEnd = m_lastEnd;
+   modify.m_canRollBack = m_canRollBack;
+   modify.m_alive = m_alive;
+   modify.m_passThrough = m_passThrough;
+   modify.m_score = m_score;
+   modify.m_lastMove = m_lastMove;
+}
+
+
+void Snake::restore (const Snapshot& snapshot)
+{
+   // Pre-condition: A Snake always has a head
+   if (snapshot.m_body.isEmpty())
+   {
+      throw std::runtime_error ("Attempt to restore a Snake from an empty Snapshot.");
+   }
+
+   m_body = snapshot.m_body;
+   m_flakes = snapshot.m_flakes;
+   m_lastEnd = snapshot.m_lastEnd;
+   m_canRollBack = snapshot.m_canRollBack;
+   m_alive = snapshot.m_alive;
+   m_passThrough = snapshot.m_passThrough;
+   m_score = snapshot.m_score;
+   m_lastMove = snapshot.m_lastMove;
+}
+
+
 
 /// Getters
-const Rectangle& Snake::getHead() const
+const Cell& Snake::getHead() const
 {
-   if (m_partsP.empty()) // This should never be able to happen but has helped to debug
+   if (m_body.isEmpty()) // This should never be able to happen but has helped to debug
    {
       throw std::runtime_error ("Catastrophic failure in Snake::getHead()");
    }
 
-   return *m_partsP.front();
+   return m_body.getHead();
+}
+
+
+/// Where the head ends up if killSnake() rolls back movement
+const Cell& Snake::getRollBackHead() const
+{
+   // Pre-condition: Rolling back is possible
+   if (!m_canRollBack)
+   {
+      throw std::runtime_error ("Attempt to find the roll back position of a Snake that can't roll back.");
+   }
+
+   return m_body.getSize() > 1 ? m_body[1] : m_lastEnd;
 }
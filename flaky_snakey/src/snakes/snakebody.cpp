@@ -0,0 +1,108 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <snakes/snakebody.hpp>
+
+
+/// STL
+#include <stdexcept> // Popping from an empty body
+
+
+/// Constructors and destructor
+// Enough room for most games before ever needing to grow
+SnakeBody::SnakeBody()
+   :  m_cells (16), m_head (0), m_size (0), m_mask (15)
+{
+}
+
+
+
+/// Assignment functions
+void SnakeBody::pushHead (const Cell& cell)
+{
+   if (m_size == m_cells.size())
+   {
+      grow();
+   }
+
+   m_head = (m_head - 1) & m_mask;
+   m_cells[m_head] = cell;
+   ++m_size;
+}
+
+
+void SnakeBody::pushTail (const Cell& cell)
+{
+   if (m_size == m_cells.size())
+   {
+      grow();
+   }
+
+   m_cells[(m_head + m_size) & m_mask] = cell;
+   ++m_size;
+}
+
+
+Cell SnakeBody::popHead()
+{
+   // Pre-condition: There is something to remove
+   if (m_size == 0)
+   {
+      throw std::runtime_error ("Attempt to pop the head of an empty SnakeBody.");
+   }
+
+   const Cell removed = m_cells[m_head];
+   m_head = (m_head + 1) & m_mask;
+   --m_size;
+
+   return removed;
+}
+
+
+Cell SnakeBody::popTail()
+{
+   // Pre-condition: There is something to remove
+   if (m_size == 0)
+   {
+      throw std::runtime_error ("Attempt to pop the tail of an empty SnakeBody.");
+   }
+
+   --m_size;
+
+   return m_cells[(m_head + m_size) & m_mask];
+}
+
+
+
+/// Functionality
+/// Doubles the capacity whilst keeping the head at index 0
+void SnakeBody::grow()
+{
+   std::vector<Cell> grown (m_cells.size() * 2);
+
+   for (unsigned int i {0}; i < m_size; ++i)
+   {
+      grown[i] = (*this)[i];
+   }
+
+   m_cells.swap (grown);
+   m_head = 0;
+   m_mask = m_cells.size() - 1;
+}
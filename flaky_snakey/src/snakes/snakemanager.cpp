@@ -19,20 +19,28 @@
 
 
 #include <snakes/snakemanager.hpp>
+#include <misc/profiler.hpp>
 
 
 /// Constructors and destructor
-SnakeManager::SnakeManager (const InGameSetup& setup, const unsigned int timer_id, const unsigned int moveInterval,
+SnakeManager::SnakeManager (const InGameSetup& setup, const std::shared_ptr<OccupancyGrid>& grid,
                             const unsigned int humans, const unsigned int ai, const std::string& difficulty)
-   :  m_kSetup (setup), m_kHumans (humans), m_kAI (ai), m_kDifficulty (difficulty),
-      m_snakesP (0), m_playersP (0), m_aiP (0), m_livingSnakes (0),
-      m_pUI (nullptr), m_timer (timer_id, moveInterval, *this)
+   :  m_kSetup (setup), m_kHumans (humans), m_kAI (ai), m_kDifficulty (difficulty), m_pGrid (grid),
+      m_snakesP (0), m_playersP (0), m_aiP (0), m_living (0), m_headIndex (0), m_deadIndex (0),
+      m_candidates (0), m_livingSnakes (0),
+      m_pUI (nullptr)
 {
    // Pre-condition: Must not be 0 snakes in total
    if (m_kHumans + m_kAI == 0)
    {
       throw std::runtime_error ("Attempt to create SnakeManager that manages no snakes.");
    }
+
+   // Pre-condition: Snakes must be able to record themselves
+   if (!m_pGrid)
+   {
+      throw std::runtime_error ("Attempt to create SnakeManager without an OccupancyGrid.");
+   }
 }
 
 
@@ -45,27 +53,38 @@ SnakeManager::~SnakeManager()
 
 
 /// Core requirements
-/// Create and assign names to Snake objects
-void SnakeManager::initialiseSnakes (const std::vector<std::string>& names, const std::shared_ptr<SnakeInterface>& ui)
+/// Create and assign names to Snake objects, each Snake starts at the matching spawn. The UI is optional
+void SnakeManager::initialiseSnakes (const std::vector<SnakeSpawn>& spawns, const std::vector<std::string>& names,
+                                     const std::shared_ptr<SnakeInterface>& ui)
 {
-   if (!ui)
+   // Pre-condition: Every Snake has somewhere to spawn
+   if (spawns.size() < m_kHumans + m_kAI)
    {
-      throw std::runtime_error ("Attempt to incorrect set up UI at SnakeManager::initialisesnakes()");
+      throw std::runtime_error ("Attempt to initialise SnakeManager with too few spawn points.");
    }
 
    m_pUI = ui;
+   m_snakesP.reserve (m_kHumans + m_kAI);
+   m_living.reserve (m_kHumans + m_kAI);
+   m_headIndex.reserve (2 * (m_kHumans + m_kAI));
+   m_deadIndex.reserve (2 * (m_kHumans + m_kAI));
 
    for (unsigned int i {0}; i < m_kHumans + m_kAI; ++i)
    {
 
-      auto snake = std::make_shared<Snake> (m_kSetup, i);
+      auto snake = std::make_shared<Snake> (m_kSetup, m_pGrid, i, spawns[i]);
       if (i < names.size())
       {
          snake->setName (names[i]);
       }
 
-      ui->addPlayer (i, snake->getName());
+      if (ui)
+      {
+         ui->addPlayer (i, snake->getName(), spawns[i].colour);
+      }
+
       m_snakesP.push_back (std::move (snake));
+      m_living.push_back (i);
    }
 
    m_livingSnakes = m_snakesP.size();
@@ -98,8 +117,24 @@ void SnakeManager::initialisePlayers (const std::vector<Keymap>& keymaps)
 /// Create and assign correct pointers to AIController classes
 void SnakeManager::initialiseAI (const std::shared_ptr<SnakeManager>& snakeManager,
                                  const std::shared_ptr<FoodManager>& foodManager,
-                                 const std::shared_ptr<ObstacleManager>& obstacleManager)
+                                 const std::shared_ptr<ObstacleManager>& obstacleManager,
+                                 const std::shared_ptr<Random>& random,
+                                 const std::shared_ptr<DistanceField>& foodField,
+                                 const std::shared_ptr<DistanceField>& fatFoodField,
+                                 const std::shared_ptr<DangerMap>& dangerMap,
+                                 const std::shared_ptr<RolloutPool>& rollouts)
 {
+   // Pre-condition: AI needs random numbers to make decisions
+   if (!random)
+   {
+      throw std::runtime_error ("Attempt to initialise AI without a Random engine.");
+   }
+
+   // Every AIController searches in the same buffers, only one decides at a time. No search queues more cells than
+   // the level has
+   const auto search = std::make_shared<SearchBuffers> (m_kSetup);
+   search->reserve (m_kSetup.getGridWidth() * m_kSetup.getGridHeight());
+
    // AIController objects are always placed after PlayerController objects
    for (unsigned int i {m_kHumans}; i < m_kHumans + m_kAI; ++i)
    {
@@ -113,6 +148,14 @@ void SnakeManager::initialiseAI (const std::shared_ptr<SnakeManager>& snakeManag
       {
          ai = std::make_shared<SmartAIController> (m_kSetup);
       }
+      else if (m_kDifficulty == "pathfinding")
+      {
+         ai = std::make_shared<PathfindingAIController> (m_kSetup);
+      }
+      else if (m_kDifficulty == "mcts")
+      {
+         ai = std::make_shared<MCTSAIController> (m_kSetup, rollouts);
+      }
       else
       {
          ai = std::make_shared<AIController> (m_kSetup);
@@ -121,6 +164,11 @@ void SnakeManager::initialiseAI (const std::shared_ptr<SnakeManager>& snakeManag
       ai->setSnakeManager (snakeManager);
       ai->setFoodManager (foodManager);
       ai->setObstacleManager (obstacleManager);
+      ai->setRandom (random);
+      ai->setGrid (m_pGrid);
+      ai->setSearchBuffers (search);
+      ai->setDistanceFields (foodField, fatFoodField);
+      ai->setDangerMap (dangerMap);
       ai->setSnake (m_snakesP[i]);
       m_snakesP[i]->setController (ai);
 
@@ -143,16 +191,33 @@ bool SnakeManager::isSnakeAlive (const unsigned int index) const
 }
 
 
-bool SnakeManager::isSnakeHere (const Rectangle& rect) const
+bool SnakeManager::isSnakeHere (const Cell& cell) const
 {
-   for (const auto& snake : m_snakesP)
+   return m_pGrid->isSnakeHere (cell);
+}
+
+
+/// How many heads are in cell, requires indexHeads(). Heads that moved since indexing are only counted if they're
+/// still in the cell, so the result can be too low but never too high
+unsigned int SnakeManager::countHeads (const Cell& cell) const
+{
+   unsigned int heads {0};
+
+   for (const auto index : { &m_headIndex, &m_deadIndex })
    {
-      if (snake->intersects (rect))
+      const auto range = std::equal_range (index->begin(), index->end(),
+                                           std::make_pair (getCellKey (cell), 0u), compareKeys);
+
+      for (auto it = range.first; it != range.second; ++it)
       {
-         return true;
+         if (m_snakesP[it->second]->getHead() == cell)
+         {
+            ++heads;
+         }
       }
    }
-   return false;
+
+   return heads;
 }
 
 
@@ -177,9 +242,9 @@ bool SnakeManager::snakesCrossed (const unsigned int snake, const unsigned int o
             {
                /// Test if the previous position of snake intersects with other
                auto head = m_snakesP[snake]->getHead();
-               head.decrementPosition (0, m_kSetup.getRectHeight());
+               utility::moveCell (m_kSetup, head, 0, -1);
 
-               if (head.intersects (m_snakesP[other]->getHead()))
+               if (head == m_snakesP[other]->getHead())
                {
                   return true;
                }
@@ -190,9 +255,9 @@ bool SnakeManager::snakesCrossed (const unsigned int snake, const unsigned int o
             if (m_snakesP[other]->getLastMove() == Movement::Right)
             {
                auto head = m_snakesP[snake]->getHead();
-               head.incrementPosition (m_kSetup.getRectWidth(), 0);
+               utility::moveCell (m_kSetup, head, 1, 0);
 
-               if (head.intersects (m_snakesP[other]->getHead()))
+               if (head == m_snakesP[other]->getHead())
                {
                   return true;
                }
@@ -203,9 +268,9 @@ bool SnakeManager::snakesCrossed (const unsigned int snake, const unsigned int o
             if (m_snakesP[other]->getLastMove() == Movement::Left)
             {
                auto head = m_snakesP[snake]->getHead();
-               head.decrementPosition (m_kSetup.getRectWidth(), 0);
+               utility::moveCell (m_kSetup, head, -1, 0);
 
-               if (head.intersects (m_snakesP[other]->getHead()))
+               if (head == m_snakesP[other]->getHead())
                {
                   return true;
                }
@@ -216,9 +281,9 @@ bool SnakeManager::snakesCrossed (const unsigned int snake, const unsigned int o
             if (m_snakesP[other]->getLastMove() == Movement::Up)
             {
                auto head = m_snakesP[snake]->getHead();
-               head.incrementPosition (0, m_kSetup.getRectHeight());
+               utility::moveCell (m_kSetup, head, 0, 1);
 
-               if (head.intersects (m_snakesP[other]->getHead()))
+               if (head == m_snakesP[other]->getHead())
                {
                   return true;
                }
@@ -238,7 +303,6 @@ bool SnakeManager::snakesCrossed (const unsigned int snake, const unsigned int o
 /// Must be called when game is ready to start
 void SnakeManager::resume()
 {
-   m_timer.start();
    for (const auto& player : m_playersP)
    {
       player->addListener();
@@ -249,7 +313,6 @@ void SnakeManager::resume()
 /// Must be called on change of state
 void SnakeManager::pause()
 {
-   m_timer.stop();
    for (const auto& player : m_playersP)
    {
       player->removeListener();
@@ -257,25 +320,35 @@ void SnakeManager::pause()
 }
 
 
+/// Only the living Snakes moved so only their heads are checked, dead Snakes take part purely through m_deadIndex
 void SnakeManager::update()
 {
-   // All that needs to be done is to determine how many snakes are still alive
-   m_livingSnakes = 0;
+   const Profiler::Scope scope {Profiler::Phase::SnakeUpdate};
 
    // Split the functions up for the sake of clarity
    updateSelfCollisions();
+
+   // The head pass needs every Snake that has died so far to be in m_deadIndex
+   removeDeadSnakes();
    updateHeadCollisions();
    updateBodyCollisions();
 
-   for (unsigned int i {0}; i < m_snakesP.size(); ++i)
-   {
-      const auto& snake = m_snakesP[i];
+   removeDeadSnakes();
+   m_livingSnakes = m_living.size();
 
-      m_pUI->updateScore (i, snake->getScore());
-      m_pUI->setAlive (i, snake->isAlive());
-      if (snake->isAlive())
+   updateInterface();
+}
+
+
+/// Also needed after restore() as a Snapshot holds no record of what the UI was showing
+void SnakeManager::updateInterface()
+{
+   if (m_pUI)
+   {
+      for (unsigned int i {0}; i < m_snakesP.size(); ++i)
       {
-         ++m_livingSnakes;
+         m_pUI->updateScore (i, m_snakesP[i]->getScore());
+         m_pUI->setAlive (i, m_snakesP[i]->isAlive());
       }
    }
 }
@@ -284,59 +357,93 @@ void SnakeManager::update()
 /// Check if any living snakes collide with themselves and kill them
 void SnakeManager::updateSelfCollisions()
 {
-   for (const auto& snake : m_snakesP)
+   for (const auto i : m_living)
    {
-      if (snake->isAlive())
+      if (m_snakesP[i]->isAlive())
       {
-         snake->checkSelfCollision();
+         m_snakesP[i]->checkSelfCollision();
       }
    }
 }
 
 
-/// Check cross-snake collisions and kill them
+/// Check cross-snake collisions and kill them. Comparing every pair of snakes doesn't scale so the heads are sorted by
+/// cell and only snakes whose heads could meet are compared. The pairs are then processed in the same order as a
+/// pairwise comparison would, which keeps the outcome of a multi-snake pile-up exactly the same. Two dead snakes can't
+/// affect each other so every pair is found by looking up where the living heads are.
 void SnakeManager::updateHeadCollisions()
 {
-   /// Avoid range-based loop for maximum efficiency
-   for (unsigned int i {0}; i < m_snakesP.size(); ++i)
+   /// A head can be in two places during this pass: where it is and where killSnake() would roll it back to
+   indexHeads (true);
+   m_candidates.clear();
+
+   for (const auto i : m_living)
+   {
+      const auto& snake = m_snakesP[i];
+      const Cell positions[2] { snake->getHead(), snake->canRollBack() ? snake->getRollBackHead() : snake->getHead() };
+
+      for (const auto& position : positions)
+      {
+         addCandidates (i, position);
+
+         // Two lone heads can swap cells without ever sharing one, see snakesCrossed()
+         if (snake->getSize() == 1)
+         {
+            addCandidates (i, getPreviousCell (position, snake->getLastMove()));
+         }
+      }
+   }
+
+   std::sort (m_candidates.begin(), m_candidates.end());
+   m_candidates.erase (std::unique (m_candidates.begin(), m_candidates.end()), m_candidates.end());
+
+
+   /// Each snake's head is read before any of its comparisons, just as a pairwise loop would
+   unsigned int current = std::numeric_limits<unsigned int>::max();
+   Cell head;
+
+   for (const auto& candidate : m_candidates)
    {
+      const unsigned int i = candidate.first;
+      const unsigned int j = candidate.second;
       const auto& snake = m_snakesP[i];
-      const auto& head = snake->getHead();
+      auto& other = m_snakesP[j];
 
-      // Avoid checking against self or previous comparisons
-      for (unsigned int j {i+1}; j < m_snakesP.size(); ++j)
+      if (i != current)
       {
-         auto& other = m_snakesP[j];
+         // Copy the head because killing a Snake rolls its body back
+         head = snake->getHead();
+         current = i;
+      }
 
-         if (head.intersects (other->getHead()) || snakesCrossed (i, j))
+      if (head == other->getHead() || snakesCrossed (i, j))
+      {
+         if (other->isAlive())
          {
-            if (other->isAlive())
+            if (snake->getSize() > other->getSize())
             {
-               if (snake->getSize() > other->getSize())
-               {
-                  // Prevent snake from dying from future comparisons with other until it moves again
-                  // This gives one chance to turn away from the competing snake.
-                  snake->setPassThrough (true);
-                  other->killSnake();
-               }
-               else if (snake->getSize() < other->getSize())
-               {
-                  snake->killSnake();
-                  other->setPassThrough (true);
-               }
-               else // sizes are equal
-               {
-                  snake->killSnake();
-                  other->killSnake();
-               }
+               // Prevent snake from dying from future comparisons with other until it moves again
+               // This gives one chance to turn away from the competing snake.
+               snake->setPassThrough (true);
+               other->killSnake();
             }
-
-            else if (!snake->canPassThrough())
+            else if (snake->getSize() < other->getSize())
+            {
+               snake->killSnake();
+               other->setPassThrough (true);
+            }
+            else // sizes are equal
             {
                snake->killSnake();
+               other->killSnake();
             }
-            /// If snake->canPassThrough && !other->isAlive(dd) then allow snake to live
          }
+
+         else if (!snake->canPassThrough())
+         {
+            snake->killSnake();
+         }
+         /// If snake->canPassThrough && !other->isAlive(dd) then allow snake to live
       }
    }
 }
@@ -345,11 +452,15 @@ void SnakeManager::updateHeadCollisions()
 /// Check if any head-body collisions happen
 void SnakeManager::updateBodyCollisions()
 {
-   // Avoid self-collision detection by avoiding range-based loops
-   for (unsigned int i {0}; i < m_snakesP.size(); ++i)
+   indexHeads (false);
+
+   for (const auto i : m_living)
    {
       const auto& snake = m_snakesP[i];
-      if (snake->isAlive())
+
+      /// Any part in the cell that isn't a head belongs to a body, only then is it worth finding out whose it is. This
+      /// is the only search that isn't bounded by the number of living snakes but it only happens when a Snake dies
+      if (snake->isAlive() && m_pGrid->getSnakeParts (snake->getHead()) > countHeads (snake->getHead()))
       {
          for (unsigned int j {0}; j < m_snakesP.size(); ++j)
          {
@@ -368,21 +479,135 @@ void SnakeManager::updateBodyCollisions()
 }
 
 
-void SnakeManager::onTimer (prg::Timer& timer)
+/// Sorts the head of every living Snake into m_headIndex, optionally including where each would roll back to
+void SnakeManager::indexHeads (const bool includeRollBack)
+{
+   m_headIndex.clear();
+
+   for (const auto i : m_living)
+   {
+      const auto& snake = m_snakesP[i];
+      m_headIndex.emplace_back (getCellKey (snake->getHead()), i);
+
+      if (includeRollBack && snake->canRollBack())
+      {
+         m_headIndex.emplace_back (getCellKey (snake->getRollBackHead()), i);
+      }
+   }
+
+   std::sort (m_headIndex.begin(), m_headIndex.end());
+}
+
+
+/// Adds every pairing of snake with a head indexed at cell to m_candidates
+void SnakeManager::addCandidates (const unsigned int snake, const Cell& cell)
+{
+   addCandidates (snake, cell, m_headIndex);
+   addCandidates (snake, cell, m_deadIndex);
+}
+
+
+void SnakeManager::addCandidates (const unsigned int snake, const Cell& cell,
+                                  const std::vector<std::pair<unsigned int, unsigned int>>& index)
+{
+   const auto range = std::equal_range (index.begin(), index.end(),
+                                        std::make_pair (getCellKey (cell), 0u), compareKeys);
+
+   for (auto it = range.first; it != range.second; ++it)
+   {
+      if (it->second != snake)
+      {
+         // Always store the lowest index first to match the order of a pairwise comparison
+         m_candidates.emplace_back (std::min (snake, it->second), std::max (snake, it->second));
+      }
+   }
+}
+
+
+/// Moves every living Snake one cell, called once per tick
+void SnakeManager::moveSnakes()
 {
    /// Move all living snakes
-   for (const auto& snake : m_snakesP)
+   for (const auto i : m_living)
+   {
+      if (m_snakesP[i]->isAlive())
+      {
+         m_snakesP[i]->moveSnake();
+      }
+   }
+}
+
+
+/// Moves every living Snake by the move of the same index rather than asking its Controller
+void SnakeManager::moveSnakes (const std::vector<Movement>& moves)
+{
+   // Pre-condition: Every Snake has a move
+   if (moves.size() != m_snakesP.size())
+   {
+      throw std::runtime_error ("SnakeManager::moveSnakes() was given a different amount of moves to snakes.");
+   }
+
+   for (const auto i : m_living)
+   {
+      if (m_snakesP[i]->isAlive())
+      {
+         m_snakesP[i]->moveSnake (moves[i]);
+      }
+   }
+}
+
+
+/// Moves every Snake which has died from m_living into m_deadIndex. A dead Snake never moves again so every cell
+/// updateHeadCollisions() could pair it by is indexed once: its head, where it would roll back to if it starved
+/// rather than collided and, for a lone head, the cells snakesCrossed() checks
+void SnakeManager::removeDeadSnakes()
+{
+   unsigned int living {0};
+
+   for (const auto i : m_living)
    {
+      const auto& snake = m_snakesP[i];
+
       if (snake->isAlive())
       {
-         snake->moveSnake();
+         m_living[living++] = i;
+         continue;
+      }
+
+      const Cell positions[2] { snake->getHead(), snake->canRollBack() ? snake->getRollBackHead() : snake->getHead() };
+
+      for (const auto& position : positions)
+      {
+         addDeadHead (i, position);
+
+         if (snake->getSize() == 1)
+         {
+            addDeadHead (i, getPreviousCell (position, snake->getLastMove()));
+         }
       }
    }
+
+   m_living.resize (living);
+}
+
+
+/// Inserts the snake at cell into m_deadIndex, keeping it sorted
+void SnakeManager::addDeadHead (const unsigned int snake, const Cell& cell)
+{
+   const auto entry = std::make_pair (getCellKey (cell), snake);
+   const auto position = std::lower_bound (m_deadIndex.begin(), m_deadIndex.end(), entry);
+
+   if (position == m_deadIndex.end() || *position != entry)
+   {
+      m_deadIndex.insert (position, entry);
+   }
 }
 
 
 void SnakeManager::drawSnakes(prg::Canvas& canvas)
 {
+   const Profiler::Scope scope {Profiler::Phase::DrawSnakes};
+
    /// Draw dead snakes first so head-on collisions make it look like the small snake got crushed
    for (const auto& snake : m_snakesP)
    {
@@ -403,7 +628,7 @@ void SnakeManager::drawSnakes(prg::Canvas& canvas)
 
 
 /// Obtain all flakes and move them to modify
-void SnakeManager::extractFlakes (std::vector<std::unique_ptr<Rectangle>>& modify)
+void SnakeManager::extractFlakes (std::vector<Cell>& modify)
 {
    // Have all Snake objects flake into modify
    for (const auto& snake : m_snakesP)
@@ -449,6 +674,40 @@ void SnakeManager::incrementScore (const unsigned int index, const unsigned int
 }
 
 
+void SnakeManager::save (Snapshot& modify) const
+{
+   modify.m_snakes.resize (m_snakesP.size());
+
+   for (unsigned int i {0}; i < m_snakesP.size(); ++i)
+   {
+      m_snakesP[i]->save (modify.m_snakes[i]);
+   }
+
+   modify.m_living = m_living;
+   modify.m_deadIndex = m_deadIndex;
+   modify.m_livingSnakes = m_livingSnakes;
+}
+
+
+void SnakeManager::restore (const Snapshot& snapshot)
+{
+   // Pre-condition: The snapshot holds the same snakes
+   if (snapshot.m_snakes.size() != m_snakesP.size())
+   {
+      throw std::runtime_error ("SnakeManager::restore() was given a Snapshot with a different amount of snakes.");
+   }
+
+   for (unsigned int i {0}; i < m_snakesP.size(); ++i)
+   {
+      m_snakesP[i]->restore (snapshot.m_snakes[i]);
+   }
+
+   m_living = snapshot.m_living;
+   m_deadIndex = snapshot.m_deadIndex;
+   m_livingSnakes = snapshot.m_livingSnakes;
+}
+
+
 
 /// Getters
 unsigned int SnakeManager::getWinnerIndex() const
@@ -487,7 +746,7 @@ unsigned int SnakeManager::getWinnerIndex() const
 }
 
 
-const Rectangle& SnakeManager::getSnakeHead (const unsigned int index) const
+const Cell& SnakeManager::getSnakeHead (const unsigned int index) const
 {
    // Pre-condition: Index < m_snakesP.size()
    if (index > m_snakesP.size())
@@ -497,3 +756,66 @@ const Rectangle& SnakeManager::getSnakeHead (const unsigned int index) const
    return m_snakesP[index]->getHead();
 }
 
+
+Movement SnakeManager::getSnakeLastMove (const unsigned int index) const
+{
+   // Pre-condition: Index < m_snakesP.size()
+   if (index >= m_snakesP.size())
+   {
+      throw std::runtime_error ("Index too high in SnakeManager::getSnakeLastMove().");
+   }
+   return m_snakesP[index]->getLastMove();
+}
+
+
+unsigned int SnakeManager::getSnakeScore (const unsigned int index) const
+{
+   // Pre-condition: Index < m_snakesP.size()
+   if (index >= m_snakesP.size())
+   {
+      throw std::runtime_error ("Index too high in SnakeManager::getSnakeScore().");
+   }
+   return m_snakesP[index]->getScore();
+}
+
+
+const SnakeBody& SnakeManager::getSnakeBody (const unsigned int index) const
+{
+   // Pre-condition: Index < m_snakesP.size()
+   if (index >= m_snakesP.size())
+   {
+      throw std::runtime_error ("Index too high in SnakeManager::getSnakeBody().");
+   }
+   return m_snakesP[index]->getBody();
+}
+
+
+/// Undoes lastMove, taking into account the ability to spawn at the other side
+Cell SnakeManager::getPreviousCell (const Cell& cell, const Movement lastMove) const
+{
+   Cell previous = cell;
+
+   switch (lastMove)
+   {
+      case Movement::Up:
+         utility::moveCell (m_kSetup, previous, 0, -1);
+         break;
+
+      case Movement::Left:
+         utility::moveCell (m_kSetup, previous, 1, 0);
+         break;
+
+      case Movement::Right:
+         utility::moveCell (m_kSetup, previous, -1, 0);
+         break;
+
+      case Movement::Down:
+         utility::moveCell (m_kSetup, previous, 0, 1);
+         break;
+
+      default: // This should never happen
+         break;
+   }
+
+   return previous;
+}
@@ -80,6 +80,7 @@ void ConfigurationState::prepareButtons()
    m_gridWidthButton.setClickableArea (placement);
    m_gridWidthButton.setColour ({255, 0, 0});      // Red
    m_gridWidthButton.setText ("Grid Width: " + utility::intToString (m_pSetup->getGridWidth()));
+   m_aiPlayersButton.setText ("AI: " + utility::intToString (m_pSetup->getAI()));
 
 
    // Move right
@@ -87,6 +88,7 @@ void ConfigurationState::prepareButtons()
    m_gridHeightButton.setClickableArea (placement);
    m_gridHeightButton.setColour ({255, 0, 0});     // Red
    m_gridHeightButton.setText ("Grid Height: " + utility::intToString (m_pSetup->getGridHeight()));
+   m_aiPlayersButton.setText ("AI: " + utility::intToString (m_pSetup->getAI()));
 }
 
 
@@ -297,6 +299,7 @@ void ConfigurationState::onClickGridWidth (const MouseEvent& mouseEvent)
 
    // Confirm correct data by retrieving from m_pSetup
    m_gridWidthButton.setText ("Grid Width: " + utility::intToString (m_pSetup->getGridWidth()));
+   m_aiPlayersButton.setText ("AI: " + utility::intToString (m_pSetup->getAI()));
 }
 
 
@@ -325,6 +328,7 @@ void ConfigurationState::onClickGridHeight (const MouseEvent& mouseEvent)
 
    // Confirm correct data by retrieving from m_pSetup
    m_gridHeightButton.setText ("Grid Height: " + utility::intToString (m_pSetup->getGridHeight()));
+   m_aiPlayersButton.setText ("AI: " + utility::intToString (m_pSetup->getAI()));
 }
 
 
@@ -364,10 +368,7 @@ void ConfigurationState::onClickAIPlayers (const MouseEvent& mouseEvent)
    // Increase ai
    if (mouseEvent.button == MouseEvent::LM_BTN)
    {
-      if (ai != 4)
-      {
-         ++ai;
-      }
+      ++ai; // m_pSetup limits AI to the spawn points available
    }
    // Decrease ai
    else
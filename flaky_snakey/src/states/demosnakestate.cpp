@@ -21,9 +21,17 @@
 #include <states/demosnakestate.hpp>
 
 
+/// STL
+#include <fstream> // saveGame()
+
+
+/// Third party
+#include <prg/core/log.hpp> // saveGame()
+
+
 /// Constructors and destructor
 DemoSnakeState::DemoSnakeState()
-   :  SnakeState(), m_continueButton ()
+   :  SnakeState (1), m_continueButton ()
 {
 }
 
@@ -32,25 +40,10 @@ DemoSnakeState::DemoSnakeState()
 /// Core requirements
 void DemoSnakeState::reset()
 {
-   /// Create InGameSetup
-   InGameSetup setup;
-   setup.setResolution (m_pSetup->m_resX, m_pSetup->m_resY);
-   setup.setGrid (m_pSetup->m_gridWidth, m_pSetup->m_gridHeight);
-
-   /// Prepare ObstacleManager
-   m_pObstacleManager = std::make_shared<ObstacleManager> (setup);
-
-
-   /// Prepare FoodManager
-   m_pFoodManager = std::make_shared<FoodManager> (setup, m_pSetup->m_foodRotInterval, m_pSetup->m_foodMin, m_pSetup->m_foodMax, true);
-
-   /// Prepare SnakeManager
-   m_pSnakeManager = std::make_shared<SnakeManager> (setup, 1, m_pSetup->m_snakeUpdateInterval, 0, 1, "dumb");
-
-   m_pUI = std::make_shared<SnakeInterface>(setup);
-   m_pSnakeManager->initialiseSnakes (m_pSetup->m_names, m_pUI);
-   m_pSnakeManager->initialiseAI (m_pSnakeManager, m_pFoodManager, m_pObstacleManager);
-   m_pSnakeManager->resume();
+   /// The demo only ever has one dumb AI Snake
+   SnakeStateSetup demo {*m_pSetup};
+   demo.setPlayers (0, 1).setSnakeAI ("dumb");
+   createWorld (demo);
 
    /// Prepare Button objects, do it here because workingX/Y can change mid-game
    prepareButtons();
@@ -99,28 +92,8 @@ void DemoSnakeState::prepareButtons()
 /// Functionality
 void DemoSnakeState::onUpdate()
 {
-   /// Update the food
-   m_pFoodManager->update();
-   if (m_pFoodManager->isSpawnRequired() && m_spawnAvailable)
-   {
-      const auto& spawn = findSpawnPoint();
-      if (spawn == Rectangle {10, 10, 0, 0})
-      {
-         m_spawnAvailable = false;
-      }
-
-      else
-      {
-         m_pFoodManager->addFood (spawn);
-      }
-   }
-
-   /// Update the snakes
-   m_pSnakeManager->update();
-   updateCollisions();
-   processFlakes();
-
-   if (m_pSnakeManager->isGameOver())
+   /// The World is stepped by the timer, the demo simply starts again when it ends
+   if (m_pWorld->isGameOver())
    {
       reset();
    }
@@ -130,11 +103,7 @@ void DemoSnakeState::onUpdate()
 void DemoSnakeState::onRender (prg::Canvas& canvas)
 {
    drawBorder (canvas);
-   m_pUI->draw (canvas);
-
-   m_pObstacleManager->drawObstacles (canvas);
-   m_pFoodManager->drawFood (canvas);
-   m_pSnakeManager->drawSnakes (canvas);
+   drawWorld (canvas);
 
    m_continueButton.draw (canvas);
    m_resetButton.draw (canvas);
@@ -155,6 +124,18 @@ bool DemoSnakeState::onKey (const KeyEvent& keyEvent)
          case 'p':
          case 'P':
             prg::application.setState ("game");
+            break;
+
+         case 's':
+         case 'S':
+            saveGame();
+            break;
+
+         case 'l':
+         case 'L':
+            m_pSetup->setLoadGame (true);
+            prg::application.setState ("game");
+            break;
       }
    }
    return true;
@@ -220,3 +201,20 @@ bool DemoSnakeState::onButton (const MouseEvent& mouseEvent)
 
    return true;
 }
+
+
+/// The main state has already saved the game into memory so this only writes it out
+void DemoSnakeState::saveGame()
+{
+   const auto& save = m_pSetup->getSavedGame();
+
+   if (save)
+   {
+      std::ofstream file (m_pSetup->getSavePath(), std::ios::binary | std::ios::trunc);
+      file.write (reinterpret_cast<const char*> (save->data()), save->size());
+
+      prg::Log::Message message (file ? prg::Log::Message::LT_Info : prg::Log::Message::LT_Error);
+      message << (file ? "Saved the game to " : "Unable to save the game to ") << m_pSetup->getSavePath() << '\n';
+      prg::logger.add (message);
+   }
+}
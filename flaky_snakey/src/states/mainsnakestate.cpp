@@ -21,9 +21,18 @@
 #include <states/mainsnakestate.hpp>
 
 
+/// Third party
+#include <prg/core/log.hpp> // loadGame()
+
+
+/// Personal
+#include <simulation/replay.hpp>   // onTimer()
+#include <simulation/savegame.hpp> // onExit() and loadGame()
+
+
 /// Constructors and destructor
 MainSnakeState::MainSnakeState()
-   :  SnakeState(), m_winnerIndex (0)
+   :  SnakeState (0), m_winnerIndex (0), m_pRecorder (nullptr)
 {
 }
 
@@ -32,28 +41,9 @@ MainSnakeState::MainSnakeState()
 /// Core requirements
 void MainSnakeState::reset()
 {
-   /// Create InGameSetup
-   InGameSetup setup;
-   setup.setResolution (m_pSetup->m_resX, m_pSetup->m_resY);
-   setup.setGrid (m_pSetup->m_gridWidth, m_pSetup->m_gridHeight);
-
-   /// Prepare FoodManager
-   m_pFoodManager = std::make_shared<FoodManager> (setup, m_pSetup->m_foodRotInterval, m_pSetup->m_foodMin, m_pSetup->m_foodMax);
-
-
-   /// Prepare ObstacleManager
-   m_pObstacleManager = std::make_shared<ObstacleManager> (setup);
-
-
-   /// Prepare SnakeManager
-   m_pSnakeManager = std::make_shared<SnakeManager> (setup, 0, m_pSetup->m_snakeUpdateInterval, m_pSetup->m_human, m_pSetup->m_ai, m_pSetup->m_snakeAI);
-
-   m_pUI = std::make_shared<SnakeInterface>(setup);
-   m_pSnakeManager->initialiseSnakes (m_pSetup->m_names, m_pUI);
-   m_pSnakeManager->initialisePlayers (m_pSetup->m_keymaps);
-   m_pSnakeManager->initialiseAI (m_pSnakeManager, m_pFoodManager, m_pObstacleManager);
-   m_pSnakeManager->resume();
-
+   /// The main game uses the configured setup as is
+   createWorld (*m_pSetup);
+   m_pRecorder.reset (new ReplayRecorder (*m_pSetup, m_pWorld->getSeed()));
 
    /// Prepare Button objects, do it here because workingX/Y can change mid-game
    prepareButtons();
@@ -86,35 +76,45 @@ void MainSnakeState::prepareButtons()
 
 
 /// Functionality
-void MainSnakeState::onUpdate()
+/// The pause state asks for the save to be loaded, it's done here so the game is ready before it's shown
+void MainSnakeState::onEntry()
 {
-   if (!m_pSnakeManager->isGameOver())
+   if (m_pSetup && m_pSetup->getLoadGame())
    {
-      /// Update the food
-      m_pFoodManager->update();
-      if (m_pFoodManager->isSpawnRequired() && m_spawnAvailable)
-      {
-         const auto& spawn = findSpawnPoint();
-         if (spawn == Rectangle {10, 10, 0, 0})
-         {
-            m_spawnAvailable = false;
-         }
+      m_pSetup->setLoadGame (false);
+      loadGame();
+   }
 
-         else
-         {
-            m_pFoodManager->addFood (spawn);
-         }
-      }
+   SnakeState::onEntry();
+}
 
-      /// Update the snakes
-      m_pSnakeManager->update();
-      updateCollisions();
-      processFlakes();
+
+/// Saving only copies the state into memory, the disk isn't touched unless the player asks for it
+void MainSnakeState::onExit()
+{
+   SnakeState::onExit();
+
+   if (m_pWorld->isGameOver())
+   {
+      m_pSetup->setSavedGame (nullptr);
    }
 
    else
    {
-      m_winnerIndex = m_pSnakeManager->getWinnerIndex();
+      auto save = std::make_shared<std::vector<unsigned char>>();
+      SaveGame::write (*m_pSetup, *m_pWorld, *save);
+
+      m_pSetup->setSavedGame (save);
+   }
+}
+
+
+void MainSnakeState::onUpdate()
+{
+   /// The World is stepped by the timer, only the result needs watching
+   if (m_pWorld->isGameOver())
+   {
+      m_winnerIndex = m_pWorld->getWinnerIndex();
    }
 }
 
@@ -122,12 +122,9 @@ void MainSnakeState::onUpdate()
 void MainSnakeState::onRender (prg::Canvas& canvas)
 {
    drawBorder (canvas);
-   m_pUI->draw (canvas);
-   m_pObstacleManager->drawObstacles (canvas);
-   m_pFoodManager->drawFood (canvas);
-   m_pSnakeManager->drawSnakes (canvas);
+   drawWorld (canvas);
 
-   if (m_pSnakeManager->isGameOver())
+   if (m_pWorld->isGameOver())
    {
       drawGameOver (canvas);
       m_resetButton.draw (canvas);
@@ -148,7 +145,7 @@ bool MainSnakeState::onKey (const KeyEvent& keyEvent)
 
          case 'r':
          case 'R':
-            if (m_pSnakeManager->isGameOver())
+            if (m_pWorld->isGameOver())
             {
                reset();
                return false;
@@ -158,6 +155,15 @@ bool MainSnakeState::onKey (const KeyEvent& keyEvent)
          case 'p':
          case 'P':
             prg::application.setState ("pause");
+            break;
+
+         case 'v':
+         case 'V':
+            if (m_pWorld->isGameOver() && m_pSetup->getReplay())
+            {
+               prg::application.setState ("replay");
+               return false;
+            }
       }
    }
    return true;
@@ -166,7 +172,7 @@ bool MainSnakeState::onKey (const KeyEvent& keyEvent)
 
 bool MainSnakeState::onMotion (const MouseEvent& mouseEvent)
 {
-   if (m_pSnakeManager->isGameOver())
+   if (m_pWorld->isGameOver())
    {
       /// Disable borders
       m_resetButton.setMouseOver (false);
@@ -193,7 +199,7 @@ bool MainSnakeState::onMotion (const MouseEvent& mouseEvent)
 
 bool MainSnakeState::onButton (const MouseEvent& mouseEvent)
 {
-   if (m_pSnakeManager->isGameOver())
+   if (m_pWorld->isGameOver())
    {
       if (mouseEvent.button_state == MouseEvent::MB_DOWN && mouseEvent.button == MouseEvent::LM_BTN)
       {
@@ -217,6 +223,61 @@ bool MainSnakeState::onButton (const MouseEvent& mouseEvent)
 }
 
 
+/// The World only advances while the game is running, the finished recording is kept as the setup's Replay
+void MainSnakeState::onTimer (prg::Timer& timer)
+{
+   const unsigned int tick = m_pWorld->getTick();
+   SnakeState::onTimer (timer);
+
+   if (m_pWorld->getTick() != tick && m_pRecorder)
+   {
+      m_pRecorder->record (*m_pWorld);
+
+      if (m_pWorld->isGameOver())
+      {
+         std::vector<unsigned char> data;
+         m_pRecorder->save (*m_pWorld, data);
+
+         m_pSetup->setReplay (std::make_shared<const Replay> (data.data(), data.size()));
+      }
+   }
+}
+
+
+/// A save which can't be loaded is logged and a new game is started instead. A replay has to start from the first
+/// tick so a loaded game isn't recorded
+void MainSnakeState::loadGame()
+{
+   try
+   {
+      const SaveGame save {m_pSetup->getSavePath()};
+      SnakeStateSetup game {*m_pSetup};
+      game.setGame (save.getSetup());
+
+      createWorld (game, save.getSeed());
+      save.restore (*m_pWorld);
+
+      m_pSetup->setGame (game);
+      m_pRecorder.reset();
+   }
+
+   catch (const std::runtime_error& error)
+   {
+      prg::Log::Message errorMessage (prg::Log::Message::LT_Error);
+      errorMessage << "Unable to load the saved game: " << error.what() << '\n';
+      prg::logger.add (errorMessage);
+
+      reset();
+   }
+
+   /// Prepare Button objects, the grid may have changed
+   prepareButtons();
+
+   m_pSetup->setForceReset (false);
+   m_needsReset = false;
+}
+
+
 void MainSnakeState::drawGameOver (prg::Canvas& canvas)
 {
    /// Get parameters for the sake of efficiency
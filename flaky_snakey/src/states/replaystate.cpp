@@ -0,0 +1,224 @@
+/*
+   Program: Flaky Snakey
+   Created by Simon Peter Campbell
+
+   The purpose of Flaky Snakey is simply to show understanding of OOP concepts for my C++ Programming
+   module. Using the supplied PRG library I had the task of creating a Snake-like game.
+
+   Copyright (C) 2014 Simon Peter Campbell
+   This file is part of Flaky Snakey.
+
+   Flaky Snakey is free software: you can redistribute it and/or modify it under
+   the terms of the GNU General Public License as published by the Free Software Foundation,
+   either version 3 of the License, or any later version. Flaky Snakey is distributed
+   in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+   Public License for more details. You should have received a copy of the GNU General Public
+   License along with Flaky Snakey. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <states/replaystate.hpp>
+
+
+/// Static members are passed by reference so they need defining
+const int ReplayState::kSeekTicks;
+
+
+
+/// Constructors and destructor
+ReplayState::ReplayState()
+   :  SnakeState (2), m_pPlayer (nullptr), m_paused (false)
+{
+}
+
+
+
+/// Core requirements
+/// Without a replay the state shows an empty level of the configured setup so it always has a World to draw
+void ReplayState::reset()
+{
+   const auto& replay = m_pSetup->getReplay();
+
+   if (replay)
+   {
+      createWorld (replay->getSetup(), replay->getSeed());
+      m_pPlayer.reset (new ReplayPlayer (replay, *m_pWorld));
+   }
+
+   else
+   {
+      createWorld (*m_pSetup);
+      m_pPlayer.reset();
+   }
+
+   /// Prepare Button objects, do it here because workingX/Y can change mid-game
+   prepareButtons();
+
+   m_paused = false;
+   m_needsReset = false;
+}
+
+
+void ReplayState::prepareButtons()
+{
+   /// Two buttons should appear at 33% Y next to each other
+   const unsigned int workingX = m_pSetup->getWorkingX();
+   const unsigned int workingY = m_pSetup->getWorkingY();
+
+   Rectangle placement { workingX / 3, workingY / 4,
+                         m_pSetup->getStartX() + workingX / 4 - workingX / 6,
+                         m_pSetup->getStartY() + workingY / 4 - workingY / 8 };
+
+   /// Set up buttons
+   m_resetButton.setClickableArea (placement);
+   m_resetButton.setColour ({255, 165, 0});        // Orange
+   m_resetButton.setText ("Restart replay");
+
+   placement.incrementPosition (workingX / 2, 0);
+   m_quitButton.setClickableArea (placement);
+   m_quitButton.setColour ({255, 0, 0});           // Red
+   m_quitButton.setText ("Back to the game");
+}
+
+
+
+/// Functionality
+/// A game recorded since the last visit replaces the one being watched
+void ReplayState::onEntry()
+{
+   if (!m_pPlayer || m_pPlayer->getReplay() != m_pSetup->getReplay())
+   {
+      m_needsReset = true;
+   }
+
+   SnakeState::onEntry();
+}
+
+
+void ReplayState::onUpdate()
+{
+}
+
+
+void ReplayState::onRender (prg::Canvas& canvas)
+{
+   drawBorder (canvas);
+   drawWorld (canvas);
+
+   if (m_paused || !m_pPlayer || m_pPlayer->isFinished())
+   {
+      m_resetButton.draw (canvas);
+      m_quitButton.draw (canvas);
+   }
+}
+
+
+bool ReplayState::onKey (const KeyEvent& keyEvent)
+{
+   if (keyEvent.key_state == KeyEvent::KB_DOWN)
+   {
+      switch (keyEvent.key)
+      {
+         case KeyEvent::KB_ESC_KEY:
+            prg::application.exit();
+            return false;
+
+         case KeyEvent::KB_SPC_KEY:
+            m_paused = !m_paused;
+            return false;
+
+         case KeyEvent::KB_LEFT_KEY:
+            seek (-kSeekTicks);
+            return false;
+
+         case KeyEvent::KB_RIGHT_KEY:
+            seek (kSeekTicks);
+            return false;
+
+         case 'r':
+         case 'R':
+            seek (-(int) m_pWorld->getTick());
+            return false;
+
+         case 'q':
+         case 'Q':
+            prg::application.setState ("game");
+      }
+   }
+   return true;
+}
+
+
+bool ReplayState::onMotion (const MouseEvent& mouseEvent)
+{
+   /// Disable borders
+   m_resetButton.setMouseOver (false);
+   m_quitButton.setMouseOver (false);
+
+   const Rectangle position {0, 0, (unsigned) mouseEvent.pos_x, (unsigned) mouseEvent.pos_y};
+
+   if (m_resetButton.intersects (position))
+   {
+      m_resetButton.setMouseOver (true);
+      return false;
+   }
+
+   else if (m_quitButton.intersects (position))
+   {
+      m_quitButton.setMouseOver (true);
+      return false;
+   }
+
+   return true;
+}
+
+
+bool ReplayState::onButton (const MouseEvent& mouseEvent)
+{
+   if (m_paused || !m_pPlayer || m_pPlayer->isFinished())
+   {
+      if (mouseEvent.button_state == MouseEvent::MB_DOWN && mouseEvent.button == MouseEvent::LM_BTN)
+      {
+         const Rectangle position {0, 0, (unsigned) mouseEvent.pos_x, (unsigned) mouseEvent.pos_y};
+
+         if (m_resetButton.intersects (position))
+         {
+            seek (-(int) m_pWorld->getTick());
+            m_paused = false;
+            return false;
+         }
+
+         else if (m_quitButton.intersects (position))
+         {
+            prg::application.setState ("game");
+            return false;
+         }
+      }
+   }
+
+   return true;
+}
+
+
+/// Plays the next tick of the replay instead of letting the Controllers decide
+void ReplayState::onTimer (prg::Timer&)
+{
+   if (m_pPlayer && !m_paused)
+   {
+      m_pPlayer->step();
+   }
+}
+
+
+/// Restoring a keyframe leaves the UI showing the scores from before the seek
+void ReplayState::seek (const int ticks)
+{
+   if (m_pPlayer)
+   {
+      const int target = (int) m_pPlayer->getTick() + ticks;
+
+      m_pPlayer->seek (target > 0 ? target : 0);
+      m_pWorld->getSnakeManager()->updateInterface();
+   }
+}
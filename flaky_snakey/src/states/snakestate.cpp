@@ -22,9 +22,9 @@
 
 
 /// Constructors and destructor
-SnakeState::SnakeState()
-   :  m_pSetup (nullptr), m_pFoodManager (nullptr), m_pObstacleManager (nullptr), m_pSnakeManager (nullptr),
-      m_pUI (nullptr), m_resetButton (), m_quitButton(), m_spawnAvailable (true), m_needsReset (true)
+SnakeState::SnakeState (const unsigned int timerID)
+   :  m_pSetup (nullptr), m_pWorld (nullptr), m_pUI (nullptr), m_timer (timerID, 100, *this),
+      m_resetButton (), m_quitButton(), m_needsReset (true)
 {
 }
 
@@ -44,6 +44,29 @@ void SnakeState::setSetup (const std::shared_ptr<SnakeStateSetup>& setup)
 }
 
 
+/// A configured seed replays the same game, otherwise every game is different
+void SnakeState::createWorld (const SnakeStateSetup& setup)
+{
+   createWorld (setup, setup.getSeed() != 0 ? setup.getSeed() : time (0));
+}
+
+
+/// Replaces the World with a new game made from setup and starts stepping it at the setup's interval
+void SnakeState::createWorld (const SnakeStateSetup& setup, const unsigned int seed)
+{
+   /// The UI is laid out from the same InGameSetup as the World
+   InGameSetup inGame;
+   inGame.setResolution (setup.getResX(), setup.getResY());
+   inGame.setGrid (setup.getGridWidth(), setup.getGridHeight());
+
+   m_pUI = std::make_shared<SnakeInterface> (inGame);
+   m_pWorld.reset (new World (setup, seed, m_pUI));
+   m_pWorld->resume();
+
+   m_timer.reset (setup.getSnakeUpdateInterval());
+}
+
+
 
 /// Functionality
 bool SnakeState::onCreate()
@@ -61,17 +84,15 @@ bool SnakeState::onDestroy()
 void SnakeState::onEntry()
 {
    // Pre-condition: Check pointers
-   if (m_pSetup && m_pFoodManager && m_pObstacleManager && m_pSnakeManager && m_pUI)
+   if (m_pSetup && m_pWorld && m_pUI)
    {
       if (m_needsReset || m_pSetup->getForceReset())
       {
          reset ();
       }
 
-      /// Reseed RNG
-      srand (time (0));
-      m_pSnakeManager->resume();
-      m_pFoodManager->resume();
+      m_pWorld->resume();
+      m_timer.start();
       prg::application.addKeyListener (*this);
       prg::application.addMouseListener (*this);
    }
@@ -86,112 +107,17 @@ void SnakeState::onEntry()
 
 void SnakeState::onExit()
 {
-   m_pSnakeManager->pause();
-   m_pFoodManager->pause();
+   m_timer.stop();
+   m_pWorld->pause();
    prg::application.removeKeyListener (*this);
    prg::application.removeMouseListener (*this);
 }
 
 
-/// Check cross-Manager collisions
-void SnakeState::updateCollisions()
+/// Advances the World by one tick
+void SnakeState::onTimer (prg::Timer&)
 {
-   for (unsigned int i {0}; i < m_pSnakeManager->getSnakeAmount(); ++i)
-   {
-      if (m_pSnakeManager->isSnakeAlive (i))
-      {
-         /// Check Obstacle collision
-         const auto& head = m_pSnakeManager->getSnakeHead (i);
-
-         if (m_pObstacleManager->isObstacleHere (head))
-         {
-            m_pSnakeManager->killSnake (i);
-         }
-
-         /// Check Food collision manually for the sake of efficiency
-         else
-         {
-            for (unsigned int j {0}; j < m_pFoodManager->getFoodAmount(); ++j)
-            {
-               if (head.intersects (m_pFoodManager->getFoodPosition (j)))
-               {
-                  /// Get food effect
-                  m_pSnakeManager->alterSnakeSize (i, m_pFoodManager->getFoodEffect (j));
-                  m_pSnakeManager->incrementScore (i, m_pSetup->getScoreFood());
-                  m_pFoodManager->removeFood (j);
-               }
-            }
-         }
-      } // Do nothing if Snake is dead
-   }
-}
-
-
-/// Extract flakes and convert into Obstacle objects
-void SnakeState::processFlakes()
-{
-   // The vector will sink upon completion of processFlakes
-   std::vector<std::unique_ptr<Rectangle>> flakes;
-   m_pSnakeManager->extractFlakes (flakes);
-
-   for (const auto& flake : flakes)
-   {
-      m_pObstacleManager->addObstacle (*flake);
-   }
-}
-
-
-/// Obtain a valid spawn point for FoodManager, return {10, 10, 0, 0} if impossible
-Rectangle SnakeState::findSpawnPoint()
-{
-   /// Increase efficiency by obtaining parameters early
-   const unsigned int gridWidth = m_pSetup->getGridWidth();
-   const unsigned int gridHeight = m_pSetup->getGridHeight();
-   const unsigned int gridSize = gridWidth * gridHeight;
-   const unsigned int rectWidth = m_pSetup->getRectWidth();
-   const unsigned int rectHeight = m_pSetup->getRectHeight();
-   const unsigned int startX = m_pSetup->getStartX();
-   const unsigned int startY = m_pSetup->getStartY();
-
-   /// Stores previous attempts, stops infinite looping if all spaces are full
-   std::vector<Rectangle> attempted;
-
-   while (attempted.size() != gridSize)
-   {
-      // Generate attempt
-      Rectangle attempt {rectWidth,                                     rectHeight,
-                         startX + (rectWidth * (rand() % gridWidth)),   startY + (rectHeight * (rand() % gridHeight))};
-
-      /// Check if it's been tried before
-      bool tried = false;
-      for (const auto& previous : attempted)
-      {
-         if (attempt.intersects (previous))
-         {
-            tried = true;
-            break;
-         }
-      }
-
-      /// If it hasn't been tried then test if the position is empty
-      if (!tried)
-      {
-         if (m_pSnakeManager->isSnakeHere (attempt) ||
-             m_pObstacleManager->isObstacleHere (attempt) ||
-             m_pFoodManager->isFoodHere (attempt))
-         {
-            attempted.push_back (attempt);
-         }
-
-         /// Found a valid spawn point!
-         else
-         {
-            return attempt;
-         }
-      }
-   }
-
-   return Rectangle {10, 10, 0, 0};
+   m_pWorld->step();
 }
 
 
@@ -220,3 +146,12 @@ void SnakeState::drawBorder (prg::Canvas& canvas)
    // Right vertical
    canvas.drawLine (endX, startY - 1, endX, endY, {102, 0, 102});
 }
+
+
+void SnakeState::drawWorld (prg::Canvas& canvas)
+{
+   m_pUI->draw (canvas);
+   m_pWorld->getObstacleManager()->drawObstacles (canvas);
+   m_pWorld->getFoodManager()->drawFood (canvas);
+   m_pWorld->getSnakeManager()->drawSnakes (canvas);
+}
@@ -19,11 +19,12 @@
 
 
 #include <ui/snakeinterface.hpp>
+#include <misc/profiler.hpp>
 
 
 /// Constructors and destructor
 SnakeInterface::SnakeInterface (const InGameSetup& setup)
-   :  m_kSetup (setup), m_scores (4)
+   :  m_kSetup (setup), m_font ("assets/fonts/instruction.ttf", setup.getMarginUI() / 10), m_scores (0), m_colours (0)
 {
 }
 
@@ -32,9 +33,11 @@ SnakeInterface::SnakeInterface (const InGameSetup& setup)
 /// Functionality
 void SnakeInterface::draw (prg::Canvas& canvas)
 {
+   const Profiler::Scope scope {Profiler::Phase::DrawInterface};
+
    // Used to simplify drawing code
-   std::vector<prg::Colour> colours (4);
-   fillColours (colours);
+   m_colours.resize (m_scores.size());
+   fillColours (m_colours);
 
    const unsigned int startX = m_kSetup.getMarginX();
    const unsigned int startY = m_kSetup.getMarginY();
@@ -42,76 +45,36 @@ void SnakeInterface::draw (prg::Canvas& canvas)
    const unsigned int endY = m_kSetup.getEndY();
    const unsigned int uiWidth = m_kSetup.getMarginUI();
 
-   prg::Font font ("assets/fonts/instruction.ttf", uiWidth / 10); // 10 max characters
+   /// Players alternate between the left and right side, filling each side from the top down. Each player needs room
+   /// for a name and a score so anyone who won't fit is left off
+   unsigned int dimensions[2];
+   m_font.computePrintDimensions (dimensions, "0");
+
+   const unsigned int maxRows = (endY - startY) / (dimensions[1] * 3 + 1);
+   const unsigned int rows = std::min (std::max ((unsigned int) (m_scores.size() + 1) / 2, 2u), maxRows);
 
    /// NULL represents an unused player
-   for (unsigned int i {0}; i < m_scores.size(); ++i)
+   for (unsigned int i {0}; i < m_scores.size() && i / 2 < rows; ++i)
    {
       if (m_scores[i].getName() != "NULL")
       {
-         const std::string& score = utility::intToString (m_scores[i].getScore());
+         const std::string& score = m_scores[i].getScoreText();
          const std::string& name = m_scores[i].getName();
 
-         unsigned int nameX;
-         unsigned int nameY;
-         unsigned int scoreX;
-         unsigned int scoreY;
-         unsigned int dimensions[2];
-
-         /// Compute individual player positions
-         switch (i)
-         {
-            case 0: // Player 1 == 66% up on the left side
-               font.computePrintDimensions (dimensions, name);
-               nameX = startX + uiWidth / 2 - dimensions[0] / 2;
-               nameY = startY + (endY - startY) * 0.66 + dimensions[1];
-
-
-               font.computePrintDimensions (dimensions, score);
-               scoreX = startX + uiWidth / 2 - dimensions[0] / 2;
-               scoreY = startY + (endY - startY) * 0.66 - dimensions[1];
-               break;
-
-
-            case 1: // Player 2 == 66% up on the right side
-               font.computePrintDimensions (dimensions, name);
-               nameX = endX + uiWidth / 2 - dimensions[0] / 2;
-               nameY = startY + (endY - startY) * 0.66 + dimensions[1];
-
-
-               font.computePrintDimensions (dimensions, score);
-               scoreX = endX + uiWidth / 2 - dimensions[0] / 2;
-               scoreY = startY + (endY - startY) * 0.66 - dimensions[1];
-               break;
-
-
-            case 2: // Player 3 == 33% up on the left side
-               font.computePrintDimensions (dimensions, name);
-               nameX = startX + uiWidth / 2 - dimensions[0] / 2;
-               nameY = startY + (endY - startY) * 0.33 + dimensions[1];
-
-
-               font.computePrintDimensions (dimensions, score);
-               scoreX = startX + uiWidth / 2 - dimensions[0] / 2;
-               scoreY = startY + (endY - startY) * 0.33 - dimensions[1];
-               break;
-
-
-            case 3: // Player 4 == 33% up on the right side
-               font.computePrintDimensions (dimensions, name);
-               nameX = endX + uiWidth / 2 - dimensions[0] / 2;
-               nameY = startY + (endY - startY) * 0.33 + dimensions[1];
-
+         /// Compute individual player positions, with four players that's 66% and 33% up each side
+         const unsigned int sideX = i % 2 == 0 ? startX : endX;
+         const unsigned int centreY = startY + (endY - startY) * (rows - i / 2) / (rows + 1);
 
-               font.computePrintDimensions (dimensions, score);
-               scoreX = endX + uiWidth / 2 - dimensions[0] / 2;
-               scoreY = startY + (endY - startY) * 0.33 - dimensions[1];
-               break;
+         m_font.computePrintDimensions (dimensions, name);
+         const unsigned int nameX = sideX + uiWidth / 2 - dimensions[0] / 2;
+         const unsigned int nameY = centreY + dimensions[1];
 
-         }
+         m_font.computePrintDimensions (dimensions, score);
+         const unsigned int scoreX = sideX + uiWidth / 2 - dimensions[0] / 2;
+         const unsigned int scoreY = centreY - dimensions[1];
 
-         font.print (canvas, nameX, nameY, colours[i], name);
-         font.print (canvas, scoreX, scoreY, colours[i], score);
+         m_font.print (canvas, nameX, nameY, m_colours[i], name);
+         m_font.print (canvas, scoreX, scoreY, m_colours[i], score);
       }
    }
 }
@@ -130,23 +93,7 @@ void SnakeInterface::fillColours (std::vector<prg::Colour>& modify)
       }
       else
       {
-         switch (i)
-         {
-            case 0: // Player 1 == Red
-               modify[i] = {255, 0, 0};
-               break;
-
-            case 1: // Player 2 == Green
-               modify[i] = {0, 255, 0};
-               break;
-
-            case 2: // Player 3 == Blue
-               modify[i] = {0, 0, 255};
-               break;
-
-            case 3: // Player 4 == Yellow
-               modify[i] = {255, 255, 0};
-         }
+         modify[i] = m_scores[i].getColour();
       }
    }
 }
@@ -154,20 +101,21 @@ void SnakeInterface::fillColours (std::vector<prg::Colour>& modify)
 
 
 /// Assignment Functions
-void SnakeInterface::addPlayer (const unsigned int playerNumber, const std::string& name)
+void SnakeInterface::addPlayer (const unsigned int playerNumber, const std::string& name, const prg::Colour& colour)
 {
-   if (playerNumber > 3)
+   if (playerNumber >= m_scores.size())
    {
-      throw std::runtime_error ("Invalid playerNumber given to SnakeInterface::addPlayer(), shoot the programmer.");
+      m_scores.resize (playerNumber + 1);
    }
 
    m_scores[playerNumber].setName (name);
+   m_scores[playerNumber].setColour (colour);
 }
 
 
 void SnakeInterface::updateScore (const unsigned int playerNumber, const unsigned int score)
 {
-   if (playerNumber > 3)
+   if (playerNumber >= m_scores.size())
    {
       throw std::runtime_error ("Invalid playerNumber given to SnakeInterface::updateScore(), shoot the programmer.");
    }
@@ -178,7 +126,7 @@ void SnakeInterface::updateScore (const unsigned int playerNumber, const unsigne
 
 void SnakeInterface::setAlive (const unsigned int playerNumber, const bool alive)
 {
-   if (playerNumber > 3)
+   if (playerNumber >= m_scores.size())
    {
       throw std::runtime_error ("Invalid playerNumber given to SnakeInterface::setLiving(), shoot the programmer.");
    }
@@ -191,7 +139,7 @@ void SnakeInterface::setAlive (const unsigned int playerNumber, const bool alive
 /// Getters
 const std::string& SnakeInterface::getName (const unsigned int playerNumber) const
 {
-   if (playerNumber > 3)
+   if (playerNumber >= m_scores.size())
    {
       throw std::runtime_error ("Invalid playerNumber given to SnakeInterface::getName(), shoot the programmer.");
    }
@@ -202,7 +150,7 @@ const std::string& SnakeInterface::getName (const unsigned int playerNumber) con
 
 unsigned int SnakeInterface::getScore (const unsigned int playerNumber) const
 {
-   if (playerNumber > 3)
+   if (playerNumber >= m_scores.size())
    {
       throw std::runtime_error ("Invalid playerNumber given to SnakeInterface::getScore(), shoot the programmer.");
    }